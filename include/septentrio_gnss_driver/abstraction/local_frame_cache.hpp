@@ -0,0 +1,239 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// std includes
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+// ROS includes
+#include <Eigen/Geometry>
+#include <ros/time.h>
+#include <tf2_eigen/tf2_eigen.h>
+#include <tf2_msgs/TFMessage.h>
+
+/**
+ * @file local_frame_cache.hpp
+ * @date 16/10/26
+ * @brief Caches the transform between the frame of the localization and the local
+ * frame inserted into tf
+ */
+
+/**
+ * @class LocalFrameCache
+ * @brief Keeps the recent history of the direct tf edge between the base frame and
+ * the local frame, fed from the /tf and /tf_static topics, and serves it
+ * interpolated at a requested time without exceptions. Only a direct edge is
+ * cached, longer chains have to be resolved by the tf buffer and count as misses.
+ * Times further than a tolerance outside of the cached time span are rejected as
+ * stale, so that a dead publisher of the edge does not go unnoticed.
+ */
+class LocalFrameCache
+{
+public:
+    //! Result of a lookup
+    enum Result
+    {
+        HIT,   //!< Served from the cache
+        MISS,  //!< Nothing cached for the edge
+        STALE  //!< Time too far outside of the cached time span
+    };
+
+    /**
+     * @brief Constructor of the class LocalFrameCache
+     * @param[in] base_frame Frame of the localization
+     * @param[in] local_frame Local frame to be inserted
+     * @param[in] tolerance Longest time outside of the cached time span a dynamic
+     * transform is still clamped to
+     * @param[in] capacity Number of dynamic transforms kept
+     */
+    LocalFrameCache(const std::string& base_frame, const std::string& local_frame,
+                    const ros::Duration& tolerance, std::size_t capacity = 200) :
+        base_frame_(base_frame),
+        local_frame_(local_frame), tolerance_(tolerance), capacity_(capacity)
+    {
+    }
+
+    /**
+     * @brief Takes over the transforms of the cached edge from a tf message
+     * @param[in] msg Message received on /tf or /tf_static
+     * @param[in] is_static Whether msg was received on /tf_static
+     */
+    void update(const tf2_msgs::TFMessage& msg, bool is_static)
+    {
+        for (const auto& transform : msg.transforms)
+        {
+            bool forward = (transform.header.frame_id == base_frame_) &&
+                           (transform.child_frame_id == local_frame_);
+            bool backward = (transform.header.frame_id == local_frame_) &&
+                            (transform.child_frame_id == base_frame_);
+            if (!forward && !backward)
+                continue;
+
+            Entry entry;
+            entry.stamp = transform.header.stamp;
+            entry.T_l_b = tf2::transformToEigen(transform);
+            if (backward)
+                entry.T_l_b = entry.T_l_b.inverse();
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (is_static)
+            {
+                static_ = true;
+                history_.clear();
+                history_.push_back(entry);
+            } else
+            {
+                // The edge became dynamic
+                if (static_)
+                {
+                    static_ = false;
+                    history_.clear();
+                }
+                // Transforms usually arrive in order, out-of-order ones are sorted
+                // in
+                auto it = std::upper_bound(
+                    history_.begin(), history_.end(), entry.stamp,
+                    [](const ros::Time& t, const Entry& e) { return t < e.stamp; });
+                history_.insert(it, entry);
+                if (history_.size() > capacity_)
+                    history_.pop_front();
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the transform from the local frame to the base frame
+     * @param[in] stamp Time of the transform, interpolated between the cached ones
+     * and clamped to the cached time span within the tolerance
+     * @param[out] T_l_b The transform
+     * @return HIT if T_l_b was set, MISS if nothing is cached for the edge, STALE
+     * if stamp lies further than the tolerance outside of the cached time span
+     */
+    Result lookup(const ros::Time& stamp, Eigen::Isometry3d& T_l_b)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (history_.empty())
+        {
+            ++misses_;
+            return MISS;
+        }
+        if (!static_ && ((stamp > history_.back().stamp + tolerance_) ||
+                         (stamp + tolerance_ < history_.front().stamp)))
+        {
+            ++stale_;
+            return STALE;
+        }
+        ++hits_;
+        if (static_ || (stamp >= history_.back().stamp))
+        {
+            T_l_b = history_.back().T_l_b;
+            return HIT;
+        }
+        if (stamp <= history_.front().stamp)
+        {
+            T_l_b = history_.front().T_l_b;
+            return HIT;
+        }
+        auto after = std::upper_bound(
+            history_.begin(), history_.end(), stamp,
+            [](const ros::Time& t, const Entry& e) { return t < e.stamp; });
+        auto before = after - 1;
+        double ratio = (stamp - before->stamp).toSec() /
+                       (after->stamp - before->stamp).toSec();
+        Eigen::Quaterniond q_before(before->T_l_b.rotation());
+        Eigen::Quaterniond q_after(after->T_l_b.rotation());
+        T_l_b.setIdentity();
+        T_l_b.linear() = q_before.slerp(ratio, q_after).toRotationMatrix();
+        T_l_b.translation() = (1.0 - ratio) * before->T_l_b.translation() +
+                              ratio * after->T_l_b.translation();
+        return HIT;
+    }
+
+    //! Number of lookups served from the cache
+    uint64_t hits() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return hits_;
+    }
+
+    //! Number of lookups that found nothing cached
+    uint64_t misses() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return misses_;
+    }
+
+    //! Number of lookups rejected as stale
+    uint64_t stale() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stale_;
+    }
+
+    //! Time of the newest cached transform, zero if none
+    ros::Time latest() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return history_.empty() ? ros::Time() : history_.back().stamp;
+    }
+
+private:
+    //! Cached transform
+    struct Entry
+    {
+        ros::Time stamp;
+        Eigen::Isometry3d T_l_b;
+    };
+
+    //! Frame of the localization
+    std::string base_frame_;
+    //! Local frame
+    std::string local_frame_;
+    //! Longest time outside of the cached time span still clamped to it
+    ros::Duration tolerance_;
+    //! Number of dynamic transforms kept
+    std::size_t capacity_;
+    //! Guards all members below, update() is called by the ROS spinner
+    mutable std::mutex mutex_;
+    //! Cached transforms ordered by time
+    std::deque<Entry, Eigen::aligned_allocator<Entry>> history_;
+    //! Whether the edge is static, then history_ holds a single transform
+    bool static_ = false;
+    //! Number of lookups served from the cache
+    uint64_t hits_ = 0;
+    //! Number of lookups that found nothing cached
+    uint64_t misses_ = 0;
+    //! Number of lookups rejected as stale
+    uint64_t stale_ = 0;
+};
@@ -0,0 +1,148 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// std includes
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+// ROS includes
+#include <ros/ros.h>
+#include <tf2_msgs/TFMessage.h>
+#include <tf2_ros/transform_broadcaster.h>
+#include <tf2_ros/transform_listener.h>
+// ROSaic includes
+#include <septentrio_gnss_driver/abstraction/local_frame_cache.hpp>
+
+/**
+ * @file shared_tf.hpp
+ * @date 16/10/26
+ * @brief tf broadcaster, buffer and listener shared by all Rxs of a process
+ */
+
+/**
+ * @class SharedTf
+ * @brief Holds the tf broadcaster, buffer and listener of a process, so that there
+ * is one listener thread and one subscription to /tf and /tf_static however many
+ * Rxs the process handles. The local frame caches of the Rxs are fed from the same
+ * subscriptions.
+ */
+class SharedTf
+{
+public:
+    /**
+     * @brief Gets the instance of the process, which is created on first use and
+     * destroyed with its last user. Needs ros::init() to have been called.
+     */
+    static std::shared_ptr<SharedTf> instance()
+    {
+        static std::mutex mutex;
+        static std::weak_ptr<SharedTf> shared;
+        std::lock_guard<std::mutex> lock(mutex);
+        std::shared_ptr<SharedTf> tf = shared.lock();
+        if (!tf)
+        {
+            tf.reset(new SharedTf);
+            shared = tf;
+        }
+        return tf;
+    }
+
+    //! Broadcaster of transforms
+    tf2_ros::TransformBroadcaster& broadcaster() { return broadcaster_; }
+
+    //! Buffer filled by the listener
+    tf2_ros::Buffer& buffer() { return buffer_; }
+
+    /**
+     * @brief Feeds a cache from /tf and /tf_static until removeCache() is called,
+     * subscribing to them for the first cache
+     * @param[in] cache The cache, must outlive its registration
+     */
+    void addCache(LocalFrameCache* cache)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        caches_.push_back(cache);
+        if (tfSubscriber_)
+            return;
+        boost::function<void(const tf2_msgs::TFMessage::ConstPtr&)> dynamicCallback =
+            [this](const tf2_msgs::TFMessage::ConstPtr& msg) {
+                update(*msg, false);
+            };
+        boost::function<void(const tf2_msgs::TFMessage::ConstPtr&)> staticCallback =
+            [this](const tf2_msgs::TFMessage::ConstPtr& msg) {
+                update(*msg, true);
+            };
+        ros::NodeHandle nh;
+        tfSubscriber_ =
+            nh.subscribe<tf2_msgs::TFMessage>("/tf", 100, dynamicCallback);
+        tfStaticSubscriber_ =
+            nh.subscribe<tf2_msgs::TFMessage>("/tf_static", 100, staticCallback);
+    }
+
+    /**
+     * @brief Stops feeding a cache, which may be destroyed afterwards
+     * @param[in] cache The cache
+     */
+    void removeCache(LocalFrameCache* cache)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        caches_.erase(std::remove(caches_.begin(), caches_.end(), cache),
+                      caches_.end());
+    }
+
+private:
+    SharedTf() : listener_(buffer_) {}
+
+    //! Hands a tf message over to all caches
+    void update(const tf2_msgs::TFMessage& msg, bool is_static)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (LocalFrameCache* cache : caches_)
+            cache->update(msg, is_static);
+    }
+
+    //! Transform publisher
+    tf2_ros::TransformBroadcaster broadcaster_;
+    //! tf buffer, declared before listener_ which fills it
+    tf2_ros::Buffer buffer_;
+    //! tf listener, running its own thread
+    tf2_ros::TransformListener listener_;
+    //! Guards caches_ and the subscribers
+    std::mutex mutex_;
+    //! Caches fed from /tf and /tf_static
+    std::vector<LocalFrameCache*> caches_;
+    //! Subscriber feeding caches_ from /tf
+    ros::Subscriber tfSubscriber_;
+    //! Subscriber feeding caches_ from /tf_static
+    ros::Subscriber tfStaticSubscriber_;
+};
@@ -31,15 +31,19 @@
 #pragma once
 
 // std includes
+#include <atomic>
+#include <mutex>
 #include <numeric>
 #include <unordered_map>
 // ROS includes
 #include <ros/ros.h>
+#include <rosbag/bag.h>
 // tf2 includes
 #include <tf2_eigen/tf2_eigen.h>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 #include <tf2_ros/transform_broadcaster.h>
 #include <tf2_ros/transform_listener.h>
+#include <tf2_msgs/TFMessage.h>
 // ROS msg includes
 #include <diagnostic_msgs/DiagnosticArray.h>
 #include <diagnostic_msgs/DiagnosticStatus.h>
@@ -57,6 +61,7 @@
 #include <septentrio_gnss_driver/BaseVectorCart.h>
 #include <septentrio_gnss_driver/BaseVectorGeod.h>
 #include <septentrio_gnss_driver/BlockHeader.h>
+#include <septentrio_gnss_driver/ImuBatch.h>
 #include <septentrio_gnss_driver/MeasEpoch.h>
 #include <septentrio_gnss_driver/MeasEpochChannelType1.h>
 #include <septentrio_gnss_driver/MeasEpochChannelType2.h>
@@ -64,7 +69,11 @@
 #include <septentrio_gnss_driver/PVTGeodetic.h>
 #include <septentrio_gnss_driver/PosCovCartesian.h>
 #include <septentrio_gnss_driver/PosCovGeodetic.h>
+#include <septentrio_gnss_driver/RawObservables.h>
 #include <septentrio_gnss_driver/ReceiverTime.h>
+#include <septentrio_gnss_driver/SatellitesInView.h>
+#include <septentrio_gnss_driver/StreamBlockStatus.h>
+#include <septentrio_gnss_driver/StreamStatus.h>
 #include <septentrio_gnss_driver/VectorInfoCart.h>
 #include <septentrio_gnss_driver/VectorInfoGeod.h>
 #include <septentrio_gnss_driver/VelCovCartesian.h>
@@ -80,8 +89,13 @@
 #include <septentrio_gnss_driver/INSNavCart.h>
 #include <septentrio_gnss_driver/INSNavGeod.h>
 #include <septentrio_gnss_driver/VelSensorSetup.h>
+// RTCM msg includes
+#include <rtcm_msgs/Message.h>
 // Rosaic includes
+#include <septentrio_gnss_driver/abstraction/local_frame_cache.hpp>
+#include <septentrio_gnss_driver/abstraction/shared_tf.hpp>
 #include <septentrio_gnss_driver/communication/settings.h>
+#include <septentrio_gnss_driver/parsers/nmea_formatter.hpp>
 #include <septentrio_gnss_driver/parsers/string_utilities.h>
 
 // Timestamp in nanoseconds (Unix epoch)
@@ -117,6 +131,11 @@ typedef septentrio_gnss_driver::PVTCartesian PVTCartesianMsg;
 typedef septentrio_gnss_driver::PVTGeodetic PVTGeodeticMsg;
 typedef septentrio_gnss_driver::PosCovCartesian PosCovCartesianMsg;
 typedef septentrio_gnss_driver::PosCovGeodetic PosCovGeodeticMsg;
+typedef septentrio_gnss_driver::RawObservables RawObservablesMsg;
+typedef septentrio_gnss_driver::SatellitesInView SatellitesInViewMsg;
+typedef septentrio_gnss_driver::ImuBatch ImuBatchMsg;
+typedef septentrio_gnss_driver::StreamStatus StreamStatusMsg;
+typedef septentrio_gnss_driver::StreamBlockStatus StreamBlockStatusMsg;
 typedef septentrio_gnss_driver::ReceiverTime ReceiverTimeMsg;
 typedef septentrio_gnss_driver::VectorInfoCart VectorInfoCartMsg;
 typedef septentrio_gnss_driver::VectorInfoGeod VectorInfoGeodMsg;
@@ -127,6 +146,7 @@ typedef septentrio_gnss_driver::VelCovGeodetic VelCovGeodeticMsg;
 typedef nmea_msgs::Gpgga GpggaMsg;
 typedef nmea_msgs::Gpgsa GpgsaMsg;
 typedef nmea_msgs::Gpgsv GpgsvMsg;
+typedef nmea_msgs::GpgsvSatellite GpgsvSatelliteMsg;
 typedef nmea_msgs::Gprmc GprmcMsg;
 
 // Septentrio INS+GNSS SBF messages
@@ -136,6 +156,9 @@ typedef septentrio_gnss_driver::IMUSetup IMUSetupMsg;
 typedef septentrio_gnss_driver::VelSensorSetup VelSensorSetupMsg;
 typedef septentrio_gnss_driver::ExtSensorMeas ExtSensorMeasMsg;
 
+// RTCM messages
+typedef rtcm_msgs::Message RtcmMsg;
+
 /**
  * @brief Convert nsec timestamp to ROS timestamp
  * @param[in] ts timestamp in nanoseconds (Unix epoch)
@@ -174,13 +197,29 @@ enum LogLevel
 class ROSaicNodeBase
 {
 public:
-    ROSaicNodeBase() : pNh_(new ros::NodeHandle("~")), tfListener_(tfBuffer_) {}
+    /**
+     * @brief Constructor of the class ROSaicNodeBase
+     * @param[in] receiver Name of the Rx, which becomes the sub-namespace of the
+     * private node handle when one process handles several Rxs, empty otherwise
+     */
+    explicit ROSaicNodeBase(const std::string& receiver = std::string()) :
+        pNh_(new ros::NodeHandle(ros::NodeHandle("~"), receiver)),
+        receiver_(receiver)
+    {
+    }
 
-    virtual ~ROSaicNodeBase() {}
+    virtual ~ROSaicNodeBase()
+    {
+        if (localFrameCache_)
+            tf_->removeCache(localFrameCache_.get());
+    }
 
     void registerSubscriber()
     {
-        ros::NodeHandle nh;
+        ros::NodeHandle nh(receiver_);
+        if (settings_.ins_vsm_ros_max_rate > 0.0)
+            vsmPeriod_ =
+                static_cast<Timestamp>(1.0e9 / settings_.ins_vsm_ros_max_rate);
         if (settings_.ins_vsm_ros_source == "odometry")
             odometrySubscriber_ = nh.subscribe<nav_msgs::Odometry>(
                 "odometry_vsm", 10, &ROSaicNodeBase::callbackOdometry, this);
@@ -233,19 +272,19 @@ public:
         switch (logLevel)
         {
         case LogLevel::DEBUG:
-            ROS_DEBUG_STREAM(ros::this_node::getName() << ": " << s);
+            ROS_DEBUG_STREAM(pNh_->getNamespace() << ": " << s);
             break;
         case LogLevel::INFO:
-            ROS_INFO_STREAM(ros::this_node::getName() << ": " << s);
+            ROS_INFO_STREAM(pNh_->getNamespace() << ": " << s);
             break;
         case LogLevel::WARN:
-            ROS_WARN_STREAM(ros::this_node::getName() << ": " << s);
+            ROS_WARN_STREAM(pNh_->getNamespace() << ": " << s);
             break;
         case LogLevel::ERROR:
-            ROS_ERROR_STREAM(ros::this_node::getName() << ": " << s);
+            ROS_ERROR_STREAM(pNh_->getNamespace() << ": " << s);
             break;
         case LogLevel::FATAL:
-            ROS_FATAL_STREAM(ros::this_node::getName() << ": " << s);
+            ROS_FATAL_STREAM(pNh_->getNamespace() << ": " << s);
             break;
         default:
             break;
@@ -258,6 +297,12 @@ public:
      */
     Timestamp getTime() { return ros::Time::now().toNSec(); }
 
+    /**
+     * @brief Gets the name of the Rx
+     * @return Name of the Rx, empty unless one process handles several Rxs
+     */
+    const std::string& receiver() const { return receiver_; }
+
     /**
      * @brief Publishing function
      * @param[in] topic String of topic
@@ -266,18 +311,54 @@ public:
     template <typename M>
     void publishMessage(const std::string& topic, const M& msg)
     {
-        auto it = topicMap_.find(topic);
-        if (it != topicMap_.end())
+        if (bag_)
         {
-            it->second.publish(msg);
-        } else
+            writeToBag(topic, msg);
+            return;
+        }
+        publisher<M>(topic).publish(msg);
+    }
+
+    /**
+     * @brief Publishing function for shared messages, which roscpp hands over to
+     * subscribers in the same process without copying and serializes only once
+     * for all others
+     * @param[in] topic String of topic
+     * @param[in] msg ROS message to be published, must not be modified afterwards
+     */
+    template <typename M>
+    void publishMessage(const std::string& topic,
+                        const boost::shared_ptr<const M>& msg)
+    {
+        if (bag_)
         {
-            ros::Publisher pub = pNh_->advertise<M>(topic, queueSize_);
-            topicMap_.insert(std::make_pair(topic, pub));
-            pub.publish(msg);
+            writeToBag(topic, *msg);
+            return;
         }
+        publisher<M>(topic).publish(msg);
     }
 
+    /**
+     * @brief Whether messages of a topic are consumed by anyone
+     * @param[in] topic String of topic
+     * @return True if the topic has subscribers, or is not advertised yet so that
+     * publishing to it advertises it, or messages are written to a bag
+     */
+    bool isSubscribed(const std::string& topic) const
+    {
+        if (bag_)
+            return true;
+        std::lock_guard<std::mutex> lock(subscriberMutex_);
+        auto it = subscriberCounts_.find(topicName(topic));
+        return (it == subscriberCounts_.end()) || (*it->second > 0);
+    }
+
+    /**
+     * @brief Changes whenever a topic is advertised or a subscriber connects to or
+     * disconnects from one, so that users of isSubscribed() know when to ask again
+     */
+    uint32_t subscriptionGeneration() const { return subscriptionGeneration_; }
+
     /**
      * @brief Publishing function for tf
      * @param[in] msg ROS localization message to be converted to tf
@@ -303,51 +384,155 @@ public:
         transformStamped.transform.rotation.z = loc.pose.pose.orientation.z;
         transformStamped.transform.rotation.w = loc.pose.pose.orientation.w;
 
-        if (settings_.insert_local_frame)
+        if (settings_.insert_local_frame && tf_)
         {
-            geometry_msgs::TransformStamped T_l_b;
-            try
+            if (!localFrameCache_)
+                setupLocalFrameCache(loc.child_frame_id);
+
+            Eigen::Isometry3d T_l_b;
+            LocalFrameCache::Result cached =
+                localFrameCache_->lookup(lastTfStamp_, T_l_b);
+            if (cached == LocalFrameCache::STALE)
             {
-                // try to get tf at timestamp of message
-                T_l_b = tfBuffer_.lookupTransform(
-                    loc.child_frame_id, settings_.local_frame_id, lastTfStamp_);
-            } catch (const tf2::TransformException& ex)
+                if (logDue(staleTfLogged_))
+                    log(LogLevel::WARN,
+                        "Stale transform for insertion of local frame, latest "
+                        "at t=" +
+                            std::to_string(localFrameCache_->latest().toNSec()) +
+                            ", needed at t=" +
+                            std::to_string(lastTfStamp_.toNSec()) +
+                            ". Not publishing tf.");
+                return;
+            }
+            if (cached == LocalFrameCache::MISS)
             {
-                try
+                // No direct edge cached, let the buffer resolve the chain
+                if (tf_->buffer().canTransform(loc.child_frame_id,
+                                               settings_.local_frame_id,
+                                               lastTfStamp_))
+                {
+                    T_l_b = tf2::transformToEigen(tf_->buffer().lookupTransform(
+                        loc.child_frame_id, settings_.local_frame_id, lastTfStamp_));
+                } else if (tf_->buffer().canTransform(loc.child_frame_id,
+                                                      settings_.local_frame_id,
+                                                      ros::Time(0)))
                 {
-                    ROS_INFO_STREAM_THROTTLE(
-                        10.0,
-                        ros::this_node::getName()
-                            << ": No transform for insertion of local frame at t="
-                            << lastTfStamp_.toNSec()
-                            << ". Exception: " << std::string(ex.what()));
-                    // try to get latest tf
-                    T_l_b = tfBuffer_.lookupTransform(
-                        loc.child_frame_id, settings_.local_frame_id, ros::Time(0));
-                } catch (const tf2::TransformException& ex)
+                    if (logDue(noTfLogged_))
+                        log(LogLevel::INFO,
+                            "No transform for insertion of local frame at t=" +
+                                std::to_string(lastTfStamp_.toNSec()));
+                    // use latest tf
+                    T_l_b = tf2::transformToEigen(tf_->buffer().lookupTransform(
+                        loc.child_frame_id, settings_.local_frame_id, ros::Time(0)));
+                } else
                 {
-                    ROS_WARN_STREAM_THROTTLE(
-                        10.0,
-                        ros::this_node::getName()
-                            << ": No most recent transform for insertion of local frame. Exception: "
-                            << std::string(ex.what()));
+                    if (logDue(noLatestTfLogged_))
+                        log(LogLevel::WARN,
+                            "No most recent transform for insertion of local "
+                            "frame.");
                     return;
                 }
             }
+            if (logDue(cacheStatsLogged_))
+                log(LogLevel::DEBUG,
+                    "Local frame cache hits: " +
+                        std::to_string(localFrameCache_->hits()) +
+                        ", misses: " + std::to_string(localFrameCache_->misses()) +
+                        ", stale: " + std::to_string(localFrameCache_->stale()));
 
             // T_l_g = T_b_g * T_l_b;
-            transformStamped =
-                tf2::eigenToTransform(tf2::transformToEigen(transformStamped) *
-                                      tf2::transformToEigen(T_l_b));
+            transformStamped = tf2::eigenToTransform(
+                tf2::transformToEigen(transformStamped) * T_l_b);
             transformStamped.header.stamp = loc.header.stamp;
             transformStamped.header.frame_id = loc.header.frame_id;
             transformStamped.child_frame_id = settings_.local_frame_id;
         }
 
-        tf2Publisher_.sendTransform(transformStamped);
+        if (bag_)
+        {
+            tf2_msgs::TFMessage tfMsg;
+            tfMsg.transforms.push_back(transformStamped);
+            writeToBag("/tf", tfMsg);
+        } else if (tf_)
+            tf_->broadcaster().sendTransform(transformStamped);
+    }
+
+    /**
+     * @brief Writes all messages and transforms to a bag instead of publishing
+     * them, which needs no ROS master
+     * @param[in] bag The bag opened for writing, nullptr to publish again
+     */
+    void setBag(rosbag::Bag* bag)
+    {
+        bag_ = bag;
+        ++subscriptionGeneration_;
     }
 
 private:
+    /**
+     * @brief Gets the name a topic is advertised under
+     *
+     * Topics are global for a single Rx. When one process handles several Rxs,
+     * they are relative to pNh_, i.e. in the private sub-namespace of the Rx, so
+     * that the Rxs do not publish on the same topics.
+     * @param[in] topic String of topic, e.g. "/navsatfix"
+     * @return The name of the topic, e.g. "navsatfix" for ~rover/navsatfix
+     */
+    std::string topicName(const std::string& topic) const
+    {
+        if (receiver_.empty() || topic.empty() || (topic[0] != '/'))
+            return topic;
+        return topic.substr(1);
+    }
+
+    /**
+     * @brief Gets the publisher of a topic, advertising it on first use
+     * @param[in] topic String of topic
+     * @return The publisher
+     */
+    template <typename M>
+    ros::Publisher& publisher(const std::string& topic)
+    {
+        std::string name = topicName(topic);
+        auto it = topicMap_.find(name);
+        if (it != topicMap_.end())
+            return it->second;
+        std::shared_ptr<std::atomic<int32_t>> count(new std::atomic<int32_t>(0));
+        ros::Publisher pub = pNh_->advertise<M>(
+            name, queueSize_,
+            [this, count](const ros::SingleSubscriberPublisher&) {
+                ++*count;
+                ++subscriptionGeneration_;
+            },
+            [this, count](const ros::SingleSubscriberPublisher&) {
+                --*count;
+                ++subscriptionGeneration_;
+            });
+        it = topicMap_.insert(std::make_pair(name, pub)).first;
+        {
+            std::lock_guard<std::mutex> lock(subscriberMutex_);
+            subscriberCounts_.insert(std::make_pair(name, count));
+        }
+        ++subscriptionGeneration_;
+        return it->second;
+    }
+
+    /**
+     * @brief Writes a message to bag_, stamped with its header time if it has one
+     * @param[in] topic String of topic
+     * @param[in] msg ROS message to be written
+     */
+    template <typename M>
+    void writeToBag(const std::string& topic, const M& msg)
+    {
+        const TimestampRos* stamp = ros::message_traits::timeStamp(msg);
+        // rosbag rejects zero times, so unstamped messages inherit the last stamp
+        if (stamp && !stamp->isZero())
+            lastBagStamp_ = *stamp;
+        if (!lastBagStamp_.isZero())
+            bag_->write(topic, lastBagStamp_, msg);
+    }
+
     void callbackOdometry(const nav_msgs::Odometry::ConstPtr& odo)
     {
         Timestamp stamp = timestampFromRos(odo->header.stamp);
@@ -362,121 +547,177 @@ private:
         processTwist(stamp, twist->twist);
     }
 
+    void callbackRtcm(const RtcmMsg::ConstPtr& rtcm) { sendCorrections(rtcm); }
+
     void processTwist(Timestamp stamp,
                       const geometry_msgs::TwistWithCovariance& twist)
     {
-        time_t epochSeconds = stamp / 1000000000;
-        struct tm* tm_temp = std::gmtime(&epochSeconds);
-        std::stringstream timeUtc;
-        timeUtc << std::setfill('0') << std::setw(2)
-                << std::to_string(tm_temp->tm_hour) << std::setw(2)
-                << std::to_string(tm_temp->tm_min) << std::setw(2)
-                << std::to_string(tm_temp->tm_sec) << "." << std::setw(3)
-                << std::to_string((stamp - (stamp / 1000000000) * 1000000000) /
-                                  1000000);
-
-        std::string v_x;
-        std::string v_y;
-        std::string v_z;
-        std::string std_x;
-        std::string std_y;
-        std::string std_z;
-        if (settings_.ins_vsm_ros_config[0])
+        // Decimate to the rate the Rx uses, keeping the first message of each
+        // period
+        if (vsmPeriod_ != 0)
         {
-            v_x = string_utilities::trimDecimalPlaces(twist.twist.linear.x);
-            if (settings_.ins_vsm_ros_variances_by_parameter)
-                std_x = string_utilities::trimDecimalPlaces(
-                    settings_.ins_vsm_ros_variances[0]);
-            else if (twist.covariance[0] > 0.0)
-                std_x = string_utilities::trimDecimalPlaces(
-                    std::sqrt(twist.covariance[0]));
-            else
-            {
-                ROS_ERROR_STREAM("Invalid covariance value for v_x: "
-                                 << std::to_string(twist.covariance[0])
-                                 << ". Ignoring measurement.");
-            }
-        } else
-            std_x = std::to_string(1000000.0);
-        if (settings_.ins_vsm_ros_config[1])
+            Timestamp slot = stamp / vsmPeriod_;
+            if (slot == vsmLastSlot_)
+                return;
+            vsmLastSlot_ = slot;
+        }
+
+        vsmFormatter_.begin("$PSSN,VSM");
+        vsmFormatter_.appendTime(stamp);
+        // Variance indices of v_x, v_y, and v_z in the covariance matrix
+        static const size_t covIndex[3] = {0, 7, 14};
+        const double v[3] = {twist.twist.linear.x, twist.twist.linear.y,
+                             twist.twist.linear.z};
+        bool valid[3];
+        double stdDev[3];
+        for (size_t i = 0; i < 3; ++i)
         {
-            if (settings_.use_ros_axis_orientation)
-                v_y = "-";
-            v_y += string_utilities::trimDecimalPlaces(twist.twist.linear.y);
+            valid[i] = false;
+            stdDev[i] = 1000000.0;
+            if (!settings_.ins_vsm_ros_config[i])
+                continue;
             if (settings_.ins_vsm_ros_variances_by_parameter)
-                std_y = string_utilities::trimDecimalPlaces(
-                    settings_.ins_vsm_ros_variances[1]);
-            else if (twist.covariance[7] > 0.0)
-                std_y = string_utilities::trimDecimalPlaces(
-                    std::sqrt(twist.covariance[7]));
-            else
             {
-                ROS_ERROR_STREAM("Invalid covariance value for v_y: "
-                                 << std::to_string(twist.covariance[1])
-                                 << ". Ignoring measurement.");
-                v_y = "";
-                std_y = string_utilities::trimDecimalPlaces(1000000.0);
-            }
-        } else
-            std_y = string_utilities::trimDecimalPlaces(1000000.0);
-        if (settings_.ins_vsm_ros_config[2])
-        {
-            if (settings_.use_ros_axis_orientation)
-                v_z = "-";
-            v_z += string_utilities::trimDecimalPlaces(twist.twist.linear.z);
-            if (settings_.ins_vsm_ros_variances_by_parameter)
-                std_z = string_utilities::trimDecimalPlaces(
-                    settings_.ins_vsm_ros_variances[2]);
-            else if (twist.covariance[14] > 0.0)
-                std_z = string_utilities::trimDecimalPlaces(
-                    std::sqrt(twist.covariance[14]));
-            else
+                valid[i] = true;
+                stdDev[i] = settings_.ins_vsm_ros_variances[i];
+            } else if (twist.covariance[covIndex[i]] > 0.0)
+            {
+                valid[i] = true;
+                stdDev[i] = std::sqrt(twist.covariance[covIndex[i]]);
+            } else
             {
-                ROS_ERROR_STREAM("Invalid covariance value for v_z: "
-                                 << std::to_string(twist.covariance[2])
+                ROS_ERROR_STREAM("Invalid covariance value for v_"
+                                 << "xyz"[i] << ": "
+                                 << twist.covariance[covIndex[i]]
                                  << ". Ignoring measurement.");
-                v_z = "";
-                std_z = string_utilities::trimDecimalPlaces(1000000.0);
             }
-        } else
-            std_z = string_utilities::trimDecimalPlaces(1000000.0);
-
-        std::string velNmea = "$PSSN,VSM," + timeUtc.str() + "," + v_x + "," + v_y +
-                              "," + std_x + "," + std_y + "," + v_z + "," + std_z;
-
-        char crc = std::accumulate(velNmea.begin() + 1, velNmea.end(), 0,
-                                   [](char sum, char ch) { return sum ^ ch; });
-
-        std::stringstream crcss;
-        crcss << std::hex << static_cast<int32_t>(crc);
-
-        velNmea += "*" + crcss.str() + "\r\n";
-        sendVelocity(velNmea);
+        }
+        // Axes y and z point in opposite directions in ROS and on the Rx
+        double sign = settings_.use_ros_axis_orientation ? -1.0 : 1.0;
+        // Field order: v_x, v_y, std_x, std_y, v_z, std_z
+        if (valid[0])
+            vsmFormatter_.appendFixed3(v[0]);
+        else
+            vsmFormatter_.appendEmpty();
+        if (valid[1])
+            vsmFormatter_.appendFixed3(sign * v[1]);
+        else
+            vsmFormatter_.appendEmpty();
+        vsmFormatter_.appendFixed3(stdDev[0]);
+        vsmFormatter_.appendFixed3(stdDev[1]);
+        if (valid[2])
+            vsmFormatter_.appendFixed3(sign * v[2]);
+        else
+            vsmFormatter_.appendEmpty();
+        vsmFormatter_.appendFixed3(stdDev[2]);
+
+        if (!vsmFormatter_.finish())
+        {
+            if (logDue(vsmErrorLogged_))
+                log(LogLevel::ERROR,
+                    "VSM velocity or its variance cannot be formatted as NMEA "
+                    "(not finite or out of range). Ignoring measurement.");
+            return;
+        }
+        sendVelocity(vsmFormatter_.data(), vsmFormatter_.size());
     }
 
 protected:
     //! Node handle pointer
     std::shared_ptr<ros::NodeHandle> pNh_;
+    //! Name of the Rx, empty unless one process handles several Rxs
+    std::string receiver_;
     //! Settings
     Settings settings_;
-    //! Send velocity to communication layer (virtual)
-    virtual void sendVelocity(const std::string& velNmea) = 0;
+    //! tf broadcaster, buffer and listener shared by all Rxs of the process,
+    //! set by setupTf()
+    std::shared_ptr<SharedTf> tf_;
+    //! Send velocity NMEA sentence of size bytes to communication layer
+    //! (virtual)
+    virtual void sendVelocity(const char* velNmea, std::size_t size) = 0;
+    //! Send RTCM corrections to communication layer (virtual)
+    virtual void sendCorrections(const RtcmMsg::ConstPtr& rtcm) = 0;
+
+    /**
+     * @brief Subscribes to RTCM corrections to be forwarded to the Rx
+     */
+    void registerCorrectionsSubscriber()
+    {
+        ros::NodeHandle nh(receiver_);
+        rtcmSubscriber_ = nh.subscribe<RtcmMsg>(
+            "rtcm", 100, &ROSaicNodeBase::callbackRtcm, this,
+            ros::TransportHints().tcpNoDelay());
+    }
+
+    /**
+     * @brief Whether a message logged at most every 10 s is due again, tracked per
+     * Rx since the ROS_*_THROTTLE macros throttle all Rxs of a process together
+     * @param[in,out] last Time the message was last logged, updated if due
+     */
+    static bool logDue(ros::WallTime& last)
+    {
+        ros::WallTime now = ros::WallTime::now();
+        if (!last.isZero() && ((now - last).toSec() < 10.0))
+            return false;
+        last = now;
+        return true;
+    }
+
+    /**
+     * @brief Starts broadcasting and listening to tf, which registers with the ROS
+     * master. All Rxs of a process share the broadcaster and the listener.
+     */
+    void setupTf() { tf_ = SharedTf::instance(); }
+
+    /**
+     * @brief Creates the cache of the transform between the base frame and the
+     * local frame and subscribes it to tf
+     * @param[in] base_frame Frame of the localization
+     */
+    void setupLocalFrameCache(const std::string& base_frame)
+    {
+        localFrameCache_.reset(new LocalFrameCache(
+            base_frame, settings_.local_frame_id,
+            ros::Duration(settings_.local_frame_tolerance)));
+        tf_->addCache(localFrameCache_.get());
+    }
 
 private:
-    //! Map of topics and publishers
+    //! Map of topics, named as by topicName(), and publishers
     std::unordered_map<std::string, ros::Publisher> topicMap_;
+    //! Map of topics and their numbers of subscribers
+    std::unordered_map<std::string, std::shared_ptr<std::atomic<int32_t>>>
+        subscriberCounts_;
+    //! Guards subscriberCounts_, which is also read by the Rx configuration thread
+    mutable std::mutex subscriberMutex_;
+    //! Incremented on every change of subscriberCounts_
+    std::atomic<uint32_t> subscriptionGeneration_{0};
     //! Publisher queue size
     uint32_t queueSize_ = 1;
-    //! Transform publisher
-    tf2_ros::TransformBroadcaster tf2Publisher_;
+    //! Bag written to instead of publishing, nullptr if publishing
+    rosbag::Bag* bag_ = nullptr;
+    //! Stamp of the last message written to bag_
+    TimestampRos lastBagStamp_;
     //! Odometry subscriber
     ros::Subscriber odometrySubscriber_;
     //! Twist subscriber
     ros::Subscriber twistSubscriber_;
+    //! Formatter of the VSM NMEA sentences, reused for each message
+    string_utilities::NmeaFormatter vsmFormatter_;
+    //! Period VSM input is decimated to in nanoseconds, 0 to forward all
+    Timestamp vsmPeriod_ = 0;
+    //! Period slot of the last VSM message forwarded
+    Timestamp vsmLastSlot_ = 0;
+    //! RTCM subscriber
+    ros::Subscriber rtcmSubscriber_;
     //! Last tf stamp
     TimestampRos lastTfStamp_;
-    //! tf buffer
-    tf2_ros::Buffer tfBuffer_;
-    // tf listener
-    tf2_ros::TransformListener tfListener_;
+    //! Times the throttled messages were last logged
+    ros::WallTime staleTfLogged_;
+    ros::WallTime noTfLogged_;
+    ros::WallTime noLatestTfLogged_;
+    ros::WallTime cacheStatsLogged_;
+    ros::WallTime vsmErrorLogged_;
+    //! Cache of the transform to the local frame, created on first use
+    std::unique_ptr<LocalFrameCache> localFrameCache_;
 };
\ No newline at end of file
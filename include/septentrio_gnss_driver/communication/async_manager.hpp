@@ -60,14 +60,27 @@
 #include <boost/algorithm/string/join.hpp>
 #include <boost/asio.hpp>
 #include <boost/bind.hpp>
+#include <boost/chrono.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/function.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/system/error_code.hpp>
 #include <boost/thread.hpp>
 #include <boost/thread/condition.hpp>
+#include <boost/thread/future.hpp>
+// C++ library includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <sstream>
 
 // ROSaic includes
 #include <septentrio_gnss_driver/communication/circular_buffer.hpp>
+#include <septentrio_gnss_driver/communication/raw_recorder.hpp>
+#include <septentrio_gnss_driver/communication/shared_reactor.hpp>
+#include <septentrio_gnss_driver/communication/thread_config.hpp>
 
 #ifndef ASYNC_MANAGER_HPP
 #define ASYNC_MANAGER_HPP
@@ -96,13 +109,26 @@ namespace io_comm_rx {
         virtual ~Manager() {}
         //! Sets the callback function
         virtual void setCallback(const Callback& callback) = 0;
+        //! Sets the recorder every received chunk is handed over to
+        virtual void
+        setRecorder(const boost::shared_ptr<RawRecorder>& recorder) = 0;
         //! Sends commands to the receiver
         virtual bool send(const std::string& cmd) = 0;
+        //! Sends bytes owned by someone else, e.g. a ROS message, to the receiver
+        //! without copying them, origin being their creation time (0 if unknown)
+        virtual bool send(const boost::shared_ptr<const void>& owner,
+                          const uint8_t* data, std::size_t size,
+                          Timestamp origin) = 0;
+        //! Sends a message to the receiver that any later such message supersedes,
+        //! e.g. velocity input, copying the size bytes at msg
+        virtual bool sendLatest(const char* msg, std::size_t size) = 0;
         //! Waits count seconds before throwing ROS_INFO message in case no message
         //! from the receiver arrived
         virtual void wait(uint16_t* count) = 0;
         //! Determines whether or not the connection is open
         virtual bool isOpen() const = 0;
+        //! Number of bytes received from the receiver so far
+        virtual uint64_t bytesReceived() const = 0;
     };
 
     /**
@@ -122,10 +148,17 @@ namespace io_comm_rx {
          * boost::asio::serial_port or boost::asio::tcp::ip
          * @param io_service The io_context object. The io_context represents your
          * program's link to the operating system's I/O services
+         * @param[in] settings Settings of the Rx, holding the scheduling of the
+         * threads this instance starts
+         * @param[in] reactor Reactor shared with other Rx links, which runs
+         * io_service and the parsing; if empty, this instance starts its own threads
          * @param[in] buffer_size Size of the circular buffer in bytes
          */
         AsyncManager(ROSaicNodeBase* node, boost::shared_ptr<StreamT> stream,
                      boost::shared_ptr<boost::asio::io_service> io_service,
+                     const Settings* settings,
+                     boost::shared_ptr<SharedReactor> reactor =
+                         boost::shared_ptr<SharedReactor>(),
                      std::size_t buffer_size = 16384);
         virtual ~AsyncManager();
 
@@ -136,6 +169,15 @@ namespace io_comm_rx {
          */
         void setCallback(const Callback& callback) { read_callback_ = callback; }
 
+        /**
+         * @brief Hands over every received chunk to the recorder as well
+         * @param[in] recorder The recorder, may be set while reading
+         */
+        void setRecorder(const boost::shared_ptr<RawRecorder>& recorder)
+        {
+            boost::atomic_store(&recorder_, recorder);
+        }
+
         void wait(uint16_t* count);
 
         /**
@@ -144,11 +186,34 @@ namespace io_comm_rx {
          */
         bool send(const std::string& cmd);
 
+        /**
+         * @brief Sends bytes via the I/O stream without copying them
+         * @param owner Keeps the bytes alive until they are written
+         * @param data Pointer to the bytes
+         * @param size Number of bytes
+         * @param origin Time the bytes were created at, e.g. the stamp of RTCM
+         * corrections, used to report their age; 0 if unknown
+         */
+        bool send(const boost::shared_ptr<const void>& owner, const uint8_t* data,
+                  std::size_t size, Timestamp origin);
+
+        /**
+         * @brief Sends a message via the I/O stream, replacing the one handed over
+         * before if that was not written yet
+         * @param[in] msg The message to be sent
+         * @param[in] size Number of bytes of the message
+         */
+        bool sendLatest(const char* msg, std::size_t size);
+
         bool isOpen() const { return stream_->is_open(); }
 
+        uint64_t bytesReceived() const { return bytes_received_; }
+
     private:
         //! Pointer to the node
         ROSaicNodeBase* node_;
+        //! Settings of the Rx
+        const Settings* settings_;
 
     protected:
         //! Reads in via async_read_some and hands certain number of bytes
@@ -159,8 +224,65 @@ namespace io_comm_rx {
         void asyncReadSomeHandler(const boost::system::error_code& error,
                                   std::size_t bytes_transferred);
 
-        //! Sends command "cmd" to the Rx
-        void write(const std::string& cmd);
+        //! Message waiting to be written to the Rx
+        struct PendingWrite
+        {
+            //! Keeps the bytes alive
+            boost::shared_ptr<const void> owner;
+            //! Pointer to the bytes
+            const uint8_t* data;
+            //! Number of bytes
+            std::size_t size;
+            //! Time the bytes were created at, 0 if unknown
+            Timestamp origin;
+            //! Time the message was queued
+            boost::chrono::steady_clock::time_point queued;
+        };
+
+        //! Statistics of writing to the Rx since the last report
+        struct WriteStats
+        {
+            //! Number of async_write calls
+            uint64_t batches = 0;
+            //! Number of messages written
+            uint64_t messages = 0;
+            //! Number of bytes written
+            uint64_t bytes = 0;
+            //! Number of messages superseded before being written
+            uint64_t superseded = 0;
+            //! Maximum number of queued messages
+            std::size_t max_depth = 0;
+            //! Sum of the latencies from queueing to completion of writing in s
+            double latency_sum = 0.0;
+            //! Maximum latency from queueing to completion of writing in s
+            double latency_max = 0.0;
+            //! Number of messages with known time of creation
+            uint64_t stamped = 0;
+            //! Sum of the ages of these messages at completion of writing in s
+            double stamped_age_sum = 0.0;
+            //! Maximum age of these messages at completion of writing in s
+            double stamped_age_max = 0.0;
+        };
+
+        //! Maximum number of bytes queued before send() waits
+        static const std::size_t MAX_QUEUED_BYTES = 65536;
+        //! Maximum number of messages gathered into one async_write
+        static const std::size_t MAX_BATCH = 64;
+
+        //! Queues a message, waiting while the queue is full
+        bool enqueue(PendingWrite&& pending);
+
+        //! Starts writing all queued messages with one async_write unless a write
+        //! is in progress
+        void queueWrite(boost::mutex::scoped_lock& lock);
+
+        //! Gathers the queued messages and the latest message into one async_write,
+        //! run on the io_service
+        void startWrite();
+
+        //! Handler for async_write
+        void writeHandler(const boost::system::error_code& error,
+                          std::size_t bytes_transferred);
 
         //! Closes stream "stream_"
         void close();
@@ -169,11 +291,20 @@ namespace io_comm_rx {
         //! is true
         void tryParsing();
 
+        //! Parses what is in the circular buffer once, run on the strand of the
+        //! shared reactor's parsing pool
+        void parseChunk();
+
+        //! Hands the bytes collected in to_be_parsed_ over to read_callback_ and
+        //! keeps incomplete messages for the next call
+        void callReadCallback(Timestamp recvTime, std::size_t current_buffer_size);
+
         //! Mutex to control changes of class variable "try_parsing"
         boost::mutex parse_mutex_;
 
-        //! Determines when the tryParsing() method will attempt parsing SBF/NMEA
-        bool try_parsing_;
+        //! Determines when the tryParsing() method will attempt parsing SBF/NMEA,
+        //! atomic since the parsing thread may spin on it without the mutex
+        std::atomic<bool> try_parsing_;
 
         //! Determines when the asyncReadSomeHandler() method should write SBF/NMEA
         //! into the circular buffer
@@ -182,6 +313,56 @@ namespace io_comm_rx {
         //! Condition variable complementing "parse_mutex"
         boost::condition_variable parsing_condition_;
 
+        //! Whether tryParsing() blocks on parsing_condition_, hence has to be
+        //! notified of a new chunk
+        bool parser_blocked_;
+
+        //! Whether asyncReadSomeHandler() blocks on parsing_condition_, hence has
+        //! to be notified once the chunk before was taken over
+        bool reader_blocked_;
+
+        //! Number of chunks tryParsing() found while spinning, yielding and after
+        //! blocking since the last report
+        std::array<uint64_t, 3> handoffs_;
+
+        //! Time of the last report of handoffs_
+        boost::chrono::steady_clock::time_point last_handoff_report_;
+
+        //! Spins and then yields for the times set by parse_handoff/... until
+        //! try_parsing_ is set
+        //! @return Index into handoffs_ of how the chunk was found, 2 if not found
+        std::size_t awaitChunk();
+
+        //! Reactor shared with other Rx links, empty if this instance runs its own
+        //! threads
+        boost::shared_ptr<SharedReactor> reactor_;
+
+        //! Records the raw stream, empty if not recording
+        boost::shared_ptr<RawRecorder> recorder_;
+
+        //! Serializes the parsing jobs of this link on the shared parsing pool
+        std::unique_ptr<boost::asio::io_service::strand> parse_strand_;
+
+        //! Whether reading was paused since the circular buffer is about to be
+        //! full, only used with a shared reactor
+        bool read_paused_;
+
+        //! Whether the read handler parses and publishes inline, reading straight
+        //! into to_be_parsed_ instead of handing over to a parsing thread
+        const bool inline_parsing_;
+
+        //! Bytes handed over to read_callback_, including incomplete messages
+        std::vector<uint8_t> to_be_parsed_;
+
+        //! Start of the not yet parsed bytes in to_be_parsed_
+        std::size_t to_be_parsed_index_;
+
+        //! Where the next chunk of the circular buffer is appended in to_be_parsed_
+        std::size_t shift_bytes_;
+
+        //! Number of bytes to be parsed by read_callback_
+        std::size_t arg_for_read_callback_;
+
         //! Stream, represents either serial or TCP/IP connection
         boost::shared_ptr<StreamT> stream_;
 
@@ -210,6 +391,9 @@ namespace io_comm_rx {
         //! Whether or not we want to sever the connection to the Rx
         bool stopping_;
 
+        //! Number of bytes received from the Rx
+        std::atomic<uint64_t> bytes_received_;
+
         /// Size of in_ buffers
         const std::size_t buffer_size_;
 
@@ -224,75 +408,193 @@ namespace io_comm_rx {
         //! Handles the ROS_INFO throwing (if no incoming message)
         void callAsyncWait(uint16_t* count);
 
+        //! Names, pins and schedules the calling thread, warning about what could
+        //! not be applied
+        void configure(const std::string& name, const ThreadSettings& settings);
+
+        //! Number of seconds waited so far for an incoming message
+        uint16_t wait_count_;
+
         //! Number of times the DoRead() method has been called (only counts
         //! initially)
         uint16_t do_read_count_;
 
         //! Timestamp of receiving buffer
         Timestamp recvTime_;
+
+        //! Guards the members related to writing below
+        boost::mutex write_mutex_;
+
+        //! Signals that queued bytes were handed over to async_write
+        boost::condition_variable write_space_condition_;
+
+        //! Messages handed over by send(), never dropped
+        std::deque<PendingWrite> write_queue_;
+
+        //! Number of bytes in write_queue_
+        std::size_t queued_bytes_;
+
+        //! Message handed over by sendLatest() and not yet written
+        PendingWrite latest_;
+
+        //! Buffers sendLatest() copies into, one is free whenever at most one is
+        //! pending and one in flight
+        std::array<boost::shared_ptr<std::vector<uint8_t>>, 3> latest_buffers_;
+
+        //! Whether latest_ is to be written
+        bool latest_pending_;
+
+        //! Whether an async_write is in progress or posted
+        bool writing_;
+
+        //! Messages of the async_write in progress
+        std::vector<PendingWrite> in_flight_;
+
+        //! Buffers of the async_write in progress
+        std::vector<boost::asio::const_buffer> write_buffers_;
+
+        //! Statistics of writing since the last report
+        WriteStats write_stats_;
+
+        //! Time of the last report of the write statistics
+        boost::chrono::steady_clock::time_point last_write_report_;
     };
 
     template <typename StreamT>
     void AsyncManager<StreamT>::tryParsing()
     {
-        uint8_t* to_be_parsed = new uint8_t[buffer_size_ * 16];
-        uint8_t* to_be_parsed_index = to_be_parsed;
         bool timed_out = false;
-        std::size_t shift_bytes = 0;
-        std::size_t arg_for_read_callback = 0;
 
         while (!timed_out &&
                !stopping_) // Loop will stop if condition variable timed out
         {
+            std::size_t handoff = awaitChunk();
             boost::mutex::scoped_lock lock(parse_mutex_);
+            parser_blocked_ = true;
             parsing_condition_.wait_for(lock, boost::chrono::seconds(10),
-                                        [this]() { return try_parsing_; });
+                                        [this]() { return try_parsing_.load(); });
+            parser_blocked_ = false;
             bool timed_out = !try_parsing_;
             if (timed_out)
                 break;
+            ++handoffs_[handoff];
             try_parsing_ = false;
             allow_writing_ = true;
             std::size_t current_buffer_size = circular_buffer_.size();
-            arg_for_read_callback += current_buffer_size;
-            circular_buffer_.read(to_be_parsed + shift_bytes, current_buffer_size);
+            arg_for_read_callback_ += current_buffer_size;
+            circular_buffer_.read(to_be_parsed_.data() + shift_bytes_,
+                                  current_buffer_size);
             Timestamp revcTime = recvTime_;
+            bool wake_reader = reader_blocked_;
             lock.unlock();
-            parsing_condition_.notify_one();
+            if (wake_reader)
+                parsing_condition_.notify_one();
 
-            try
-            {
-                node_->log(
-                    LogLevel::DEBUG,
-                    "Calling read_callback_() method, with number of bytes to be parsed being " +
-                        std::to_string(arg_for_read_callback));
-                read_callback_(revcTime, to_be_parsed_index, arg_for_read_callback);
-            } catch (std::size_t& parsing_failed_here)
+            boost::chrono::steady_clock::time_point now =
+                boost::chrono::steady_clock::now();
+            if (now - last_handoff_report_ > boost::chrono::seconds(10))
             {
-                to_be_parsed_index += parsing_failed_here;
-                arg_for_read_callback -= parsing_failed_here;
-                node_->log(LogLevel::DEBUG, "Current buffer size is " +
-                                                std::to_string(current_buffer_size) +
-                                                " and parsing_failed_here is " +
-                                                std::to_string(parsing_failed_here));
-                if (arg_for_read_callback < 0) // In case some parsing error was not
-                                               // caught, which should never happen..
-                {
-                    to_be_parsed_index = to_be_parsed;
-                    shift_bytes = 0;
-                    arg_for_read_callback = 0;
-                    continue;
-                }
-                shift_bytes += current_buffer_size;
-                continue;
+                node_->log(LogLevel::DEBUG,
+                           "Chunks handed over to the parsing thread while it was "
+                           "spinning: " +
+                               std::to_string(handoffs_[0]) +
+                               ", yielding: " + std::to_string(handoffs_[1]) +
+                               ", blocked: " + std::to_string(handoffs_[2]));
+                handoffs_.fill(0);
+                last_handoff_report_ = now;
             }
-            to_be_parsed_index = to_be_parsed;
-            shift_bytes = 0;
-            arg_for_read_callback = 0;
+
+            callReadCallback(revcTime, current_buffer_size);
         }
         node_->log(
             LogLevel::INFO,
             "TryParsing() method finished since it did not receive anything to parse for 10 seconds..");
-        delete[] to_be_parsed; // Freeing memory
+    }
+
+    template <typename StreamT>
+    std::size_t AsyncManager<StreamT>::awaitChunk()
+    {
+        if ((settings_->parse_handoff_spin == 0) &&
+            (settings_->parse_handoff_yield == 0))
+            return 2;
+        boost::chrono::steady_clock::time_point start =
+            boost::chrono::steady_clock::now();
+        boost::chrono::microseconds spin(settings_->parse_handoff_spin);
+        boost::chrono::microseconds yield(settings_->parse_handoff_spin +
+                                          settings_->parse_handoff_yield);
+        // The clock is read every 64 polls only, which keeps a poll at a few ns
+        for (uint32_t i = 1;; ++i)
+        {
+            if (try_parsing_.load(std::memory_order_acquire))
+                return 0;
+            cpuRelax();
+            if (((i & 63) == 0) &&
+                (boost::chrono::steady_clock::now() - start >= spin))
+                break;
+        }
+        while (boost::chrono::steady_clock::now() - start < yield)
+        {
+            if (try_parsing_.load(std::memory_order_acquire))
+                return 1;
+            boost::this_thread::yield();
+        }
+        return 2;
+    }
+
+    template <typename StreamT>
+    void AsyncManager<StreamT>::parseChunk()
+    {
+        boost::mutex::scoped_lock lock(parse_mutex_);
+        try_parsing_ = false;
+        std::size_t current_buffer_size = circular_buffer_.size();
+        arg_for_read_callback_ += current_buffer_size;
+        circular_buffer_.read(to_be_parsed_.data() + shift_bytes_,
+                              current_buffer_size);
+        Timestamp revcTime = recvTime_;
+        bool resume_reading = read_paused_;
+        read_paused_ = false;
+        lock.unlock();
+
+        if (resume_reading)
+            io_service_->post(boost::bind(&AsyncManager<StreamT>::read, this));
+
+        callReadCallback(revcTime, current_buffer_size);
+    }
+
+    template <typename StreamT>
+    void AsyncManager<StreamT>::callReadCallback(Timestamp recvTime,
+                                                 std::size_t current_buffer_size)
+    {
+        try
+        {
+            node_->log(
+                LogLevel::DEBUG,
+                "Calling read_callback_() method, with number of bytes to be parsed being " +
+                    std::to_string(arg_for_read_callback_));
+            read_callback_(recvTime, to_be_parsed_.data() + to_be_parsed_index_,
+                           arg_for_read_callback_);
+        } catch (std::size_t& parsing_failed_here)
+        {
+            to_be_parsed_index_ += parsing_failed_here;
+            arg_for_read_callback_ -= parsing_failed_here;
+            node_->log(LogLevel::DEBUG, "Current buffer size is " +
+                                            std::to_string(current_buffer_size) +
+                                            " and parsing_failed_here is " +
+                                            std::to_string(parsing_failed_here));
+            if (arg_for_read_callback_ < 0) // In case some parsing error was not
+                                            // caught, which should never happen..
+            {
+                to_be_parsed_index_ = 0;
+                shift_bytes_ = 0;
+                arg_for_read_callback_ = 0;
+                return;
+            }
+            shift_bytes_ += current_buffer_size;
+            return;
+        }
+        to_be_parsed_index_ = 0;
+        shift_bytes_ = 0;
+        arg_for_read_callback_ = 0;
     }
 
     template <typename StreamT>
@@ -305,18 +607,195 @@ namespace io_comm_rx {
             return true;
         }
 
-        io_service_->post(boost::bind(&AsyncManager<StreamT>::write, this, cmd));
+        boost::shared_ptr<const std::string> bytes =
+            boost::make_shared<const std::string>(cmd);
+        if (!enqueue(PendingWrite{bytes,
+                                  reinterpret_cast<const uint8_t*>(bytes->data()),
+                                  bytes->size(), 0,
+                                  boost::chrono::steady_clock::now()}))
+            return false;
+        node_->log(LogLevel::DEBUG, "Queued the following " +
+                                        std::to_string(cmd.size()) +
+                                        " bytes for the Rx: \n" + cmd);
+        return true;
+    }
+
+    template <typename StreamT>
+    bool AsyncManager<StreamT>::send(const boost::shared_ptr<const void>& owner,
+                                     const uint8_t* data, std::size_t size,
+                                     Timestamp origin)
+    {
+        if (size == 0)
+            return true;
+        return enqueue(PendingWrite{owner, data, size, origin,
+                                    boost::chrono::steady_clock::now()});
+    }
+
+    template <typename StreamT>
+    bool AsyncManager<StreamT>::enqueue(PendingWrite&& pending)
+    {
+        boost::mutex::scoped_lock lock(write_mutex_);
+        // Backpressure for the sender, which must not be the io_service thread
+        if (!write_space_condition_.wait_for(
+                lock, boost::chrono::seconds(1), [this, &pending]() {
+                    return stopping_ ||
+                           (queued_bytes_ + pending.size <= MAX_QUEUED_BYTES) ||
+                           write_queue_.empty();
+                }))
+        {
+            node_->log(LogLevel::ERROR,
+                       "Write queue to the Rx is full, dropping " +
+                           std::to_string(pending.size) + " bytes");
+            return false;
+        }
+        if (stopping_)
+            return false;
+        queued_bytes_ += pending.size;
+        write_queue_.push_back(std::move(pending));
+        queueWrite(lock);
+        return true;
+    }
+
+    template <typename StreamT>
+    bool AsyncManager<StreamT>::sendLatest(const char* msg, std::size_t size)
+    {
+        boost::mutex::scoped_lock lock(write_mutex_);
+        if (stopping_)
+            return false;
+        if (latest_pending_)
+        {
+            ++write_stats_.superseded;
+            latest_.owner.reset();
+        }
+        // Reuse a buffer neither pending nor in flight, so that no allocation
+        // happens once their capacity suffices
+        boost::shared_ptr<std::vector<uint8_t>> bytes;
+        for (auto& buffer : latest_buffers_)
+        {
+            if (!buffer)
+                buffer = boost::make_shared<std::vector<uint8_t>>();
+            if (buffer.use_count() == 1)
+            {
+                bytes = buffer;
+                break;
+            }
+        }
+        if (!bytes)
+            bytes = boost::make_shared<std::vector<uint8_t>>();
+        bytes->assign(msg, msg + size);
+        latest_ = PendingWrite{bytes, bytes->data(), bytes->size(), 0,
+                               boost::chrono::steady_clock::now()};
+        latest_pending_ = true;
+        queueWrite(lock);
         return true;
     }
 
     template <typename StreamT>
-    void AsyncManager<StreamT>::write(const std::string& cmd)
+    void AsyncManager<StreamT>::queueWrite(boost::mutex::scoped_lock& lock)
     {
-        boost::asio::write(*stream_, boost::asio::buffer(cmd.data(), cmd.size()));
-        // Prints the data that was sent
-        node_->log(LogLevel::DEBUG, "Sent the following " +
-                                        std::to_string(cmd.size()) +
-                                        " bytes to the Rx: \n" + cmd);
+        std::size_t depth = write_queue_.size() + (latest_pending_ ? 1 : 0);
+        if (depth > write_stats_.max_depth)
+            write_stats_.max_depth = depth;
+        if (writing_)
+            return;
+        writing_ = true;
+        lock.unlock();
+        io_service_->post(boost::bind(&AsyncManager<StreamT>::startWrite, this));
+    }
+
+    template <typename StreamT>
+    void AsyncManager<StreamT>::startWrite()
+    {
+        boost::mutex::scoped_lock lock(write_mutex_);
+        if (stopping_ || (write_queue_.empty() && !latest_pending_))
+        {
+            writing_ = false;
+            return;
+        }
+        in_flight_.clear();
+        while (!write_queue_.empty() && (in_flight_.size() < MAX_BATCH))
+        {
+            queued_bytes_ -= write_queue_.front().size;
+            in_flight_.push_back(std::move(write_queue_.front()));
+            write_queue_.pop_front();
+        }
+        if (latest_pending_)
+        {
+            in_flight_.push_back(std::move(latest_));
+            latest_pending_ = false;
+        }
+        lock.unlock();
+        write_space_condition_.notify_all();
+
+        write_buffers_.clear();
+        for (const auto& pending : in_flight_)
+            write_buffers_.push_back(
+                boost::asio::buffer(pending.data, pending.size));
+        boost::asio::async_write(
+            *stream_, write_buffers_,
+            boost::bind(&AsyncManager<StreamT>::writeHandler, this,
+                        boost::asio::placeholders::error,
+                        boost::asio::placeholders::bytes_transferred));
+    }
+
+    template <typename StreamT>
+    void AsyncManager<StreamT>::writeHandler(const boost::system::error_code& error,
+                                             std::size_t bytes_transferred)
+    {
+        if (error && !stopping_)
+            node_->log(LogLevel::ERROR,
+                       "Rx ASIO output write error: " + error.message());
+
+        auto now = boost::chrono::steady_clock::now();
+        Timestamp nowStamp = node_->getTime();
+        boost::mutex::scoped_lock lock(write_mutex_);
+        ++write_stats_.batches;
+        write_stats_.messages += in_flight_.size();
+        write_stats_.bytes += bytes_transferred;
+        for (const auto& pending : in_flight_)
+        {
+            double latency =
+                boost::chrono::duration<double>(now - pending.queued).count();
+            write_stats_.latency_sum += latency;
+            if (latency > write_stats_.latency_max)
+                write_stats_.latency_max = latency;
+            if ((pending.origin != 0) && (nowStamp >= pending.origin))
+            {
+                double age = (nowStamp - pending.origin) / 1.0e9;
+                ++write_stats_.stamped;
+                write_stats_.stamped_age_sum += age;
+                if (age > write_stats_.stamped_age_max)
+                    write_stats_.stamped_age_max = age;
+            }
+        }
+        in_flight_.clear();
+
+        if (now - last_write_report_ >= boost::chrono::seconds(10))
+        {
+            std::stringstream ss;
+            ss << "Rx write queue: " << write_stats_.batches << " writes, "
+               << write_stats_.messages << " messages, " << write_stats_.bytes
+               << " bytes, max depth " << write_stats_.max_depth
+               << ", mean latency "
+               << 1000.0 * write_stats_.latency_sum /
+                      std::max<uint64_t>(write_stats_.messages, 1)
+               << " ms, max latency " << 1000.0 * write_stats_.latency_max
+               << " ms, superseded " << write_stats_.superseded;
+            if (write_stats_.stamped > 0)
+                ss << ", " << write_stats_.stamped
+                   << " stamped messages (e.g. corrections) with mean age "
+                   << 1000.0 * write_stats_.stamped_age_sum / write_stats_.stamped
+                   << " ms, max age " << 1000.0 * write_stats_.stamped_age_max
+                   << " ms when written";
+            write_stats_ = WriteStats();
+            last_write_report_ = now;
+            lock.unlock();
+            node_->log(LogLevel::DEBUG, ss.str());
+        } else
+            lock.unlock();
+
+        // Writes what was queued meanwhile
+        startWrite();
     }
 
     template <typename StreamT>
@@ -325,17 +804,40 @@ namespace io_comm_rx {
         timer_.async_wait(boost::bind(&AsyncManager::wait, this, count));
     }
 
+    template <typename StreamT>
+    void AsyncManager<StreamT>::configure(const std::string& name,
+                                          const ThreadSettings& settings)
+    {
+        std::string errors = configureThread(name, settings);
+        if (!errors.empty())
+            node_->log(LogLevel::WARN,
+                       "Thread " + name + " keeps part of its default scheduling (" +
+                           errors + ").");
+    }
+
     template <typename StreamT>
     AsyncManager<StreamT>::AsyncManager(
         ROSaicNodeBase* node, boost::shared_ptr<StreamT> stream,
         boost::shared_ptr<boost::asio::io_service> io_service,
+        const Settings* settings, boost::shared_ptr<SharedReactor> reactor,
         std::size_t buffer_size) :
-        node_(node),
+        node_(node), settings_(settings),
         timer_(*(io_service.get()), boost::posix_time::seconds(1)), stopping_(false),
-        try_parsing_(false), allow_writing_(true), do_read_count_(0),
-        buffer_size_(buffer_size), count_max_(6), circular_buffer_(node, buffer_size)
+        bytes_received_(0), try_parsing_(false), allow_writing_(true),
+        parser_blocked_(false), reader_blocked_(false), handoffs_(),
+        last_handoff_report_(boost::chrono::steady_clock::now()),
+        do_read_count_(0),
+        buffer_size_(buffer_size), count_max_(6),
+        circular_buffer_(node, reactor ? 2 * buffer_size : buffer_size),
+        reactor_(reactor), read_paused_(false),
+        inline_parsing_(!reactor && settings->single_threaded),
+        to_be_parsed_index_(0),
+        shift_bytes_(0), arg_for_read_callback_(0), wait_count_(0),
+        queued_bytes_(0), latest_pending_(false), writing_(false),
+        last_write_report_(boost::chrono::steady_clock::now())
     // Since buffer_size = 16384 in declaration, no need in definition anymore (even
-    // yields error message, due to "overwrite").
+    // yields error message, due to "overwrite"). With a shared reactor the circular
+    // buffer holds two reads, since the reader pauses instead of blocking.
     {
         node_->log(
             LogLevel::DEBUG,
@@ -343,6 +845,7 @@ namespace io_comm_rx {
         stream_ = stream;
         io_service_ = io_service;
         in_.resize(buffer_size_);
+        to_be_parsed_.resize(buffer_size_ * 16);
 
         io_service_->post(boost::bind(&AsyncManager<StreamT>::read, this));
         // This function is used to ask the io_service to execute the given handler,
@@ -353,39 +856,111 @@ namespace io_comm_rx {
         // member functions is currently being invoked. So the fundamental difference
         // is that dispatch will execute the work right away if it can and queue it
         // otherwise while post queues the work no matter what.
-        async_background_thread_.reset(new boost::thread(
-            boost::bind(&boost::asio::io_service::run, io_service_)));
-        // Note that io_service_ is already pointer, hence need dereferencing
-        // operator & (ampersand). If the value of the pointer for the current thread
-        // is changed using reset(), then the previous value is destroyed by calling
-        // the cleanup routine. Alternatively, the stored value can be reset to NULL
-        // and the prior value returned by calling the release() member function,
-        // allowing the application to take back responsibility for destroying the
-        // object.
-        uint16_t count = 0;
-        waiting_thread_.reset(new boost::thread(
-            boost::bind(&AsyncManager::callAsyncWait, this, &count)));
+        if (reactor_)
+        {
+            // The reactor's threads run io_service and the parsing for all links
+            parse_strand_.reset(
+                new boost::asio::io_service::strand(reactor_->parseService()));
+            io_service_->post(
+                boost::bind(&AsyncManager::callAsyncWait, this, &wait_count_));
+            return;
+        }
+        async_background_thread_.reset(new boost::thread([this]() {
+            configure("rx_io", settings_->thread_io);
+            io_service_->run();
+        }));
+        if (inline_parsing_)
+        {
+            // The I/O thread reads, parses and publishes, and also runs the timer
+            io_service_->post(
+                boost::bind(&AsyncManager::callAsyncWait, this, &wait_count_));
+            return;
+        }
+        // If the value of the pointer for the current thread is changed using
+        // reset(), then the previous value is destroyed by calling the cleanup
+        // routine. Alternatively, the stored value can be reset to NULL and the
+        // prior value returned by calling the release() member function, allowing
+        // the application to take back responsibility for destroying the object.
+        waiting_thread_.reset(new boost::thread([this]() {
+            configure("rx_wait", settings_->thread_wait);
+            callAsyncWait(&wait_count_);
+        }));
 
         node_->log(LogLevel::DEBUG, "Launching tryParsing() thread..");
-        parsing_thread_.reset(
-            new boost::thread(boost::bind(&AsyncManager::tryParsing, this)));
+        parsing_thread_.reset(new boost::thread([this]() {
+            configure("rx_parse", settings_->thread_parse);
+            tryParsing();
+        }));
     } // Calls std::terminate() on thread just created
 
     template <typename StreamT>
     AsyncManager<StreamT>::~AsyncManager()
     {
+        if (reactor_)
+        {
+            // The shared reactor outlives this link, hence we have to make sure that
+            // none of its queued handlers refers to this instance any longer.
+            boost::promise<void> closed;
+            io_service_->post([this, &closed]() {
+                close();
+                timer_.cancel();
+                closed.set_value();
+            });
+            closed.get_future().wait();
+            boost::promise<void> parsed;
+            parse_strand_->post([&parsed]() { parsed.set_value(); });
+            parsed.get_future().wait();
+            boost::promise<void> drained;
+            io_service_->post([&drained]() { drained.set_value(); });
+            drained.get_future().wait();
+            return;
+        }
         close();
         io_service_->stop();
+        async_background_thread_->join();
+        if (inline_parsing_)
+            return;
         try_parsing_ = true;
         parsing_condition_.notify_one();
         parsing_thread_->join();
         waiting_thread_->join();
-        async_background_thread_->join();
     }
 
     template <typename StreamT>
     void AsyncManager<StreamT>::read()
     {
+        if (stopping_)
+            return;
+        if (inline_parsing_)
+        {
+            // Reads behind the incomplete message kept from the last read, which
+            // is moved to the front once there is not enough space left
+            if (to_be_parsed_.size() - shift_bytes_ < in_.size())
+            {
+                if (to_be_parsed_.size() - arg_for_read_callback_ < in_.size())
+                {
+                    node_->log(LogLevel::ERROR,
+                               "Discarding " +
+                                   std::to_string(arg_for_read_callback_) +
+                                   " bytes that do not form a message.");
+                    arg_for_read_callback_ = 0;
+                }
+                std::memmove(to_be_parsed_.data(),
+                             to_be_parsed_.data() + to_be_parsed_index_,
+                             arg_for_read_callback_);
+                to_be_parsed_index_ = 0;
+                shift_bytes_ = arg_for_read_callback_;
+            }
+            stream_->async_read_some(
+                boost::asio::buffer(to_be_parsed_.data() + shift_bytes_,
+                                    in_.size()),
+                boost::bind(&AsyncManager<StreamT>::asyncReadSomeHandler, this,
+                            boost::asio::placeholders::error,
+                            boost::asio::placeholders::bytes_transferred));
+            if (do_read_count_ < 5)
+                ++do_read_count_;
+            return;
+        }
         stream_->async_read_some(
             boost::asio::buffer(in_.data(), in_.size()),
             boost::bind(&AsyncManager<StreamT>::asyncReadSomeHandler, this,
@@ -409,18 +984,54 @@ namespace io_comm_rx {
         } else if (bytes_transferred > 0)
         {
             Timestamp inTime = node_->getTime();
-            if (read_callback_ &&
-                !stopping_) // Will be false in InitializeSerial (first call)
-                            // since read_callback_ not added yet..
+            bytes_received_ += bytes_transferred;
+            const uint8_t* received =
+                inline_parsing_ ? to_be_parsed_.data() + shift_bytes_ : in_.data();
+            boost::shared_ptr<RawRecorder> recorder =
+                boost::atomic_load(&recorder_);
+            if (recorder)
+                recorder->record(inTime, received, bytes_transferred);
+            if (inline_parsing_ && read_callback_ && !stopping_)
+            {
+                // Without a callback yet, the bytes are overwritten by the next read
+                arg_for_read_callback_ += bytes_transferred;
+                callReadCallback(inTime, bytes_transferred);
+            } else if (reactor_ && read_callback_ && !stopping_)
             {
+                // Pause reading instead of blocking the reactor, which is shared
+                // with other links, until parseChunk() has emptied the buffer
                 boost::mutex::scoped_lock lock(parse_mutex_);
+                circular_buffer_.write(in_.data(), bytes_transferred);
+                recvTime_ = inTime;
+                read_paused_ = (circular_buffer_.capacity() -
+                                circular_buffer_.size()) < in_.size();
+                bool paused = read_paused_;
+                if (!try_parsing_)
+                {
+                    try_parsing_ = true;
+                    parse_strand_->post(
+                        boost::bind(&AsyncManager<StreamT>::parseChunk, this));
+                }
+                lock.unlock();
+                if (paused)
+                    return;
+            } else if (read_callback_ &&
+                       !stopping_) // Will be false in InitializeSerial (first call)
+                                   // since read_callback_ not added yet..
+            {
+                boost::mutex::scoped_lock lock(parse_mutex_);
+                reader_blocked_ = true;
                 parsing_condition_.wait(lock, [this]() { return allow_writing_; });
+                reader_blocked_ = false;
                 circular_buffer_.write(in_.data(), bytes_transferred);
                 allow_writing_ = false;
-                try_parsing_ = true;
                 recvTime_ = inTime;
+                try_parsing_.store(true, std::memory_order_release);
+                // A spinning parsing thread takes the chunk over without a wake-up
+                bool wake_parser = parser_blocked_;
                 lock.unlock();
-                parsing_condition_.notify_one();
+                if (wake_parser)
+                    parsing_condition_.notify_one();
             }
         }
 
@@ -431,7 +1042,14 @@ namespace io_comm_rx {
     template <typename StreamT>
     void AsyncManager<StreamT>::close()
     {
-        stopping_ = true;
+        {
+            // Under the lock, so that a sender about to wait for write space
+            // cannot miss the notification
+            boost::mutex::scoped_lock lock(write_mutex_);
+            stopping_ = true;
+        }
+        // Releases senders blocked in enqueue() instead of letting them time out
+        write_space_condition_.notify_all();
         boost::system::error_code error;
         stream_->close(error);
         if (error)
@@ -444,6 +1062,8 @@ namespace io_comm_rx {
     template <typename StreamT>
     void AsyncManager<StreamT>::wait(uint16_t* count)
     {
+        if (stopping_)
+            return;
         if (*count < count_max_)
         {
             ++(*count);
@@ -461,7 +1081,8 @@ namespace io_comm_rx {
             node_->log(
                 LogLevel::INFO,
                 "No incoming messages, driver stopped, ros::spin() will spin forever unless you hit Ctrl+C.");
-            async_background_thread_->interrupt();
+            if (async_background_thread_)
+                async_background_thread_->interrupt();
         }
     }
 } // namespace io_comm_rx
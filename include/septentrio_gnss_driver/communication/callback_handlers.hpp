@@ -102,15 +102,6 @@
  * @brief Handles callbacks when reading NMEA/SBF messages
  */
 
-extern bool g_response_received;
-extern boost::mutex g_response_mutex;
-extern boost::condition_variable g_response_condition;
-extern bool g_cd_received;
-extern boost::mutex g_cd_mutex;
-extern boost::condition_variable g_cd_condition;
-extern uint32_t g_cd_count;
-extern std::string g_rx_tcp_port;
-
 namespace io_comm_rx {
     /**
      * @class CallbackHandler
@@ -188,11 +179,12 @@ namespace io_comm_rx {
                               boost::shared_ptr<AbstractCallbackHandler>>
             CallbackMap;
 
-        CallbackHandlers(ROSaicNodeBase* node, Settings* settings) : 
+        CallbackHandlers(ROSaicNodeBase* node, Settings* settings,
+                         LinkState* link) :
             node_(node),
-            rx_message_(node, settings),
-            settings_(settings)
-        {}
+            rx_message_(node, settings, link), settings_(settings), link_(link)
+        {
+        }
 
         /**
          * @brief Adds a pair to the multimap "callbackmap_", with the message_key
@@ -234,6 +226,19 @@ namespace io_comm_rx {
          */
         void readCallback(Timestamp recvTimestamp, const uint8_t* data, std::size_t& size);
 
+        //! Tells the stream monitor the intervals the SBF blocks are requested at
+        void configureStreamMonitor() { rx_message_.configureStreamMonitor(); }
+
+        /**
+         * @brief Publishes the pending batch of IMU samples, if there is one
+         * @param[in] due_only Whether to publish it only once it is due
+         */
+        void flushImuBatch(bool due_only)
+        {
+            boost::mutex::scoped_lock lock(callback_mutex_);
+            rx_message_.flushImuBatch(due_only);
+        }
+
         //! Callback handlers multimap for Rx messages; it needs to be public since
         //! we copy-assign (did not work otherwise) new callbackmap_, after inserting
         //! a pair to the multimap within the DefineMessages() method of the
@@ -250,54 +255,54 @@ namespace io_comm_rx {
         //! Settings
         Settings* settings_;
 
-        //! The "static" keyword resolves construct-by-copying issues related to this
-        //! mutex by making it available throughout the code unit. The mutex
-        //! constructor list contains "mutex (const mutex&) = delete", hence
-        //! construct-by-copying a mutex is explicitly prohibited. The get_handlers()
-        //! method of the Comm_IO class hence forces us to make this mutex static.
-        static boost::mutex callback_mutex_;
+        //! Handshake state of the Rx link
+        LinkState* link_;
+
+        //! Guards callbackmap_ and the do_* triggers. It is per instance, so that
+        //! several receivers handled in one process do not serialize each other.
+        boost::mutex callback_mutex_;
 
         //! Determines which of the SBF blocks necessary for the gps_common::GPSFix
         //! ROS message arrives last and thus launches its construction
-        static std::string do_gpsfix_;
+        std::string do_gpsfix_ = "4007";
 
         //! Determines which of the INS integrated SBF blocks necessary for the gps_common::GPSFix
         //! ROS message arrives last and thus launches its construction
-        static std::string do_insgpsfix_;
+        std::string do_insgpsfix_ = "4226";
 
         //! Determines which of the SBF blocks necessary for the
         //! NavSatFixMsg ROS message arrives last and thus launches its
         //! construction
-        static std::string do_navsatfix_;
+        std::string do_navsatfix_ = "4007";
 
         //! Determines which of the INS integrated SBF blocks necessary for the
         //! NavSatFixMsg ROS message arrives last and thus launches its construction
-        static std::string do_insnavsatfix_;
+        std::string do_insnavsatfix_ = "4226";
 
         //! Determines which of the SBF blocks necessary for the
         //! geometry_msgs/PoseWithCovarianceStamped ROS message arrives last and thus
         //! launches its construction
-        static std::string do_pose_;
+        std::string do_pose_ = "4007";
 
         //! Determines which of the INS integrated SBF blocks necessary for the
         //! geometry_msgs/PoseWithCovarianceStamped ROS message arrives last and thus
         //! launches its construction
-        static std::string do_inspose_;
+        std::string do_inspose_ = "4226";
 
         //! Determines which of the SBF blocks necessary for the
         //! diagnostic_msgs/DiagnosticArray ROS message arrives last and thus
         //! launches its construction
-        static std::string do_diagnostics_;
+        std::string do_diagnostics_ = "4014";
 
         //! Determines which of the SBF blocks necessary for the
         //! sensor_msgs/Imu ROS message arrives last and thus
         //! launches its construction
-        static std::string do_imu_;
+        std::string do_imu_ = "4226";
 
         //! Determines which of the SBF blocks necessary for the
         //! nav_msgs/Odometry ROS message arrives last and thus
         //! launches its construction
-        static std::string do_inslocalization_;
+        std::string do_inslocalization_ = "4226";
 
         //! Shorthand for the map responsible for matching ROS message identifiers
         //! relevant for GPSFix to a uint32_t
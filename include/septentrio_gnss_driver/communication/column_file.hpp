@@ -0,0 +1,317 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#ifndef COLUMN_FILE_HPP
+#define COLUMN_FILE_HPP
+
+/**
+ * @file column_file.hpp
+ * @date 16/10/26
+ * @brief Declares writers and a memory-mapped reader of column files, which hold
+ * one field of a table of decoded SBF blocks each
+ *
+ * A column file starts with a header of HEADER_SIZE bytes: the magic "SBFCOL1\n"
+ * followed by a one-line JSON schema, padded with spaces, e.g.
+ * {"table":"pvt","column":"latitude","type":"f64","count":3600,"unit":"rad"}.
+ * The values follow as a fixed-width little-endian array. Variable-length data,
+ * such as the signals of a MeasEpoch block, is stored as a table of its own
+ * whose rows are referenced by a column of type u64 with one entry more than the
+ * rows of its parent table: the rows of parent row i are [offsets[i],
+ * offsets[i + 1]). The schema of such a column names the child table in
+ * "offsets_of". Neither writer nor reader depends on ROS, so that analytics can
+ * link the reader only.
+ */
+
+namespace io_comm_rx {
+
+    //! Type names and widths of the values of a column
+    template <typename T>
+    struct ColumnType;
+    template <>
+    struct ColumnType<uint8_t>
+    {
+        static constexpr const char* name = "u8";
+    };
+    template <>
+    struct ColumnType<int8_t>
+    {
+        static constexpr const char* name = "i8";
+    };
+    template <>
+    struct ColumnType<uint16_t>
+    {
+        static constexpr const char* name = "u16";
+    };
+    template <>
+    struct ColumnType<int16_t>
+    {
+        static constexpr const char* name = "i16";
+    };
+    template <>
+    struct ColumnType<uint32_t>
+    {
+        static constexpr const char* name = "u32";
+    };
+    template <>
+    struct ColumnType<int32_t>
+    {
+        static constexpr const char* name = "i32";
+    };
+    template <>
+    struct ColumnType<uint64_t>
+    {
+        static constexpr const char* name = "u64";
+    };
+    template <>
+    struct ColumnType<float>
+    {
+        static constexpr const char* name = "f32";
+    };
+    template <>
+    struct ColumnType<double>
+    {
+        static constexpr const char* name = "f64";
+    };
+
+    //! Size of the header of a column file, which keeps the values aligned
+    static const std::size_t COLUMN_HEADER_SIZE = 512;
+
+    /**
+     * @brief Path of a column file
+     * @param[in] directory Directory of the export
+     * @param[in] table Name of the table
+     * @param[in] column Name of the column
+     * @return Path "<directory>/<table>/<column>.col"
+     */
+    std::string columnPath(const std::string& directory, const std::string& table,
+                           const std::string& column);
+
+    /**
+     * @class ColumnFileWriter
+     * @brief Appends values of any width to a column file through a buffer and
+     * writes its header with the final count when closed
+     */
+    class ColumnFileWriter
+    {
+    public:
+        /**
+         * @brief Constructor of the class ColumnFileWriter, creating the file and
+         * the directory of its table
+         * @param[in] directory Directory of the export
+         * @param[in] table Name of the table
+         * @param[in] column Name of the column
+         * @param[in] type Name of the type of the values
+         * @param[in] width Size of one value in bytes
+         * @param[in] unit Unit of the values, empty if none
+         * @param[in] offsets_of Table whose rows the values are offsets of, empty
+         * if none
+         */
+        ColumnFileWriter(const std::string& directory, const std::string& table,
+                         const std::string& column, const std::string& type,
+                         std::size_t width, const std::string& unit,
+                         const std::string& offsets_of);
+
+        ColumnFileWriter(const ColumnFileWriter&) = delete;
+        ColumnFileWriter& operator=(const ColumnFileWriter&) = delete;
+
+        //! Closes the file if not yet done
+        ~ColumnFileWriter();
+
+        //! Returns false if the file could not be created or written
+        bool good() const { return good_; }
+
+        //! Returns the path of the file
+        const std::string& path() const { return path_; }
+
+        //! Returns the number of values appended so far
+        uint64_t count() const { return count_; }
+
+        /**
+         * @brief Flushes the buffer and writes the header
+         * @return False on any error since the file was created
+         */
+        bool close();
+
+    protected:
+        //! Appends one value of width bytes
+        void appendBytes(const void* value)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(value);
+            buffer_.insert(buffer_.end(), bytes, bytes + width_);
+            ++count_;
+            if (buffer_.size() >= BUFFER_SIZE)
+                flush();
+        }
+
+    private:
+        //! Writes the buffer to the file
+        void flush();
+
+        //! Size of the buffer at which it is written to the file
+        static const std::size_t BUFFER_SIZE = 1 << 20;
+
+        //! Path of the file
+        std::string path_;
+        //! Name of the table
+        std::string table_;
+        //! Name of the column
+        std::string column_;
+        //! Name of the type of the values
+        std::string type_;
+        //! Size of one value in bytes
+        std::size_t width_;
+        //! Unit of the values
+        std::string unit_;
+        //! Table whose rows the values are offsets of
+        std::string offsets_of_;
+        //! The file, nullptr once closed
+        std::FILE* file_;
+        //! Values not yet written
+        std::vector<uint8_t> buffer_;
+        //! Number of values appended
+        uint64_t count_;
+        //! Whether all operations succeeded
+        bool good_;
+    };
+
+    /**
+     * @class ColumnWriter
+     * @brief Writer of a column of values of type T
+     */
+    template <typename T>
+    class ColumnWriter : public ColumnFileWriter
+    {
+    public:
+        /**
+         * @brief Constructor of the class ColumnWriter
+         * @param[in] directory Directory of the export
+         * @param[in] table Name of the table
+         * @param[in] column Name of the column
+         * @param[in] unit Unit of the values, empty if none
+         * @param[in] offsets_of Table whose rows the values are offsets of, empty
+         * if none
+         */
+        ColumnWriter(const std::string& directory, const std::string& table,
+                     const std::string& column, const std::string& unit = "",
+                     const std::string& offsets_of = "") :
+            ColumnFileWriter(directory, table, column, ColumnType<T>::name,
+                             sizeof(T), unit, offsets_of)
+        {
+        }
+
+        //! Appends one value
+        void append(T value) { appendBytes(&value); }
+    };
+
+    /**
+     * @class ColumnReader
+     * @brief Maps a column file into memory and gives typed access to its values
+     * without copying them
+     */
+    class ColumnReader
+    {
+    public:
+        ColumnReader();
+
+        ColumnReader(const ColumnReader&) = delete;
+        ColumnReader& operator=(const ColumnReader&) = delete;
+
+        //! Unmaps the file
+        ~ColumnReader();
+
+        /**
+         * @brief Maps a column file and reads its header
+         * @param[in] path Path of the column file
+         * @return False if the file is missing, has no valid header or is shorter
+         * than its count of values
+         */
+        bool open(const std::string& path);
+
+        //! Unmaps the file, if any
+        void close();
+
+        //! Returns the name of the table
+        const std::string& table() const { return table_; }
+
+        //! Returns the name of the column
+        const std::string& column() const { return column_; }
+
+        //! Returns the name of the type of the values
+        const std::string& type() const { return type_; }
+
+        //! Returns the unit of the values, empty if none
+        const std::string& unit() const { return unit_; }
+
+        //! Returns the table whose rows the values are offsets of, empty if none
+        const std::string& offsetsOf() const { return offsets_of_; }
+
+        //! Returns the number of values
+        uint64_t size() const { return count_; }
+
+        /**
+         * @brief Gets the values
+         * @return Pointer to size() values, nullptr if T is not the type of the
+         * column or no file is open
+         */
+        template <typename T>
+        const T* data() const
+        {
+            if (!data_ || (type_ != ColumnType<T>::name))
+                return nullptr;
+            return reinterpret_cast<const T*>(data_ + COLUMN_HEADER_SIZE);
+        }
+
+    private:
+        //! Mapped file
+        const uint8_t* data_;
+        //! Size of the mapped file
+        std::size_t mapped_size_;
+        //! Name of the table
+        std::string table_;
+        //! Name of the column
+        std::string column_;
+        //! Name of the type of the values
+        std::string type_;
+        //! Unit of the values
+        std::string unit_;
+        //! Table whose rows the values are offsets of
+        std::string offsets_of_;
+        //! Number of values
+        uint64_t count_;
+    };
+} // namespace io_comm_rx
+
+#endif // COLUMN_FILE_HPP
@@ -67,6 +67,7 @@
 #include <boost/asio.hpp>
 #include <boost/asio/serial_port.hpp>
 #include <boost/bind.hpp>
+#include <boost/chrono.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/exception/diagnostic_information.hpp> // dealing with bad file descriptor error
 #include <boost/function.hpp>
@@ -75,6 +76,7 @@
 #include <memory>
 #include <sstream>
 #include <unistd.h> // for usleep()
+#include <vector>
 // ROSaic includes
 #include <septentrio_gnss_driver/communication/async_manager.hpp>
 #include <septentrio_gnss_driver/communication/callback_handlers.hpp>
@@ -109,8 +111,13 @@ namespace io_comm_rx {
         /**
          * @brief Constructor of the class Comm_IO
          * @param[in] node Pointer to node
+         * @param[in] settings The device's settings
+         * @param[in] reactor Reactor shared with other Rx links handled by this
+         * process, empty if this link shall run its own I/O and parsing threads
          */
-        Comm_IO(ROSaicNodeBase* node, Settings* settings);
+        Comm_IO(ROSaicNodeBase* node, Settings* settings,
+                boost::shared_ptr<SharedReactor> reactor =
+                    boost::shared_ptr<SharedReactor>());
         /**
          * @brief Default destructor of the class Comm_IO
          */
@@ -135,11 +142,27 @@ namespace io_comm_rx {
         void defineMessages();
 
         /**
-         * @brief Hands over NMEA velocity message over to the send() method of
-         * manager_
-         * @param cmd The command to hand over
+         * @brief Hands over NMEA velocity message over to the sendLatest() method
+         * of manager_
+         * @param[in] velNmea The NMEA sentence to hand over
+         * @param[in] size Number of characters of the sentence
+         */
+        void sendVelocity(const char* velNmea, std::size_t size);
+
+        /**
+         * @brief Hands RTCM corrections over to the send() method of manager_,
+         * which keeps the message alive instead of copying its bytes
+         * @param rtcm ROS message holding the corrections
          */
-        void sendVelocity(const std::string& velNmea);
+        void sendCorrections(const RtcmMsg::ConstPtr& rtcm);
+
+        /**
+         * @brief Parses SBF/NMEA data read from a file and publishes the defined
+         * messages, in windows of 8192 bytes
+         * @param[in] data Pointer to the data
+         * @param[in] size Size of the data
+         */
+        void parseBuffer(const uint8_t* data, std::size_t size);
 
     private:
         /**
@@ -211,13 +234,77 @@ namespace io_comm_rx {
         void setManager(const boost::shared_ptr<Manager>& manager);
 
         /**
-         * @brief Hands over to the send() method of manager_
+         * @brief Hands over to the send() method of manager_ and waits for the
+         * reply, unless the command could not be queued
          * @param cmd The command to hand over
          */
         void send(const std::string&);
 
+        /**
+         * @brief Hands over to the send() method of manager_, waiting at most
+         * timeout for the reply, for commands sent while the Rx is running
+         * @param cmd The command to hand over
+         * @param timeout Time to wait for the reply
+         * @return True if the Rx replied in time, false otherwise, also if the
+         * command could not be queued
+         */
+        bool send(const std::string& cmd,
+                  const boost::chrono::milliseconds& timeout);
+
+        /**
+         * @brief Whether an output is enabled and, with demand-driven output, has
+         * subscribers
+         * @param[in] publish Whether the output is enabled
+         * @param[in] topic Topic of the output
+         */
+        bool wanted(bool publish, const std::string& topic) const;
+
+        /**
+         * @brief Determines the SBF blocks output with rx_period_pvt
+         * @return Names of the blocks
+         */
+        std::vector<std::string> pvtBlocks() const;
+
+        /**
+         * @brief Determines the SBF blocks output with rx_period_rest
+         * @return Names of the blocks
+         */
+        std::vector<std::string> restBlocks() const;
+
+        /**
+         * @brief Configures the two SBF streams of the main port
+         * @param[in] pvt_blocks Blocks output with rx_period_pvt
+         * @param[in] rest_blocks Blocks output with rx_period_rest
+         * @param[in] runtime Whether the Rx is running already, in which case the
+         * replies are waited for with a timeout
+         * @return True if the Rx replied to the commands, false otherwise
+         */
+        bool sendSbfStreams(const std::vector<std::string>& pvt_blocks,
+                            const std::vector<std::string>& rest_blocks,
+                            bool runtime = false);
+
+        /**
+         * @brief Reconfigures the SBF streams whenever the needed blocks change, and
+         * tracks the byte rate of the link, until stopping_
+         */
+        void followDemand();
+
+        /**
+         * @brief Publishes pending IMU batches once they are due, until stopping_,
+         * so that the last samples are not held back if no more blocks arrive
+         */
+        void flushImuBatches();
+
+        /**
+         * @brief Whether needed contains blocks that are not in active
+         */
+        static bool addsBlocks(const std::vector<std::string>& active,
+                               const std::vector<std::string>& needed);
+
         //! Pointer to Node
         ROSaicNodeBase* node_;
+        //! Handshake state of the link to the Rx
+        LinkState link_;
         //! Callback handlers for the inwards streaming messages
         CallbackHandlers handlers_;
         //! Settings
@@ -245,11 +332,28 @@ namespace io_comm_rx {
         boost::shared_ptr<Manager> manager_;
         //! Baudrate at the moment, unless InitializeSerial or ResetSerial fail
         uint32_t baudrate_;
+        //! Reactor shared with other Rx links, empty if not used
+        boost::shared_ptr<SharedReactor> reactor_;
+        //! Records the raw stream of the Rx, empty if not recording
+        boost::shared_ptr<RawRecorder> recorder_;
 
         bool nmeaActivated_ = false;
 
+        //! Whether the main port accepts corrections
+        bool correctionsActivated_ = false;
+
         //! Connection or reading thread
         std::unique_ptr<boost::thread> connectionThread_;
+        //! Thread following the demand of the subscribers
+        std::unique_ptr<boost::thread> demandThread_;
+        //! Thread publishing IMU batches that are due
+        std::unique_ptr<boost::thread> batchThread_;
+        //! SBF blocks currently output with rx_period_pvt
+        std::vector<std::string> active_pvt_blocks_;
+        //! SBF blocks currently output with rx_period_rest
+        std::vector<std::string> active_rest_blocks_;
+        //! Bytes per second received from the Rx during the last second
+        double link_byte_rate_ = 0.0;
         //! Indicator for threads to exit
         std::atomic<bool> stopping_;
 
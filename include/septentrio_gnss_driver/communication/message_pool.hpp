@@ -0,0 +1,114 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// Boost includes
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+// C++ library includes
+#include <cstdint>
+#include <vector>
+
+#ifndef MESSAGE_POOL_HPP
+#define MESSAGE_POOL_HPP
+
+/**
+ * @file message_pool.hpp
+ * @date 16/10/26
+ * @brief Declares a pool recycling published messages once nobody holds them
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @class MessagePool
+     * @brief Hands out messages to be parsed into and published as shared pointers,
+     * reusing those no longer referenced by the driver, roscpp or subscribers
+     *
+     * A reused message keeps the capacity of its vectors, so that once the pool is
+     * warm, parsing an epoch of the same size does not touch the heap. Messages
+     * still held elsewhere are never modified; if all are held, a new message is
+     * allocated from the heap. The parser has to overwrite every field of the
+     * message it is handed.
+     */
+    template <typename M>
+    class MessagePool
+    {
+    public:
+        /**
+         * @brief Constructor of the class MessagePool
+         * @param[in] size Number of messages kept for reuse, at least two since
+         * the latest message is usually still held
+         */
+        explicit MessagePool(std::size_t size = 4) :
+            size_(size), allocations_(0), reuses_(0)
+        {
+            pool_.reserve(size_);
+        }
+
+        /**
+         * @brief Gets a message nobody else references
+         * @return The message, with stale content if reused
+         */
+        boost::shared_ptr<M> acquire()
+        {
+            for (const auto& msg : pool_)
+            {
+                if (msg.use_count() == 1)
+                {
+                    ++reuses_;
+                    return msg;
+                }
+            }
+            ++allocations_;
+            boost::shared_ptr<M> msg = boost::make_shared<M>();
+            if (pool_.size() < size_)
+                pool_.push_back(msg);
+            return msg;
+        }
+
+        //! Number of messages allocated from the heap so far
+        uint64_t allocations() const { return allocations_; }
+
+        //! Number of messages reused so far
+        uint64_t reuses() const { return reuses_; }
+
+    private:
+        //! Number of messages kept for reuse
+        std::size_t size_;
+        //! Messages kept for reuse
+        std::vector<boost::shared_ptr<M>> pool_;
+        //! Number of messages allocated from the heap so far
+        uint64_t allocations_;
+        //! Number of messages reused so far
+        uint64_t reuses_;
+    };
+} // namespace io_comm_rx
+
+#endif // MESSAGE_POOL_HPP
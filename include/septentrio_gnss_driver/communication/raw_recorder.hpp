@@ -0,0 +1,189 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// Boost includes
+#include <boost/chrono.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/condition.hpp>
+// C++ library includes
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+// ROSaic includes
+#include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+
+#ifndef RAW_RECORDER_HPP
+#define RAW_RECORDER_HPP
+
+/**
+ * @file raw_recorder.hpp
+ * @date 16/10/26
+ * @brief Declares a class recording the raw byte stream of the Rx into rotated
+ * files
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @class RawRecorder
+     * @brief Records every chunk received from the Rx, exactly as handed over by
+     * async_read_some, into an SBF file plus a sidecar file of receive timestamps
+     *
+     * The reading thread only copies the chunk into a preallocated slot of a
+     * lock-free queue. A dedicated thread writes the slots in large aligned blocks,
+     * calls fdatasync() once per sync period and rotates the files by size or
+     * duration. If the queue is full, the chunk is dropped and counted rather than
+     * blocking the reader.
+     *
+     * The sidecar file (same name, extension ".ts") holds one little-endian record
+     * per chunk: receive timestamp [ns since Unix epoch] (uint64), offset of the
+     * chunk in the SBF file (uint64) and its size (uint32).
+     */
+    class RawRecorder
+    {
+    public:
+        /**
+         * @brief Constructor of the class RawRecorder, starts the writing thread
+         * @param[in] node Pointer to the node
+         * @param[in] settings The device's settings
+         * @param[in] chunk_size Maximum size of a chunk handed over to record()
+         */
+        RawRecorder(ROSaicNodeBase* node, const Settings* settings,
+                    std::size_t chunk_size);
+        /**
+         * @brief Destructor of the class RawRecorder, writes what is left, syncs
+         * and closes the files
+         */
+        ~RawRecorder();
+
+        /**
+         * @brief Queues a chunk for recording, never blocks
+         * @param[in] recvTime Timestamp of reception of the chunk
+         * @param[in] data Pointer to the chunk
+         * @param[in] size Size of the chunk, which takes several slots of the queue
+         * if it is larger than chunk_size
+         */
+        void record(Timestamp recvTime, const uint8_t* data, std::size_t size);
+
+    private:
+        //! Received chunk waiting to be written
+        struct Chunk
+        {
+            //! Timestamp of reception
+            Timestamp recv_time;
+            //! Number of valid bytes in data
+            std::size_t size;
+            //! Bytes of the chunk
+            std::vector<uint8_t> data;
+        };
+
+        //! Number of chunks that can be queued
+        static const std::size_t QUEUE_SIZE = 256;
+        //! Size of the aligned block the SBF file is written in
+        static const std::size_t BLOCK_SIZE = 1 << 20;
+        //! Alignment of the block
+        static const std::size_t BLOCK_ALIGNMENT = 4096;
+        //! Size of one record of the sidecar file
+        static const std::size_t SIDECAR_RECORD_SIZE = 20;
+
+        //! Body of the writing thread
+        void run();
+        //! Appends a chunk to the current files, rotating them if needed
+        void append(const Chunk& chunk);
+        //! Opens a new pair of files named after the Rx and the timestamp, never
+        //! overwriting existing files
+        bool openFiles(Timestamp stamp);
+        //! Flushes, syncs and closes the current files
+        void closeFiles();
+        //! Writes the staged bytes to the files and optionally syncs them
+        void flush(bool sync);
+        //! Writes size bytes to fd, returns false on error
+        bool writeAll(int fd, const uint8_t* data, std::size_t size);
+
+        //! Pointer to the node
+        ROSaicNodeBase* node_;
+        //! Directory the files are written to
+        std::string directory_;
+        //! Start of the file names, holding the name of the Rx if there is one
+        std::string prefix_;
+        //! Maximum size of a file in bytes, 0 for no limit
+        uint64_t max_file_size_;
+        //! Maximum duration of a file in nanoseconds, 0 for no limit
+        uint64_t max_file_duration_;
+        //! Period between two fdatasync() calls
+        boost::chrono::milliseconds sync_period_;
+
+        //! Storage of all chunks
+        std::vector<Chunk> chunks_;
+        //! Chunks filled by the reader, to be written
+        boost::lockfree::spsc_queue<Chunk*, boost::lockfree::capacity<QUEUE_SIZE>>
+            filled_;
+        //! Chunks written, to be filled again by the reader
+        boost::lockfree::spsc_queue<Chunk*, boost::lockfree::capacity<QUEUE_SIZE>>
+            free_;
+        //! Number of chunks dropped since the queue was full
+        std::atomic<uint64_t> dropped_;
+        //! Whether the writing thread shall finish
+        std::atomic<bool> stopping_;
+        //! Mutex complementing "wake_condition_"
+        boost::mutex wake_mutex_;
+        //! Wakes the writing thread when chunks are queued
+        boost::condition_variable wake_condition_;
+        //! Writing thread
+        boost::thread writing_thread_;
+
+        //! Aligned block of SBF bytes not yet written
+        uint8_t* block_;
+        //! Number of bytes in block_
+        std::size_t block_fill_;
+        //! Sidecar records not yet written
+        std::vector<uint8_t> sidecar_;
+        //! File descriptor of the current SBF file, -1 if none is open
+        int sbf_fd_;
+        //! File descriptor of the current sidecar file, -1 if none is open
+        int sidecar_fd_;
+        //! Number of bytes in the current SBF file, including block_
+        uint64_t file_size_;
+        //! Timestamp of the first chunk of the current file
+        Timestamp file_start_;
+        //! Time of the last fdatasync()
+        boost::chrono::steady_clock::time_point last_sync_;
+        //! Number of files opened so far, makes file names unique
+        uint32_t file_count_;
+        //! Number of dropped chunks reported so far
+        uint64_t dropped_reported_;
+        //! Whether writing failed, which stops the recording
+        bool failed_;
+    };
+} // namespace io_comm_rx
+
+#endif // for RAW_RECORDER_HPP
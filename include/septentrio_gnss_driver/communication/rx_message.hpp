@@ -101,23 +101,37 @@
 #endif
 
 // C++ libraries
+#include <bitset>
 #include <cassert> // for assert
+#include <cctype>
 #include <cstddef>
+#include <limits>
 #include <map>
 #include <sstream>
+#include <vector>
 // Boost includes
 #include <boost/call_traits.hpp>
+#include <boost/chrono.hpp>
 #include <boost/format.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/math/constants/constants.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
 #include <boost/tokenizer.hpp>
 // ROSaic includes
 #include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+#include <septentrio_gnss_driver/communication/message_pool.hpp>
+#include <septentrio_gnss_driver/communication/stream_monitor.hpp>
 #include <septentrio_gnss_driver/crc/crc.h>
+#include <septentrio_gnss_driver/parsers/gsv_assembler.hpp>
+#include <septentrio_gnss_driver/parsers/meas_epoch_decoder.hpp>
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gpgga.hpp>
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gpgsa.hpp>
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gpgsv.hpp>
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gprmc.hpp>
 #include <septentrio_gnss_driver/parsers/string_utilities.h>
+#include <septentrio_gnss_driver/parsers/utm_projection.hpp>
 
 #ifndef RX_MESSAGE_HPP
 #define RX_MESSAGE_HPP
@@ -128,9 +142,6 @@
  * @brief Defines a class that reads messages handed over from the circular buffer
  */
 
-extern bool g_read_cd;
-extern uint32_t g_cd_count;
-
 //! Enum for NavSatFix's status.status field, which is obtained from PVTGeodetic's
 //! Mode field
 enum TypeOfPVT_Enum
@@ -164,6 +175,7 @@ enum RxID_Enum
     evGPGSV,
     evGLGSV,
     evGAGSV,
+    evGBGSV,
     evPVTCartesian,
     evPVTGeodetic,
     evBaseVectorCart,
@@ -194,6 +206,36 @@ enum RxID_Enum
 
 namespace io_comm_rx {
 
+    /**
+     * @struct LinkState
+     * @brief Handshake state of a single Rx link, i.e. command replies and
+     * connection descriptors, shared between Comm_IO, CallbackHandlers and
+     * RxMessage
+     */
+    struct LinkState
+    {
+        //! Mutex to control changes of "response_received"
+        boost::mutex response_mutex;
+        //! Determines whether a command reply was received from the Rx
+        bool response_received = false;
+        //! Condition variable complementing "response_mutex"
+        boost::condition_variable response_condition;
+        //! Mutex to control changes of "cd_received"
+        boost::mutex cd_mutex;
+        //! Determines whether the connection descriptor was received from the Rx
+        bool cd_received = false;
+        //! Condition variable complementing "cd_mutex"
+        boost::condition_variable cd_condition;
+        //! Whether or not we still want to read the connection descriptor, which we
+        //! only want in the very beginning to know whether it is IP10, IP11 etc.
+        bool read_cd = true;
+        //! Rx TCP port, e.g. IP10 or IP11, to which ROSaic is connected to
+        std::string rx_tcp_port;
+        //! Since after SSSSSSSSSSS we need to wait for second connection
+        //! descriptor, we have to count the connection descriptors
+        uint32_t cd_count = 0;
+    };
+
     /**
      * @class RxMessage
      * @brief Can search buffer for messages, read/parse them, and so on
@@ -210,13 +252,29 @@ namespace io_comm_rx {
          * no other C++ cast is capable of removing it (not even reinterpret_cast)
          * @param[in] data Pointer to the buffer that is about to be analyzed
          * @param[in] size Size of the buffer (as handed over by async_read_some)
+         * @param[in] link Handshake state of the Rx link this instance reads from
          */
-        RxMessage(ROSaicNodeBase* node, Settings* settings) :
-            node_(node), settings_(settings), unix_time_(0)
+        RxMessage(ROSaicNodeBase* node, Settings* settings, LinkState* link) :
+            node_(node), settings_(settings), link_(link), unix_time_(0)
         {
             found_ = false;
             crc_check_ = false;
+            crc_checked_block_ = nullptr;
             message_size_ = 0;
+            count_discarded_ = true;
+
+            // Blocks are published as they are parsed and only replaced, never
+            // modified, so composites can always read a valid latest block
+            last_pvtgeodetic_ = boost::make_shared<PVTGeodeticMsg>();
+            last_poscovgeodetic_ = boost::make_shared<PosCovGeodeticMsg>();
+            last_atteuler_ = boost::make_shared<AttEulerMsg>();
+            last_attcoveuler_ = boost::make_shared<AttCovEulerMsg>();
+            last_insnavgeod_ = boost::make_shared<INSNavGeodMsg>();
+            last_extsensmeas_ = boost::make_shared<ExtSensorMeasMsg>();
+            last_measepoch_ = boost::make_shared<MeasEpochMsg>();
+            last_velcovgeodetic_ = boost::make_shared<VelCovGeodeticMsg>();
+            last_pool_report_ = boost::chrono::steady_clock::now();
+            last_stream_report_ = last_pool_report_;
 
             //! Pair of iterators to facilitate initialization of the map
             std::pair<uint16_t, TypeOfPVT_Enum> type_of_pvt_pairs[] = {
@@ -250,6 +308,7 @@ namespace io_comm_rx {
                 std::make_pair("$GPGSV", evGPGSV),
                 std::make_pair("$GLGSV", evGLGSV),
                 std::make_pair("$GAGSV", evGAGSV),
+                std::make_pair("$GBGSV", evGBGSV),
                 std::make_pair("4006", evPVTCartesian),
                 std::make_pair("4007", evPVTGeodetic),
                 std::make_pair("4043", evBaseVectorCart),
@@ -278,6 +337,11 @@ namespace io_comm_rx {
                 std::make_pair("5914", evReceiverTime)};
 
             rx_id_map = RxIDMap(rx_id_pairs, rx_id_pairs + evReceiverSetup + 1);
+            for (const auto& pair : rx_id_map)
+            {
+                if (std::isdigit(static_cast<unsigned char>(pair.first[0])))
+                    known_sbf_ids_.set(std::stoi(pair.first));
+            }
         }
 
         /**
@@ -293,6 +357,7 @@ namespace io_comm_rx {
             count_ = size;
             found_ = false;
             crc_check_ = false;
+            crc_checked_block_ = nullptr;
             message_size_ = 0;
         }
 
@@ -375,6 +440,22 @@ namespace io_comm_rx {
         template <typename M>
         void publish(const std::string& topic, const M& msg);
 
+        /**
+         * @brief Publishing function, handing the message over without copying it
+         * @param[in] topic String of topic
+         * @param[in] msg ROS message to be published, must not be modified
+         * afterwards
+         */
+        template <typename M>
+        void publish(const std::string& topic,
+                     const boost::shared_ptr<const M>& msg);
+
+        /**
+         * @brief Whether messages may be published, which with GNSS time needs the
+         * leap seconds
+         */
+        bool publishable();
+
         /**
          * @brief Publishing function
          * @param[in] msg Localization message
@@ -387,6 +468,35 @@ namespace io_comm_rx {
          */
         bool read(std::string message_key, bool search = false);
 
+        /**
+         * @brief Records the SBF block at hand in the stream monitor, to be called
+         * once per complete block
+         */
+        void monitorStream();
+
+        /**
+         * @brief Tells the stream monitor the intervals the SBF blocks are
+         * requested at, to be called once the settings are read
+         */
+        void configureStreamMonitor();
+
+        /**
+         * @brief Publishes the pending batch of IMU samples, if there is one
+         * @param[in] due_only Whether to publish it only once imu_batch/max_delay
+         * has passed since its first sample arrived
+         */
+        void flushImuBatch(bool due_only);
+
+        /**
+         * @brief Gets the last stream degradation
+         * @return Number of missing, late and out-of-order blocks and CRC errors
+         * in the last second
+         */
+        const std::array<uint32_t, 4>& streamDegradation() const
+        {
+            return stream_monitor_.lastDegradation();
+        }
+
         /**
          * @brief Whether or not a message has been found
          */
@@ -459,6 +569,16 @@ namespace io_comm_rx {
          */
         bool crc_check_;
 
+        //! Block crc_check_ was evaluated for, so that it is checked only once
+        const uint8_t* crc_checked_block_;
+
+        //! Whether the bytes search() skips are discarded, rather than the body of
+        //! an NMEA message or command reply, which next() does not jump over
+        bool count_discarded_;
+
+        //! SBF block IDs the driver decodes, as found in rx_id_map
+        std::bitset<8192> known_sbf_ids_;
+
         /**
          * @brief Helps to determine size of response message / NMEA message / SBF
          * block
@@ -474,37 +594,37 @@ namespace io_comm_rx {
          * @brief Since NavSatFix etc. need PVTGeodetic, incoming PVTGeodetic blocks
          * need to be stored
          */
-        PVTGeodeticMsg last_pvtgeodetic_;
+        boost::shared_ptr<const PVTGeodeticMsg> last_pvtgeodetic_;
 
         /**
          * @brief Since NavSatFix etc. need PosCovGeodetic, incoming PosCovGeodetic
          * blocks need to be stored
          */
-        PosCovGeodeticMsg last_poscovgeodetic_;
+        boost::shared_ptr<const PosCovGeodeticMsg> last_poscovgeodetic_;
 
         /**
          * @brief Since GPSFix etc. need AttEuler, incoming AttEuler blocks need to
          * be stored
          */
-        AttEulerMsg last_atteuler_;
+        boost::shared_ptr<const AttEulerMsg> last_atteuler_;
 
         /**
          * @brief Since GPSFix etc. need AttCovEuler, incoming AttCovEuler blocks
          * need to be stored
          */
-        AttCovEulerMsg last_attcoveuler_;
+        boost::shared_ptr<const AttCovEulerMsg> last_attcoveuler_;
 
         /**
          * @brief Since NavSatFix, GPSFix, Imu and Pose. need INSNavGeod, incoming
          * INSNavGeod blocks need to be stored
          */
-        INSNavGeodMsg last_insnavgeod_;
+        boost::shared_ptr<const INSNavGeodMsg> last_insnavgeod_;
 
         /**
          * @brief Since Imu needs ExtSensorMeas, incoming ExtSensorMeas blocks
          * need to be stored
          */
-        ExtSensorMeasMsg last_extsensmeas_;
+        boost::shared_ptr<const ExtSensorMeasMsg> last_extsensmeas_;
 
         /**
          * @brief Since GPSFix needs ChannelStatus, incoming ChannelStatus blocks
@@ -516,7 +636,7 @@ namespace io_comm_rx {
          * @brief Since GPSFix needs MeasEpoch (for SNRs), incoming MeasEpoch blocks
          * need to be stored
          */
-        MeasEpochMsg last_measepoch_;
+        boost::shared_ptr<const MeasEpochMsg> last_measepoch_;
 
         /**
          * @brief Since GPSFix needs DOP, incoming DOP blocks need to be stored
@@ -527,7 +647,7 @@ namespace io_comm_rx {
          * @brief Since GPSFix needs VelCovGeodetic, incoming VelCovGeodetic blocks
          * need to be stored
          */
-        VelCovGeodeticMsg last_velcovgeodetic_;
+        boost::shared_ptr<const VelCovGeodeticMsg> last_velcovgeodetic_;
 
         /**
          * @brief Since DiagnosticArray needs ReceiverStatus, incoming ReceiverStatus
@@ -547,6 +667,96 @@ namespace io_comm_rx {
          */
         ReceiverSetup last_receiversetup_;
 
+        //! Messages the blocks stored above are parsed into, reused once
+        //! published and released
+        MessagePool<PVTGeodeticMsg> pvtgeodetic_pool_;
+        MessagePool<PosCovGeodeticMsg> poscovgeodetic_pool_;
+        MessagePool<AttEulerMsg> atteuler_pool_;
+        MessagePool<AttCovEulerMsg> attcoveuler_pool_;
+        MessagePool<INSNavGeodMsg> insnavgeod_pool_;
+        MessagePool<ExtSensorMeasMsg> extsensmeas_pool_;
+        MessagePool<MeasEpochMsg> measepoch_pool_;
+        MessagePool<VelCovGeodeticMsg> velcovgeodetic_pool_;
+        //! GPSFix messages, whose satellite arrays keep their capacity
+        MessagePool<GPSFixMsg> gpsfix_pool_;
+        //! RawObservables messages, whose arrays keep their capacity
+        MessagePool<RawObservablesMsg> rawobservables_pool_;
+        //! ImuBatch messages, whose sample arrays keep their capacity
+        MessagePool<ImuBatchMsg> imubatch_pool_;
+
+        //! IMU samples not published yet, null if there are none
+        boost::shared_ptr<ImuBatchMsg> imubatch_;
+        //! Time the first sample of the pending batch arrived
+        boost::chrono::steady_clock::time_point imubatch_start_;
+
+        //! Largest age of INSNavGeod in ns at which its orientation is put into an
+        //! IMU message, from polling_period_pvt of this Rx, 0 until first needed
+        int64_t imu_max_ins_age_ = 0;
+
+        //! Decodes MeasEpoch blocks into RawObservables messages
+        parsing_utilities::MeasEpochDecoder measepoch_decoder_;
+
+        //! Assembles the GSV sentences of an epoch into one SatellitesInView
+        parsing_utilities::GsvAssembler gsv_assembler_;
+        //! Number of GSV sequences rejected when last logged
+        uint64_t gsv_rejected_logged_ = 0;
+
+        //! Scratch vectors of GPSFixCallback(), kept to retain their capacity
+        struct GpsFixScratch
+        {
+            std::vector<int32_t> cno_tracked;
+            std::vector<int32_t> svid_in_sync;
+            std::vector<int32_t> ordering;
+        } gpsfix_scratch_;
+
+        //! Time the statistics of the message pools were last logged
+        boost::chrono::steady_clock::time_point last_pool_report_;
+
+        //! Monitors the rate and TOW continuity of the SBF blocks
+        StreamMonitor stream_monitor_;
+        //! StreamStatus messages
+        MessagePool<StreamStatusMsg> streamstatus_pool_;
+        //! Time the stream status was last reported
+        boost::chrono::steady_clock::time_point last_stream_report_;
+
+        /**
+         * @brief Checks the header of the SBF block at hand before its CRC
+         *
+         * The length must be a multiple of 4 within the bounds of SBF blocks, the ID
+         * one of the SBF reference guides and the revision plausible. This rejects
+         * most sync bytes arising from corruption or inside the payload of other
+         * blocks without waiting for the claimed length to arrive. A block the
+         * driver does not decode must also pass its CRC once complete.
+         * @return True if the header is plausible or not complete yet
+         */
+        bool plausibleSBF() const;
+
+        /**
+         * @brief Length of the plausible SBF block at hand if it is complete and
+         * the driver does not decode it, so that search() skips it as a whole
+         * @return Length of the block, 0 if it is to be handed on
+         */
+        std::size_t undecodedSBFLength() const;
+
+        /**
+         * @brief Checks the CRC of the SBF block at hand, once per block
+         * @return True if the CRC check passed
+         */
+        bool checkCrc();
+
+        /**
+         * @brief Publishes the stream status and logs any degradation once per
+         * second
+         * @param[in] now Current time
+         */
+        void reportStream(boost::chrono::steady_clock::time_point now);
+
+        /**
+         * @brief Logs the heap allocations and reuses of the message pools
+         * periodically
+         */
+        void reportPools();
+
         //! Shorthand for the map responsible for matching PVTGeodetic's Mode field
         //! to an enum value
         typedef std::unordered_map<uint16_t, TypeOfPVT_Enum> TypeOfPVTMap;
@@ -578,6 +788,13 @@ namespace io_comm_rx {
         //! Current leap seconds as received, do not use value is -128
         int8_t current_leap_seconds_ = -128;
 
+        //! Subscription generation of the node that needed_ was determined for
+        uint32_t demand_generation_ = std::numeric_limits<uint32_t>::max();
+
+        //! Whether a block or composite message, indexed by RxID_Enum, is consumed
+        //! by a subscribed output and hence has to be decoded
+        std::vector<bool> needed_;
+
         //! For GPSFix: Whether the ChannelStatus block of the current epoch has
         //! arrived or not
         bool channelstatus_has_arrived_gpsfix_ = false;
@@ -664,9 +881,10 @@ namespace io_comm_rx {
 
         /**
          * @brief "Callback" function when constructing GPSFix messages
-         * @return A smart pointer to the ROS message GPSFix just created
+         * @param[out] msg The ROS message GPSFix to be filled, reset except for the
+         * capacity of its satellite arrays
          */
-        GPSFixMsg GPSFixCallback();
+        void GPSFixCallback(GPSFixMsg& msg);
 
         /**
          * @brief "Callback" function when constructing PoseWithCovarianceStamped
@@ -692,6 +910,19 @@ namespace io_comm_rx {
          */
         ImuMsg ImuCallback();
 
+        /**
+         * @brief Appends an IMU sample to the pending batch and publishes the
+         * batch once it holds imu_batch/size samples
+         * @param[in] msg IMU sample
+         */
+        void batchImu(const ImuMsg& msg);
+
+        /**
+         * @brief Publishes the pending batch of IMU samples, which must not be
+         * empty
+         */
+        void publishImuBatch();
+
         /**
          * @brief "Callback" function when constructing
          * LocalizationUtmMsg messages
@@ -714,6 +945,19 @@ namespace io_comm_rx {
          */
         void wait(Timestamp time_obj);
 
+        /**
+         * @brief Determines which blocks and composite messages are needed by the
+         * outputs that currently have subscribers
+         */
+        void updateDemand();
+
+        /**
+         * @brief Whether an output is enabled and has subscribers
+         * @param[in] publish Whether the output is enabled
+         * @param[in] topic Topic of the output
+         */
+        bool wanted(bool publish, const std::string& topic) const;
+
         /**
          * @brief Wether all elements are true
          */
@@ -725,9 +969,15 @@ namespace io_comm_rx {
         Settings* settings_;
 
         /**
-         * @brief Fixed UTM zone
+         * @brief Handshake state of the Rx link
+         */
+        LinkState* link_;
+
+        /**
+         * @brief UTM projection of the localization, caching the current zone,
+         * which is fixed if lock_utm_zone is set
          */
-        std::shared_ptr<std::string> fixedUtmZone_;
+        parsing_utilities::UtmProjection utm_;
 
         /**
          * @brief Calculates the timestamp, in the Unix Epoch time format
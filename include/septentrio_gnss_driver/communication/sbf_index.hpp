@@ -0,0 +1,136 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <cstdint>
+#include <string>
+#include <vector>
+// ROSaic includes
+#include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+
+#ifndef SBF_INDEX_HPP
+#define SBF_INDEX_HPP
+
+/**
+ * @file sbf_index.hpp
+ * @date 16/10/26
+ * @brief Declares a class indexing the SBF blocks of a log by time, to seek in it
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @class SbfIndex
+     * @brief Time index of the SBF blocks of a log file
+     *
+     * The index is built by scanning the memory-mapped log in parallel, one chunk
+     * per thread, and cached next to the log with the extension ".idx". The cache
+     * is rebuilt if the size or modification time of the log changed.
+     */
+    class SbfIndex
+    {
+    public:
+        //! Index entry of one SBF block
+        struct Entry
+        {
+            //! Offset of the block in the log
+            uint64_t offset;
+            //! Time of week of the block in ms
+            uint32_t tow;
+            //! Week number of the block
+            uint16_t wnc;
+            //! ID of the block
+            uint16_t block_id;
+        };
+
+        /**
+         * @brief Constructor of the class SbfIndex
+         * @param[in] node Pointer to the node
+         */
+        explicit SbfIndex(ROSaicNodeBase* node);
+
+        /**
+         * @brief Loads the cached index of the log, or builds and caches it
+         * @param[in] file_name Path of the SBF log
+         * @return True if an index is available, false otherwise
+         */
+        bool load(const std::string& file_name);
+
+        /**
+         * @brief Gets the offset of the first block at or after a time
+         * @param[in] seconds Time in seconds since the first time-stamped block of
+         * the log
+         * @return Offset in the log, its size if no block is that late
+         */
+        uint64_t offsetAt(double seconds) const;
+
+        //! Returns all entries in file order
+        const std::vector<Entry>& entries() const { return entries_; }
+
+    private:
+        /**
+         * @brief Scans the log for SBF blocks in parallel
+         * @param[in] data The memory-mapped log
+         * @param[in] size Size of the log
+         */
+        void build(const uint8_t* data, uint64_t size);
+
+        /**
+         * @brief Scans for SBF blocks starting in [begin, end)
+         * @param[in] data The memory-mapped log
+         * @param[in] size Size of the log
+         * @param[in] begin First offset a block may start at
+         * @param[in] end Offset from which on no block may start
+         * @param[out] entries Entries of the blocks found
+         */
+        static void scan(const uint8_t* data, uint64_t size, uint64_t begin,
+                         uint64_t end, std::vector<Entry>& entries);
+
+        //! Reads the cache, returns false if missing or outdated
+        bool readCache(const std::string& cache_name, uint64_t size, int64_t mtime);
+        //! Writes the cache, returns false on error
+        bool writeCache(const std::string& cache_name, uint64_t size,
+                        int64_t mtime) const;
+
+        //! Returns the time of an entry in ms since the GPS epoch
+        static uint64_t gpsMs(const Entry& entry);
+
+        //! Pointer to the node
+        ROSaicNodeBase* node_;
+        //! Entries of all blocks in file order
+        std::vector<Entry> entries_;
+        //! Size of the indexed log
+        uint64_t file_size_;
+        //! Time of the first time-stamped block in ms since the GPS epoch
+        uint64_t first_ms_;
+    };
+} // namespace io_comm_rx
+
+#endif // for SBF_INDEX_HPP
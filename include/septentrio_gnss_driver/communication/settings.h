@@ -92,14 +92,36 @@ struct RtkSerial
     bool keep_open;
 };
 
+struct RtkRos
+{
+    //! Whether corrections received on the ROS topic "rtcm" are forwarded to the
+    //! main connection of the Rx
+    bool enabled = false;
+    //! RTCM version for correction data
+    std::string rtk_standard;
+};
+
 struct RtkSettings
 {
     std::vector<RtkNtrip> ntrip;
     std::vector<RtkIpServer> ip_server;
     std::vector<RtkSerial> serial;
+    RtkRos ros;
 };
 
 //! Settings struct
+struct ThreadSettings
+{
+    //! CPUs the thread is pinned to, empty for no pinning
+    std::vector<int> cpus;
+    //! Scheduling policy, either "other", "fifo" or "rr"
+    std::string policy = "other";
+    //! Real-time priority for the policies "fifo" and "rr"
+    int priority = 0;
+    //! Nice value for the policy "other"
+    int nice = 0;
+};
+
 struct Settings
 {
     //! Set logger level to DEBUG
@@ -192,8 +214,12 @@ struct Settings
     bool publish_gpgsa;
     //! Whether or not to publish the GSV message
     bool publish_gpgsv;
+    //! Whether or not to publish the satellites in view assembled from GSV
+    bool publish_satellites;
     //! Whether or not to publish the MeasEpoch message
     bool publish_measepoch;
+    //! Whether or not to publish the RawObservables message
+    bool publish_rawobservables;
     //! Whether or not to publish the PVTCartesianMsg
     //! message
     bool publish_pvtcartesian;
@@ -241,8 +267,16 @@ struct Settings
     bool publish_pose;
     //! Whether or not to publish the DiagnosticArrayMsg message
     bool publish_diagnostics;
+    //! Whether or not to publish the StreamStatusMsg message
+    bool publish_streamstatus;
     //! Whether or not to publish the ImuMsg message
     bool publish_imu;
+    //! Whether or not to publish the ImuBatchMsg message
+    bool publish_imubatch;
+    //! Number of IMU samples after which a batch is published
+    uint32_t imu_batch_size = 10;
+    //! Maximum delay of the first IMU sample of a batch in s
+    double imu_batch_max_delay = 0.05;
     //! Whether or not to publish the LocalizationMsg message
     bool publish_localization;
     //! Whether or not to publish the TwistWithCovarianceStampedMsg message
@@ -253,6 +287,9 @@ struct Settings
     bool insert_local_frame = false;
     //! Frame id of the local frame to be inserted
     std::string local_frame_id;
+    //! Longest time the transform of the local frame may lag behind or lead the
+    //! localization [s]
+    double local_frame_tolerance = 1.0;
     //! Septentrio receiver type, either "gnss" or "ins"
     std::string septentrio_receiver_type;
     //! Handle the case when an INS is used in GNSS mode
@@ -282,6 +319,14 @@ struct Settings
     bool read_from_sbf_log = false;
     //! Whether or not we are reading from a PCAP file
     bool read_from_pcap = false;
+    //! Whether replaying a file waits between epochs to reproduce their timing
+    bool replay_in_realtime = true;
+    //! Start of the replayed window of an SBF file in seconds since its first
+    //! epoch, 0 for its beginning
+    double replay_start = 0.0;
+    //! End of the replayed window of an SBF file in seconds since its first epoch,
+    //! 0 for its end
+    double replay_end = 0.0;
     //! VSM source for INS
     std::string ins_vsm_ros_source;
     //! Whether or not to use individual elements of 3D velocity (v_x, v_y, v_z)
@@ -290,6 +335,8 @@ struct Settings
     bool ins_vsm_ros_variances_by_parameter = false;
     //! Variances of the 3D velocity (var_x, var_y, var_z)
     std::vector<double> ins_vsm_ros_variances = {-1.0, -1.0, -1.0};
+    //! Maximum rate VSM input is forwarded at in Hz, 0 to forward every message
+    double ins_vsm_ros_max_rate = 0.0;
     //! VSM IP server id
     std::string ins_vsm_ip_server_id;
     //! VSM tcp port
@@ -302,4 +349,28 @@ struct Settings
     uint32_t ins_vsm_serial_baud_rate;
     //! Wether VSM shall be kept open om shutdown
     bool ins_vsm_serial_keep_open;
+    //! Directory the raw Rx stream is recorded to, empty to disable recording
+    std::string raw_recording_directory;
+    //! Maximum size of a raw recording file in MB, 0 for no limit
+    uint32_t raw_recording_max_file_size;
+    //! Maximum duration of a raw recording file in seconds, 0 for no limit
+    uint32_t raw_recording_max_file_duration;
+    //! Period between two syncs of the raw recording to disk in ms
+    uint32_t raw_recording_sync_period;
+    //! Whether the SBF streams of the Rx follow the subscribers of the outputs
+    bool demand_driven_output;
+    //! Time in ms no longer needed SBF blocks stay enabled before being turned off
+    uint32_t demand_driven_output_hold_time;
+    //! Whether reading, parsing and publishing run on the I/O thread alone
+    bool single_threaded = false;
+    //! Time in us the parsing thread spins for the next chunk before yielding
+    uint32_t parse_handoff_spin = 0;
+    //! Time in us the parsing thread yields for the next chunk before blocking
+    uint32_t parse_handoff_yield = 0;
+    //! Scheduling of the thread running the I/O of the Rx link
+    ThreadSettings thread_io;
+    //! Scheduling of the thread parsing the received messages
+    ThreadSettings thread_parse;
+    //! Scheduling of the thread watching for received messages
+    ThreadSettings thread_wait;
 };
\ No newline at end of file
@@ -0,0 +1,99 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// Boost includes
+#include <boost/asio.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+// C++ library includes
+#include <memory>
+// ROSaic includes
+#include <septentrio_gnss_driver/communication/settings.h>
+
+#ifndef SHARED_REACTOR_HPP
+#define SHARED_REACTOR_HPP
+
+/**
+ * @file shared_reactor.hpp
+ * @date 16/10/26
+ * @brief Declares an I/O reactor and a parsing pool that several Rx links share
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @class SharedReactor
+     * @brief Runs the asynchronous I/O of all Rx links handled by one process on a
+     * single thread and their parsing on a bounded pool of worker threads
+     *
+     * Parsing jobs of one link are serialized by a strand on parseService(), hence
+     * a link is never parsed concurrently with itself whereas distinct links are.
+     */
+    class SharedReactor
+    {
+    public:
+        /**
+         * @brief Constructor of the class SharedReactor, starts all threads
+         * @param[in] parse_threads Number of parsing worker threads, at least 1
+         * @param[in] io_thread Scheduling of the I/O thread
+         * @param[in] parse_thread Scheduling of each parsing worker thread
+         */
+        explicit SharedReactor(std::size_t parse_threads,
+                               const ThreadSettings& io_thread = ThreadSettings(),
+                               const ThreadSettings& parse_thread =
+                                   ThreadSettings());
+        /**
+         * @brief Destructor of the class SharedReactor, stops and joins all threads
+         */
+        ~SharedReactor();
+
+        //! Returns the io_service that handles the I/O of all Rx links
+        boost::shared_ptr<boost::asio::io_service> ioService() { return io_service_; }
+
+        //! Returns the io_service that runs the parsing jobs of all Rx links
+        boost::asio::io_service& parseService() { return *parse_service_; }
+
+    private:
+        //! io_context object for reading and writing
+        boost::shared_ptr<boost::asio::io_service> io_service_;
+        //! io_context object for parsing
+        boost::shared_ptr<boost::asio::io_service> parse_service_;
+        //! Keeps io_service_ running while no operation is pending
+        std::unique_ptr<boost::asio::io_service::work> io_work_;
+        //! Keeps parse_service_ running while no job is pending
+        std::unique_ptr<boost::asio::io_service::work> parse_work_;
+        //! Thread running io_service_
+        boost::thread io_thread_;
+        //! Threads running parse_service_
+        boost::thread_group parse_threads_;
+    };
+} // namespace io_comm_rx
+
+#endif // for SHARED_REACTOR_HPP
@@ -0,0 +1,172 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+// ROSaic includes
+#include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+
+#ifndef STREAM_MONITOR_HPP
+#define STREAM_MONITOR_HPP
+
+/**
+ * @file stream_monitor.hpp
+ * @date 16/10/26
+ * @brief Declares a monitor of the rate and TOW continuity of the SBF blocks
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @class StreamMonitor
+     * @brief Tracks the interval of every SBF block ID and counts missing epochs,
+     * late and out-of-order blocks, CRC-rejected frames and corrupted bytes
+     *
+     * The expected interval of a block ID is the one it was requested at, if set.
+     * Otherwise it is the smallest TOW step seen at least twice in a row, since
+     * the Rx outputs at multiples of it and a single jittery step must not turn
+     * all later ones into missing epochs. Gaps of blocks output on events or
+     * changes only are not counted. A block is late if, relative to its TOW, it
+     * arrives more than one interval later than the earliest block of its ID did,
+     * which reveals stalls between the Rx and the decoder. That reference slowly
+     * relaxes to follow the drift between the Rx and the host clock. Blocks are
+     * kept in a fixed table, so that observing a block does not allocate.
+     */
+    class StreamMonitor
+    {
+    public:
+        //! Number of block IDs tracked
+        static constexpr std::size_t MAX_BLOCKS = 64;
+
+        //! Constructor of the class StreamMonitor
+        StreamMonitor();
+
+        //! Sets whether to count late blocks, which needs blocks to arrive in real
+        //! time
+        void setCheckLate(bool check_late) { check_late_ = check_late; }
+
+        /**
+         * @brief Sets the interval a block ID is output at, instead of inferring it
+         * from the TOW steps
+         * @param[in] block_id ID of the block
+         * @param[in] interval_ms Output interval [ms], 0 if the block is output on
+         * events or changes only, whose gaps are then not counted
+         */
+        void setInterval(uint16_t block_id, uint32_t interval_ms);
+
+        /**
+         * @brief Records the arrival of an SBF block
+         * @param[in] block_id ID of the block
+         * @param[in] tow Time of week of the block [ms]
+         * @param[in] wnc Week number of the block
+         * @param[in] arrival_ms Arrival time on a monotonic clock [ms]
+         */
+        void observe(uint16_t block_id, uint32_t tow, uint16_t wnc,
+                     int64_t arrival_ms);
+
+        //! Records an SBF frame rejected by the CRC check
+        void crcError() { ++crc_errors_; }
+
+        //! Records SBF sync bytes rejected for an implausible header
+        void falseSync() { ++false_syncs_; }
+
+        //! Records bytes skipped while searching for the next message
+        void discarded(std::size_t bytes) { discarded_bytes_ += bytes; }
+
+        /**
+         * @brief Fills the status and starts a new report period
+         * @param[out] msg The status, its header is left untouched
+         * @return True if blocks went missing, arrived late or out of order or
+         * frames failed the CRC check since the last report
+         */
+        bool report(StreamStatusMsg& msg);
+
+        /**
+         * @brief Summary of the last report
+         * @return Number of missing, late and out-of-order blocks and CRC errors
+         * in the last report period
+         */
+        const std::array<uint32_t, 4>& lastDegradation() const
+        {
+            return last_degradation_;
+        }
+
+    private:
+        //! Statistics of one block ID
+        struct Block
+        {
+            //! ID of the block, 0 if the entry is unused
+            uint16_t id = 0;
+            //! Time of the last block in ms since the GPS epoch
+            uint64_t last_ms = 0;
+            //! Smallest arrival time relative to the TOW seen [ms]
+            int64_t min_offset_ms = 0;
+            //! Expected TOW step [ms], 0 if not known (yet)
+            uint32_t expected_ms = 0;
+            //! Whether expected_ms was set by setInterval()
+            bool fixed = false;
+            //! Last TOW step [ms]
+            uint64_t last_step_ms = 0;
+            //! Sum of the TOW steps since the last report [ms]
+            uint64_t step_sum_ms = 0;
+            //! Number of TOW steps since the last report
+            uint32_t steps = 0;
+            uint32_t received = 0;
+            uint32_t missing = 0;
+            uint32_t late = 0;
+            uint32_t out_of_order = 0;
+        };
+
+        //! Finds or adds the entry of a block ID, null if the table is full
+        Block* find(uint16_t block_id);
+
+        //! Whether to count late blocks
+        bool check_late_;
+        //! Table of the block IDs seen, in order of their first appearance
+        std::array<Block, MAX_BLOCKS> blocks_;
+        //! Number of used entries of blocks_
+        std::size_t size_;
+        //! Intervals set by setInterval() for blocks not seen yet [ms]
+        std::unordered_map<uint16_t, uint32_t> intervals_;
+        uint32_t crc_errors_;
+        uint32_t false_syncs_;
+        uint64_t discarded_bytes_;
+        uint32_t untracked_blocks_;
+        //! Sums of the missing, late, out-of-order and CRC counters at the last
+        //! report
+        std::array<uint32_t, 4> reported_;
+        //! Increase of these sums in the last report period
+        std::array<uint32_t, 4> last_degradation_;
+    };
+} // namespace io_comm_rx
+
+#endif // STREAM_MONITOR_HPP
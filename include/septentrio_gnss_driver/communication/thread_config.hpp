@@ -0,0 +1,76 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <string>
+// ROSaic includes
+#include <septentrio_gnss_driver/communication/settings.h>
+
+#ifndef THREAD_CONFIG_HPP
+#define THREAD_CONFIG_HPP
+
+/**
+ * @file thread_config.hpp
+ * @date 16/10/26
+ * @brief Declares the naming, pinning and scheduling of the driver's threads
+ */
+
+namespace io_comm_rx {
+
+    /**
+     * @brief Names the calling thread, pins it to its CPUs and sets its scheduling
+     * policy and priority or nice value
+     *
+     * Real-time policies and negative nice values require CAP_SYS_NICE (or a
+     * suitable RLIMIT_RTPRIO), otherwise they are not applied and the thread keeps
+     * running with the default scheduling.
+     * @param[in] name Name of the thread shown by profilers, at most 15 characters
+     * are kept
+     * @param[in] settings CPUs, policy, priority and nice value of the thread
+     * @return Description of what could not be applied, empty on success
+     */
+    std::string configureThread(const std::string& name,
+                                const ThreadSettings& settings);
+
+    /**
+     * @brief Hints the CPU that the calling thread is busy-waiting, which saves
+     * power and frees resources for its hyper-thread sibling
+     */
+    inline void cpuRelax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        asm volatile("yield" ::: "memory");
+#endif
+    }
+} // namespace io_comm_rx
+
+#endif // for THREAD_CONFIG_HPP
@@ -79,6 +79,16 @@
  * ROS parameters, ROS message publishing etc.
  */
 namespace rosaic_node {
+    /**
+     * @brief Gets the parameters threads/<thread>/... of one of the driver's
+     * threads, falling back to the default scheduling for invalid values
+     * @param[in] nh Node handle the parameters are read with
+     * @param[in] thread Name of the thread, i.e. io, parse or wait
+     * @param[out] settings CPUs, policy, priority and nice value of the thread
+     */
+    void getThreadParams(const ros::NodeHandle& nh, const std::string& thread,
+                         ThreadSettings& settings);
+
     /**
      * @class ROSaicNode
      * @brief This class represents the ROsaic node, to be extended..
@@ -91,7 +101,21 @@ namespace rosaic_node {
         //! messages, and publishes requested ROS messages...
         ROSaicNode();
 
+        /**
+         * @brief Constructor for one of several Rxs handled by the same process
+         * @param[in] receiver Name of the Rx, its parameters are read from and its
+         * messages published to the private sub-namespace of that name
+         * @param[in] reactor Reactor running the I/O and parsing of all Rxs
+         */
+        ROSaicNode(const std::string& receiver,
+                   boost::shared_ptr<io_comm_rx::SharedReactor> reactor);
+
     private:
+        /**
+         * @brief Loads the parameters, connects to the Rx and configures it
+         */
+        void setup();
+
         /**
          * @brief Gets the node parameters from the ROS Parameter Server, parts of
          * which are specified in a YAML file
@@ -125,13 +149,16 @@ namespace rosaic_node {
         void getRPY(const QuaternionMsg& qm, double& roll, double& pitch,
                     double& yaw);
 
-        void sendVelocity(const std::string& velNmea);
+        void sendVelocity(const char* velNmea, std::size_t size);
+
+        /**
+         * @brief Send RTCM corrections to communication layer
+         * @param[in] rtcm ROS message holding the corrections
+         */
+        void sendCorrections(const RtcmMsg::ConstPtr& rtcm);
 
         //! Handles communication with the Rx
         io_comm_rx::Comm_IO IO_;
-        //! tf2 buffer and listener
-        tf2_ros::Buffer tfBuffer_;
-        std::unique_ptr<tf2_ros::TransformListener> tfListener_;
     };
 } // namespace rosaic_node
 
@@ -0,0 +1,142 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#ifndef GSV_ASSEMBLER_HPP
+#define GSV_ASSEMBLER_HPP
+
+// C++ library includes
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+// ROSaic includes
+#include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+
+/**
+ * @file gsv_assembler.hpp
+ * @brief Declares an assembler of the multi-part GSV sentences of all
+ * constellations into one message per epoch
+ * @date 16/10/26
+ */
+
+namespace parsing_utilities {
+
+    /**
+     * @class GsvAssembler
+     * @brief Collects the GSV sentences of GPS, GLONASS, Galileo and BeiDou of an
+     * epoch into one SatellitesInView message
+     *
+     * GSV sentences carry no time, so an epoch ends when every constellation seen
+     * in the previous epoch has sent its last sentence, or else when a
+     * constellation already seen starts a new sequence. A sequence with a missing,
+     * repeated or out-of-order sentence, or with fewer satellites than announced,
+     * is rejected and its constellation left out of the epoch.
+     */
+    class GsvAssembler
+    {
+    public:
+        GsvAssembler();
+
+        /**
+         * @brief Gets the constellation of a GSV sentence from its ID
+         * @param[in] id Message ID, e.g. "$GLGSV"
+         * @param[out] constellation Constellation constant of SatellitesInView
+         * @return False if the talker is not a single supported constellation
+         */
+        static bool constellation(const std::string& id, uint8_t& constellation);
+
+        /**
+         * @brief Adds a parsed GSV sentence
+         * @param[in] constellation Constellation constant of SatellitesInView
+         * @param[in] part The parsed sentence
+         * @param[out] out The satellites of an epoch, all arrays overwritten, if
+         * this sentence ended one
+         * @return True if out holds an epoch with at least one complete
+         * constellation
+         */
+        bool add(uint8_t constellation, const GpgsvMsg& part,
+                 SatellitesInViewMsg& out);
+
+        //! Returns the number of sequences rejected so far
+        uint64_t rejected() const { return rejected_; }
+
+    private:
+        //! State of the sequence of GSV sentences of a constellation
+        enum class State
+        {
+            IDLE,
+            ASSEMBLING,
+            COMPLETE,
+            REJECTED
+        };
+
+        //! Sequence of GSV sentences of a constellation within the epoch
+        struct Sequence
+        {
+            State state = State::IDLE;
+            //! Number of sentences announced
+            uint8_t n_msgs = 0;
+            //! Number of satellites announced
+            uint8_t n_satellites = 0;
+            //! Number of the sentence expected next
+            uint8_t next = 1;
+            //! Satellites of the sentences so far
+            std::vector<GpgsvSatelliteMsg> satellites;
+        };
+
+        //! Number of constellations supported
+        static constexpr std::size_t CONSTELLATIONS = 4;
+
+        /**
+         * @brief Ends the epoch, rejecting sequences still being assembled
+         * @param[out] out The complete sequences of the epoch
+         * @return True if there was any complete sequence
+         */
+        bool endEpoch(SatellitesInViewMsg& out);
+
+        //! Rejects the sequence of a constellation
+        void reject(Sequence& sequence);
+
+        //! Sequences of the epoch by constellation
+        std::array<Sequence, CONSTELLATIONS> sequences_;
+        //! Header of the first sentence of the epoch
+        std_msgs::Header header_;
+        //! Bit mask of the constellations seen in the epoch
+        uint8_t seen_;
+        //! Bit mask of the constellations whose sequence ended in the epoch
+        uint8_t ended_;
+        //! Bit mask of the constellations seen in the previous epoch
+        uint8_t expected_;
+        //! Number of sequences rejected
+        uint64_t rejected_;
+    };
+} // namespace parsing_utilities
+
+#endif // GSV_ASSEMBLER_HPP
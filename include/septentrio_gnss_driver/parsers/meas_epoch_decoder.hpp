@@ -0,0 +1,109 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#ifndef MEAS_EPOCH_DECODER_HPP
+#define MEAS_EPOCH_DECODER_HPP
+
+// C++ library includes
+#include <cstdint>
+#include <vector>
+// ROSaic includes
+#include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+
+/**
+ * @file meas_epoch_decoder.hpp
+ * @brief Declares a decoder of MeasEpoch blocks into observables in SI units
+ * @date 16/10/26
+ */
+
+namespace parsing_utilities {
+
+    /**
+     * @class MeasEpochDecoder
+     * @brief Converts the packed fields of a MeasEpoch block into pseudorange,
+     * carrier phase, Doppler, C/N0 and lock time of every signal
+     *
+     * Decoding takes two passes. The first walks the sub-blocks and gathers the raw
+     * fields of all signals, type2 sub-blocks inheriting the reference values of
+     * their type1 sub-block, into contiguous arrays. The second converts these
+     * arrays with branch-free loops the compiler can vectorize across channels.
+     * The arrays are members, so that their capacity is reused from epoch to
+     * epoch.
+     */
+    class MeasEpochDecoder
+    {
+    public:
+        /**
+         * @brief Decodes an epoch
+         * @param[in] in The parsed MeasEpoch block
+         * @param[out] out The observables, all arrays overwritten
+         */
+        void decode(const MeasEpochMsg& in, RawObservablesMsg& out);
+
+        /**
+         * @brief Carrier frequency of a signal
+         * @param[in] signal SBF signal number
+         * @param[in] glonass_fn GLONASS frequency number, for FDMA signals only
+         * @return Frequency [Hz], 0 if unknown
+         */
+        static double frequency(uint8_t signal, int8_t glonass_fn);
+
+    private:
+        //! Resizes the arrays to size signals
+        void resize(std::size_t size);
+
+        //! Pseudorange of the type1 signal [mm]
+        std::vector<double> code_ref_;
+        //! Code offset of a type2 signal to its type1 signal [mm]
+        std::vector<double> code_offset_;
+        //! Whether the pseudorange is available, 1.0 or NaN
+        std::vector<double> code_valid_;
+        //! Carrier phase relative to pseudorange [mcycles]
+        std::vector<double> carrier_;
+        //! Whether the carrier phase is available, 1.0 or NaN
+        std::vector<double> carrier_valid_;
+        //! Wavelength [m], NaN if unknown
+        std::vector<double> wavelength_;
+        //! Doppler of the type1 signal [0.1 mHz]
+        std::vector<double> doppler_ref_;
+        //! Frequency ratio of a type2 signal to its type1 signal
+        std::vector<double> doppler_ratio_;
+        //! Doppler offset of a type2 signal to the scaled type1 Doppler [0.1 mHz]
+        std::vector<double> doppler_offset_;
+        //! Whether the Doppler is available, 1.0 or NaN
+        std::vector<double> doppler_valid_;
+        //! Raw C/N0 [0.25 dB-Hz]
+        std::vector<float> cn0_raw_;
+        //! C/N0 offset of the signal type [dB-Hz], NaN if not available
+        std::vector<float> cn0_offset_;
+    };
+} // namespace parsing_utilities
+
+#endif // MEAS_EPOCH_DECODER_HPP
@@ -0,0 +1,111 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#ifndef NMEA_FORMATTER_HPP
+#define NMEA_FORMATTER_HPP
+
+// C++ library includes
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file nmea_formatter.hpp
+ * @brief Declares a formatter of NMEA sentences working on a fixed buffer
+ * @date 16/10/26
+ */
+
+namespace string_utilities {
+
+    /**
+     * @class NmeaFormatter
+     * @brief Formats an NMEA sentence field by field into a fixed buffer, without
+     * any allocation
+     *
+     * A sentence is started with begin(), filled with the append functions and
+     * closed by finish(), which appends the checksum and "\r\n". The buffer is
+     * reused by the next sentence. If a field does not fit or cannot be
+     * formatted, the sentence is marked as failed and finish() returns false.
+     */
+    class NmeaFormatter
+    {
+    public:
+        //! Capacity of the buffer, ample for the 82 characters allowed by NMEA
+        static const std::size_t CAPACITY = 128;
+
+        NmeaFormatter();
+
+        /**
+         * @brief Starts a new sentence
+         * @param[in] address Address field including the leading '$', e.g.
+         * "$PSSN,VSM"
+         */
+        void begin(const char* address);
+
+        /**
+         * @brief Appends the UTC time of day as hhmmss.sss
+         * @param[in] stamp Time in nanoseconds since the Unix epoch
+         */
+        void appendTime(uint64_t stamp);
+
+        /**
+         * @brief Appends a value rounded to three decimal places
+         * @param[in] value The value, has to be finite
+         */
+        void appendFixed3(double value);
+
+        //! Appends an empty field
+        void appendEmpty();
+
+        /**
+         * @brief Appends the checksum and the line ending
+         * @return Whether the sentence is complete and valid
+         */
+        bool finish();
+
+        //! The sentence, not null-terminated
+        const char* data() const { return buffer_; }
+
+        //! Number of characters of the sentence
+        std::size_t size() const { return size_; }
+
+    private:
+        //! Reserves space for a field including its leading ',', nullptr if full
+        char* field(std::size_t max_length);
+
+        //! Characters of the sentence
+        char buffer_[CAPACITY];
+        //! Number of characters written
+        std::size_t size_;
+        //! Whether a field could not be formatted
+        bool failed_;
+    };
+} // namespace string_utilities
+
+#endif // NMEA_FORMATTER_HPP
@@ -356,6 +356,15 @@ namespace parsing_utilities {
      * @return SBF GPS week counter
      */
     uint16_t getWnc(const uint8_t* buffer);
+
+    /**
+     * @brief Whether a block number is one the SBF reference guides of current
+     * firmware define, whether the driver decodes it or not
+     *
+     * @param[in] id SBF block number, without revision
+     * @return Whether the block number is known
+     */
+    bool isSbfBlockNumber(uint16_t id);
 } // namespace parsing_utilities
 
 #endif // PARSING_UTILITIES_HPP
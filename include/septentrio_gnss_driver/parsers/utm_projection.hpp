@@ -0,0 +1,118 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#ifndef UTM_PROJECTION_HPP
+#define UTM_PROJECTION_HPP
+
+// C++ library includes
+#include <string>
+
+/**
+ * @file utm_projection.hpp
+ * @brief Declares a UTM projection caching the state of the current zone
+ * @date 16/10/26
+ */
+
+namespace parsing_utilities {
+
+    /**
+     * @class UtmProjection
+     * @brief Projects WGS84 coordinates to UTM with the 6th order Krüger series also
+     * used by GeographicLib, accurate to a few nanometers within the zone
+     *
+     * The series coefficients are computed once and the central meridian, false
+     * northing and frame ID of the current zone are cached. GeographicLib is only
+     * consulted when the position leaves the zone, near the Norway and Svalbard
+     * exceptions and for UPS.
+     */
+    class UtmProjection
+    {
+    public:
+        UtmProjection();
+
+        /**
+         * @brief Projects a position to the current zone, which is updated to the
+         * standard zone of the position unless it is locked
+         * @param[in] lat Latitude in degrees
+         * @param[in] lon Longitude in degrees
+         * @param[out] easting Easting in meters
+         * @param[out] northing Northing in meters
+         * @param[out] gamma Meridian convergence in degrees
+         */
+        void forward(double lat, double lon, double& easting, double& northing,
+                     double& gamma);
+
+        /**
+         * @brief Keeps the current zone for all following positions
+         */
+        void lockZone() { locked_ = (zone_ >= 0); }
+
+        //! Current zone, e.g. "32n"
+        const std::string& zone() const { return zone_string_; }
+
+        //! Frame ID of the current zone, e.g. "utm_32n"
+        const std::string& frameId() const { return frame_id_; }
+
+    private:
+        //! Whether the position lies in the standard UTM zone zone_, outside of the
+        //! Norway and Svalbard exceptions
+        bool inZone(double lat, double lon) const;
+
+        //! Sets up the cached state of a zone
+        void setZone(int zone, bool northp);
+
+        //! Order of the Krüger series
+        static const int ORDER = 6;
+
+        //! Eccentricity of the ellipsoid
+        double e_;
+        //! Scale on the central meridian times rectifying radius
+        double k0A_;
+        //! Coefficients of the Krüger series
+        double alpha_[ORDER + 1];
+
+        //! Current zone, 0 for UPS, -1 if none yet
+        int zone_;
+        //! Whether the current zone is on the northern hemisphere
+        bool northp_;
+        //! Whether the zone is locked
+        bool locked_;
+        //! Central meridian of the current zone in degrees
+        double lon0_;
+        //! False northing of the current zone in meters
+        double false_northing_;
+        //! Zone string of the current zone
+        std::string zone_string_;
+        //! Frame ID of the current zone
+        std::string frame_id_;
+    };
+} // namespace parsing_utilities
+
+#endif // UTM_PROJECTION_HPP
@@ -57,8 +57,6 @@ std::pair<std::string, uint32_t> imu_pairs[] = {std::make_pair("4226", 0),
 std::pair<std::string, uint32_t> localization_pairs[] = {std::make_pair("4226", 0)};
 
 namespace io_comm_rx {
-    boost::mutex CallbackHandlers::callback_mutex_;
-
     CallbackHandlers::GPSFixMap CallbackHandlers::gpsfix_map(gpsfix_pairs,
                                                              gpsfix_pairs + 9);
     CallbackHandlers::NavSatFixMap
@@ -74,17 +72,6 @@ namespace io_comm_rx {
         CallbackHandlers::localization_map(localization_pairs,
                                            localization_pairs + 1);
 
-    std::string CallbackHandlers::do_gpsfix_ = "4007";
-    std::string CallbackHandlers::do_navsatfix_ = "4007";
-    std::string CallbackHandlers::do_pose_ = "4007";
-    std::string CallbackHandlers::do_diagnostics_ = "4014";
-
-    std::string CallbackHandlers::do_insgpsfix_ = "4226";
-    std::string CallbackHandlers::do_insnavsatfix_ = "4226";
-    std::string CallbackHandlers::do_inspose_ = "4226";
-    std::string CallbackHandlers::do_imu_ = "4226";
-    std::string CallbackHandlers::do_inslocalization_ = "4226";
-
     //! The for loop forwards to a ROS message specific handle if the latter was
     //! added via callbackmap_.insert at some earlier point.
     void CallbackHandlers::handle()
@@ -492,6 +479,7 @@ namespace io_comm_rx {
                     throw(
                         static_cast<std::size_t>(rx_message_.getPosBuffer() - data));
                 }
+                rx_message_.monitorStream();
                 if (settings_->septentrio_receiver_type == "gnss")
                 {
                     if (settings_->publish_gpsfix == true &&
@@ -610,10 +598,10 @@ namespace io_comm_rx {
                                                 " bytes and reads:\n " +
                                                 block_in_string);
                 {
-                    boost::mutex::scoped_lock lock(g_response_mutex);
-                    g_response_received = true;
+                    boost::mutex::scoped_lock lock(link_->response_mutex);
+                    link_->response_received = true;
                     lock.unlock();
-                    g_response_condition.notify_one();
+                    link_->response_condition.notify_one();
                 }
                 if (rx_message_.isErrorMessage())
                 {
@@ -629,21 +617,21 @@ namespace io_comm_rx {
             {
                 std::string cd(
                     reinterpret_cast<const char*>(rx_message_.getPosBuffer()), 4);
-                g_rx_tcp_port = cd;
-                if (g_cd_count == 0)
+                link_->rx_tcp_port = cd;
+                if (link_->cd_count == 0)
                 {
                     node_->log(
                         LogLevel::INFO,
                         "The connection descriptor for the TCP connection is " + cd);
                 }
-                if (g_cd_count < 3)
-                    ++g_cd_count;
-                if (g_cd_count == 2)
+                if (link_->cd_count < 3)
+                    ++link_->cd_count;
+                if (link_->cd_count == 2)
                 {
-                    boost::mutex::scoped_lock lock(g_cd_mutex);
-                    g_cd_received = true;
+                    boost::mutex::scoped_lock lock(link_->cd_mutex);
+                    link_->cd_received = true;
                     lock.unlock();
-                    g_cd_condition.notify_one();
+                    link_->cd_condition.notify_one();
                 }
                 continue;
             }
@@ -0,0 +1,230 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C library includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+// C++ library includes
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+// ROSaic includes
+#include <septentrio_gnss_driver/communication/column_file.hpp>
+
+/**
+ * @file column_file.cpp
+ * @date 16/10/26
+ * @brief Defines writers and a memory-mapped reader of column files
+ */
+
+#if !defined(__BYTE_ORDER__) || (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+#error "Column files are written and read in host byte order, little-endian"
+#endif
+
+namespace {
+    //! Starts every column file
+    const char MAGIC[] = "SBFCOL1\n";
+    const std::size_t MAGIC_SIZE = sizeof(MAGIC) - 1;
+
+    //! Gets the string value of a key of the schema, empty if missing
+    std::string jsonString(const std::string& schema, const std::string& key)
+    {
+        std::string pattern = "\"" + key + "\":\"";
+        std::size_t begin = schema.find(pattern);
+        if (begin == std::string::npos)
+            return std::string();
+        begin += pattern.size();
+        std::size_t end = schema.find('"', begin);
+        if (end == std::string::npos)
+            return std::string();
+        return schema.substr(begin, end - begin);
+    }
+
+    //! Gets the unsigned value of a key of the schema, false if missing
+    bool jsonNumber(const std::string& schema, const std::string& key,
+                    uint64_t& value)
+    {
+        std::string pattern = "\"" + key + "\":";
+        std::size_t begin = schema.find(pattern);
+        if (begin == std::string::npos)
+            return false;
+        const char* digits = schema.c_str() + begin + pattern.size();
+        char* end;
+        value = std::strtoull(digits, &end, 10);
+        return end != digits;
+    }
+
+    //! Gets the size in bytes of a value of a type, 0 if unknown
+    std::size_t typeWidth(const std::string& type)
+    {
+        if ((type == "u8") || (type == "i8"))
+            return 1;
+        if ((type == "u16") || (type == "i16"))
+            return 2;
+        if ((type == "u32") || (type == "i32") || (type == "f32"))
+            return 4;
+        if ((type == "u64") || (type == "f64"))
+            return 8;
+        return 0;
+    }
+
+    //! Creates a directory, returns false unless it exists afterwards
+    bool makeDirectory(const std::string& path)
+    {
+        return (::mkdir(path.c_str(), 0755) == 0) || (errno == EEXIST);
+    }
+} // namespace
+
+namespace io_comm_rx {
+
+    std::string columnPath(const std::string& directory, const std::string& table,
+                           const std::string& column)
+    {
+        return directory + "/" + table + "/" + column + ".col";
+    }
+
+    ColumnFileWriter::ColumnFileWriter(const std::string& directory,
+                                       const std::string& table,
+                                       const std::string& column,
+                                       const std::string& type, std::size_t width,
+                                       const std::string& unit,
+                                       const std::string& offsets_of) :
+        path_(columnPath(directory, table, column)),
+        table_(table), column_(column), type_(type), width_(width), unit_(unit),
+        offsets_of_(offsets_of), file_(nullptr), count_(0), good_(false)
+    {
+        if (!makeDirectory(directory) || !makeDirectory(directory + "/" + table))
+            return;
+        file_ = std::fopen(path_.c_str(), "wb");
+        if (!file_)
+            return;
+        // The header is written with its final count on close
+        std::vector<char> header(COLUMN_HEADER_SIZE, ' ');
+        good_ = std::fwrite(header.data(), 1, header.size(), file_) ==
+                header.size();
+        buffer_.reserve(BUFFER_SIZE + width_);
+    }
+
+    ColumnFileWriter::~ColumnFileWriter() { close(); }
+
+    void ColumnFileWriter::flush()
+    {
+        if (file_ && !buffer_.empty())
+            good_ &= std::fwrite(buffer_.data(), 1, buffer_.size(), file_) ==
+                     buffer_.size();
+        buffer_.clear();
+    }
+
+    bool ColumnFileWriter::close()
+    {
+        if (!file_)
+            return good_;
+        flush();
+
+        std::string schema = "{\"table\":\"" + table_ + "\",\"column\":\"" +
+                             column_ + "\",\"type\":\"" + type_ +
+                             "\",\"count\":" + std::to_string(count_);
+        if (!unit_.empty())
+            schema += ",\"unit\":\"" + unit_ + "\"";
+        if (!offsets_of_.empty())
+            schema += ",\"offsets_of\":\"" + offsets_of_ + "\"";
+        schema += "}";
+        std::string header(MAGIC, MAGIC_SIZE);
+        header += schema;
+        if (header.size() + 1 > COLUMN_HEADER_SIZE)
+        {
+            good_ = false;
+        } else
+        {
+            header.resize(COLUMN_HEADER_SIZE - 1, ' ');
+            header += '\n';
+            good_ &= (std::fseek(file_, 0, SEEK_SET) == 0) &&
+                     (std::fwrite(header.data(), 1, header.size(), file_) ==
+                      header.size());
+        }
+        good_ &= std::fclose(file_) == 0;
+        file_ = nullptr;
+        return good_;
+    }
+
+    ColumnReader::ColumnReader() : data_(nullptr), mapped_size_(0), count_(0) {}
+
+    ColumnReader::~ColumnReader() { close(); }
+
+    void ColumnReader::close()
+    {
+        if (data_)
+            ::munmap(const_cast<uint8_t*>(data_), mapped_size_);
+        data_ = nullptr;
+        mapped_size_ = 0;
+        count_ = 0;
+    }
+
+    bool ColumnReader::open(const std::string& path)
+    {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat file_stat;
+        if ((::fstat(fd, &file_stat) != 0) ||
+            (static_cast<std::size_t>(file_stat.st_size) < COLUMN_HEADER_SIZE))
+        {
+            ::close(fd);
+            return false;
+        }
+        std::size_t size = static_cast<std::size_t>(file_stat.st_size);
+        void* data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED)
+            return false;
+        data_ = static_cast<const uint8_t*>(data);
+        mapped_size_ = size;
+
+        const char* header = reinterpret_cast<const char*>(data_);
+        std::string schema(header + MAGIC_SIZE, COLUMN_HEADER_SIZE - MAGIC_SIZE);
+        table_ = jsonString(schema, "table");
+        column_ = jsonString(schema, "column");
+        type_ = jsonString(schema, "type");
+        unit_ = jsonString(schema, "unit");
+        offsets_of_ = jsonString(schema, "offsets_of");
+        std::size_t width = typeWidth(type_);
+        if ((std::memcmp(header, MAGIC, MAGIC_SIZE) != 0) ||
+            !jsonNumber(schema, "count", count_) || (width == 0) ||
+            ((size - COLUMN_HEADER_SIZE) / width < count_))
+        {
+            close();
+            return false;
+        }
+        return true;
+    }
+} // namespace io_comm_rx
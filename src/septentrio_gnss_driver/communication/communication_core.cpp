@@ -28,13 +28,17 @@
 //
 // *****************************************************************************
 
+#include <algorithm>
 #include <chrono>
+#include <limits>
 #include <linux/serial.h>
 
 // Boost includes
+#include <boost/chrono.hpp>
 #include <boost/regex.hpp>
 #include <septentrio_gnss_driver/communication/communication_core.hpp>
 #include <septentrio_gnss_driver/communication/pcap_reader.hpp>
+#include <septentrio_gnss_driver/communication/sbf_index.hpp>
 
 #ifndef ANGLE_MAX
 #define ANGLE_MAX 180
@@ -98,38 +102,26 @@
  * @brief Highest-Level view on communication services
  */
 
-//! Mutex to control changes of global variable "g_response_received"
-boost::mutex g_response_mutex;
-//! Determines whether a command reply was received from the Rx
-bool g_response_received;
-//! Condition variable complementing "g_response_mutex"
-boost::condition_variable g_response_condition;
-//! Mutex to control changes of global variable "g_cd_received"
-boost::mutex g_cd_mutex;
-//! Determines whether the connection descriptor was received from the Rx
-bool g_cd_received;
-//! Condition variable complementing "g_cd_mutex"
-boost::condition_variable g_cd_condition;
-//! Whether or not we still want to read the connection descriptor, which we only
-//! want in the very beginning to know whether it is IP10, IP11 etc.
-bool g_read_cd;
-//! Rx TCP port, e.g. IP10 or IP11, to which ROSaic is connected to
-std::string g_rx_tcp_port;
-//! Since after SSSSSSSSSSS we need to wait for second connection descriptor, we have
-//! to count the connection descriptors
-uint32_t g_cd_count;
-
-io_comm_rx::Comm_IO::Comm_IO(ROSaicNodeBase* node, Settings* settings) :
-    node_(node), handlers_(node, settings), settings_(settings), stopping_(false)
+io_comm_rx::Comm_IO::Comm_IO(ROSaicNodeBase* node, Settings* settings,
+                             boost::shared_ptr<SharedReactor> reactor) :
+    node_(node),
+    handlers_(node, settings, &link_), settings_(settings), reactor_(reactor),
+    stopping_(false)
 {
-    g_response_received = false;
-    g_cd_received = false;
-    g_read_cd = true;
-    g_cd_count = 0;
 }
 
 io_comm_rx::Comm_IO::~Comm_IO()
 {
+    if (demandThread_)
+    {
+        demandThread_->interrupt();
+        demandThread_->join();
+    }
+    if (batchThread_)
+    {
+        batchThread_->interrupt();
+        batchThread_->join();
+    }
     if (!settings_->read_from_sbf_log && !settings_->read_from_pcap)
     {
         std::string cmd("\x0DSSSSSSSSSSSSSSSSSSS\x0D\x0D");
@@ -185,22 +177,27 @@ io_comm_rx::Comm_IO::~Comm_IO()
     }
 
     stopping_ = true;
-    connectionThread_->join();
+    if (connectionThread_)
+        connectionThread_->join();
+    // Nothing is parsed once the link is closed, hence the samples still waiting
+    // for their batch can go out
+    manager_.reset();
+    handlers_.flushImuBatch(false);
 }
 
 void io_comm_rx::Comm_IO::resetMainPort()
 {
-    // It is imperative to hold a lock on the mutex  "g_cd_mutex" while
-    // modifying the variable and "g_cd_received".
-    boost::mutex::scoped_lock lock_cd(g_cd_mutex);
+    // It is imperative to hold a lock on the mutex  "cd_mutex" while
+    // modifying the variable and "cd_received".
+    boost::mutex::scoped_lock lock_cd(link_.cd_mutex);
     // Escape sequence (escape from correction mode), ensuring that we can send
     // our real commands afterwards...
     std::string cmd("\x0DSSSSSSSSSSSSSSSSSSS\x0D\x0D");
     manager_.get()->send(cmd);
     // We wait for the connection descriptor before we send another command,
     // otherwise the latter would not be processed.
-    g_cd_condition.wait(lock_cd, []() { return g_cd_received; });
-    g_cd_received = false;
+    link_.cd_condition.wait(lock_cd, [this]() { return link_.cd_received; });
+    link_.cd_received = false;
 }
 
 void io_comm_rx::Comm_IO::initializeIO()
@@ -262,6 +259,9 @@ void io_comm_rx::Comm_IO::initializeIO()
         ss << "Device is unsupported. Perhaps you meant 'tcp://host:port' or 'file_name:xxx.sbf' or 'serial:/path/to/device'?";
         node_->log(LogLevel::ERROR, ss.str());
     }
+    if (settings_->publish_imubatch)
+        batchThread_.reset(
+            new boost::thread(boost::bind(&Comm_IO::flushImuBatches, this)));
     node_->log(LogLevel::DEBUG, "Leaving initializeIO() method");
 }
 
@@ -404,7 +404,7 @@ void io_comm_rx::Comm_IO::configureRx()
     resetMainPort();
     if (proto == "tcp")
     {
-        mainPort_ = g_rx_tcp_port;
+        mainPort_ = link_.rx_tcp_port;
     } else
     {
         mainPort_ = settings_->rx_serial_port;
@@ -417,9 +417,6 @@ void io_comm_rx::Comm_IO::configureRx()
     std::string pvt_interval = parsing_utilities::convertUserPeriodToRxCommand(
         settings_->polling_period_pvt);
 
-    std::string rest_interval = parsing_utilities::convertUserPeriodToRxCommand(
-        settings_->polling_period_rest);
-
     // Credentials for login
     if (!settings_->login_user.empty() && !settings_->login_password.empty())
     {
@@ -451,140 +448,26 @@ void io_comm_rx::Comm_IO::configureRx()
         send(ss.str());
     }
 
-    // Setting up SBF blocks with rx_period_pvt
+    // Changing the output at runtime needs the main port to accept commands, which
+    // it does not once it takes VSM or corrections input from ROS
+    bool input_from_ros =
+        settings_->rtk_settings.ros.enabled ||
+        ((settings_->septentrio_receiver_type == "ins") &&
+         ((settings_->ins_vsm_ros_source == "odometry") ||
+          (settings_->ins_vsm_ros_source == "twist")));
+    if (settings_->demand_driven_output && input_from_ros)
     {
-        std::stringstream blocks;
-        if (settings_->use_gnss_time)
-        {
-            blocks << " +ReceiverTime";
-        }
-        if (settings_->publish_pvtcartesian)
-        {
-            blocks << " +PVTCartesian";
-        }
-        if (settings_->publish_pvtgeodetic || settings_->publish_twist ||
-            (settings_->publish_navsatfix &&
-             (settings_->septentrio_receiver_type == "gnss")) ||
-            (settings_->publish_gpsfix &&
-             (settings_->septentrio_receiver_type == "gnss")) ||
-            (settings_->publish_pose &&
-             (settings_->septentrio_receiver_type == "gnss")))
-        {
-            blocks << " +PVTGeodetic";
-        }
-        if (settings_->publish_basevectorcart)
-        {
-            blocks << " +BaseVectorCart";
-        }
-        if (settings_->publish_basevectorgeod)
-        {
-            blocks << " +BaseVectorGeod";
-        }
-        if (settings_->publish_poscovcartesian)
-        {
-            blocks << " +PosCovCartesian";
-        }
-        if (settings_->publish_poscovgeodetic ||
-            (settings_->publish_navsatfix &&
-             (settings_->septentrio_receiver_type == "gnss")) ||
-            (settings_->publish_gpsfix &&
-             (settings_->septentrio_receiver_type == "gnss")) ||
-            (settings_->publish_pose &&
-             (settings_->septentrio_receiver_type == "gnss")))
-        {
-            blocks << " +PosCovGeodetic";
-        }
-        if (settings_->publish_velcovgeodetic || settings_->publish_twist ||
-            (settings_->publish_gpsfix &&
-             (settings_->septentrio_receiver_type == "gnss")))
-        {
-            blocks << " +VelCovGeodetic";
-        }
-        if (settings_->publish_atteuler ||
-            (settings_->publish_gpsfix &&
-             (settings_->septentrio_receiver_type == "gnss")) ||
-            (settings_->publish_pose &&
-             (settings_->septentrio_receiver_type == "gnss")))
-        {
-            blocks << " +AttEuler";
-        }
-        if (settings_->publish_attcoveuler ||
-            (settings_->publish_gpsfix &&
-             (settings_->septentrio_receiver_type == "gnss")) ||
-            (settings_->publish_pose &&
-             (settings_->septentrio_receiver_type == "gnss")))
-        {
-            blocks << " +AttCovEuler";
-        }
-        if (settings_->publish_measepoch || settings_->publish_gpsfix)
-        {
-            blocks << " +MeasEpoch";
-        }
-        if (settings_->publish_gpsfix)
-        {
-            blocks << " +ChannelStatus +DOP";
-        }
-        // Setting SBF output of Rx depending on the receiver type
-        // If INS then...
-        if (settings_->septentrio_receiver_type == "ins")
-        {
-            if (settings_->publish_insnavcart)
-            {
-                blocks << " +INSNavCart";
-            }
-            if (settings_->publish_insnavgeod || settings_->publish_navsatfix ||
-                settings_->publish_gpsfix || settings_->publish_pose ||
-                settings_->publish_imu || settings_->publish_localization ||
-                settings_->publish_tf || settings_->publish_twist)
-            {
-                blocks << " +INSNavGeod";
-            }
-            if (settings_->publish_exteventinsnavgeod)
-            {
-                blocks << " +ExtEventINSNavGeod";
-            }
-            if (settings_->publish_exteventinsnavcart)
-            {
-                blocks << " +ExtEventINSNavCart";
-            }
-            if (settings_->publish_extsensormeas || settings_->publish_imu)
-            {
-                blocks << " +ExtSensorMeas";
-            }
-        }
-        std::stringstream ss;
-        ss << "sso, Stream" << std::to_string(stream) << ", " << mainPort_ << ","
-           << blocks.str() << ", " << pvt_interval << "\x0D";
-        send(ss.str());
-        ++stream;
+        node_->log(
+            LogLevel::WARN,
+            "Demand-driven output is disabled since the main connection takes VSM or corrections input from ROS and then accepts no commands. All enabled outputs are requested.");
+        settings_->demand_driven_output = false;
     }
-    // Setting up SBF blocks with rx_period_rest
-    {
-        std::stringstream blocks;
-        if (settings_->septentrio_receiver_type == "ins")
-        {
-            if (settings_->publish_imusetup)
-            {
-                blocks << " +IMUSetup";
-            }
-            if (settings_->publish_velsensorsetup)
-            {
-                blocks << " +VelSensorSetup";
-            }
-        }
-        if (settings_->publish_diagnostics)
-        {
-            blocks << " +ReceiverStatus +QualityInd";
-        }
 
-        blocks << " +ReceiverSetup";
-
-        std::stringstream ss;
-        ss << "sso, Stream" << std::to_string(stream) << ", " << mainPort_ << ","
-           << blocks.str() << ", " << rest_interval << "\x0D";
-        send(ss.str());
-        ++stream;
-    }
+    // Setting up SBF blocks with rx_period_pvt and rx_period_rest
+    active_pvt_blocks_ = pvtBlocks();
+    active_rest_blocks_ = restBlocks();
+    sendSbfStreams(active_pvt_blocks_, active_rest_blocks_);
+    stream += 2;
 
     // Setting up NMEA streams
     {
@@ -603,7 +486,7 @@ void io_comm_rx::Comm_IO::configureRx()
         {
             blocks << " +GSA";
         }
-        if (settings_->publish_gpgsv)
+        if (settings_->publish_gpgsv || settings_->publish_satellites)
         {
             blocks << " +GSV";
         }
@@ -974,9 +857,303 @@ void io_comm_rx::Comm_IO::configureRx()
             nmeaActivated_ = true;
         }
     }
+
+    if (settings_->rtk_settings.ros.enabled)
+    {
+        if (nmeaActivated_)
+        {
+            node_->log(
+                LogLevel::ERROR,
+                "The main connection already takes VSM input from ROS, corrections from ROS will not be forwarded.");
+        } else
+        {
+            send("sdio, " + mainPort_ + ", " +
+                 settings_->rtk_settings.ros.rtk_standard + ", +NMEA +SBF\x0D");
+            correctionsActivated_ = true;
+        }
+    }
+
+    if (settings_->demand_driven_output)
+        demandThread_.reset(
+            new boost::thread(boost::bind(&Comm_IO::followDemand, this)));
     node_->log(LogLevel::DEBUG, "Leaving configureRx() method");
 }
 
+void io_comm_rx::Comm_IO::flushImuBatches()
+{
+    boost::chrono::microseconds period(std::max<int64_t>(
+        1000, static_cast<int64_t>(settings_->imu_batch_max_delay * 1e6) / 2));
+    while (!stopping_)
+    {
+        try
+        {
+            boost::this_thread::sleep_for(period);
+        } catch (boost::thread_interrupted&)
+        {
+            return;
+        }
+        handlers_.flushImuBatch(true);
+    }
+}
+
+bool io_comm_rx::Comm_IO::wanted(bool publish, const std::string& topic) const
+{
+    return publish &&
+           (!settings_->demand_driven_output || node_->isSubscribed(topic));
+}
+
+std::vector<std::string> io_comm_rx::Comm_IO::pvtBlocks() const
+{
+    bool gnss = (settings_->septentrio_receiver_type == "gnss");
+    bool ins = (settings_->septentrio_receiver_type == "ins");
+    bool gpsfix = wanted(settings_->publish_gpsfix, "/gpsfix");
+    bool navsatfix = wanted(settings_->publish_navsatfix, "/navsatfix");
+    bool pose = wanted(settings_->publish_pose, "/pose");
+    bool twist = wanted(settings_->publish_twist, "/twist") ||
+                 wanted(settings_->publish_twist, "/twist_ins");
+    bool imu = wanted(settings_->publish_imu, "/imu") ||
+               wanted(settings_->publish_imubatch, "/imubatch");
+
+    std::vector<std::string> blocks;
+    if (settings_->use_gnss_time)
+    {
+        blocks.push_back("ReceiverTime");
+    }
+    if (wanted(settings_->publish_pvtcartesian, "/pvtcartesian"))
+    {
+        blocks.push_back("PVTCartesian");
+    }
+    if (wanted(settings_->publish_pvtgeodetic, "/pvtgeodetic") || twist ||
+        (gnss && (navsatfix || gpsfix || pose)))
+    {
+        blocks.push_back("PVTGeodetic");
+    }
+    if (wanted(settings_->publish_basevectorcart, "/basevectorcart"))
+    {
+        blocks.push_back("BaseVectorCart");
+    }
+    if (wanted(settings_->publish_basevectorgeod, "/basevectorgeod"))
+    {
+        blocks.push_back("BaseVectorGeod");
+    }
+    if (wanted(settings_->publish_poscovcartesian, "/poscovcartesian"))
+    {
+        blocks.push_back("PosCovCartesian");
+    }
+    if (wanted(settings_->publish_poscovgeodetic, "/poscovgeodetic") ||
+        (gnss && (navsatfix || gpsfix || pose)))
+    {
+        blocks.push_back("PosCovGeodetic");
+    }
+    if (wanted(settings_->publish_velcovgeodetic, "/velcovgeodetic") || twist ||
+        (gnss && gpsfix))
+    {
+        blocks.push_back("VelCovGeodetic");
+    }
+    if (wanted(settings_->publish_atteuler, "/atteuler") ||
+        (gnss && (gpsfix || pose)))
+    {
+        blocks.push_back("AttEuler");
+    }
+    if (wanted(settings_->publish_attcoveuler, "/attcoveuler") ||
+        (gnss && (gpsfix || pose)))
+    {
+        blocks.push_back("AttCovEuler");
+    }
+    if (wanted(settings_->publish_measepoch, "/measepoch") ||
+        wanted(settings_->publish_rawobservables, "/rawobservables") || gpsfix)
+    {
+        blocks.push_back("MeasEpoch");
+    }
+    if (gpsfix)
+    {
+        blocks.push_back("ChannelStatus");
+        blocks.push_back("DOP");
+    }
+    // Setting SBF output of Rx depending on the receiver type
+    // If INS then...
+    if (ins)
+    {
+        if (wanted(settings_->publish_insnavcart, "/insnavcart"))
+        {
+            blocks.push_back("INSNavCart");
+        }
+        // Subscribers of tf cannot be counted
+        if (wanted(settings_->publish_insnavgeod, "/insnavgeod") || navsatfix ||
+            gpsfix || pose || imu ||
+            wanted(settings_->publish_localization, "/localization") ||
+            settings_->publish_tf || twist)
+        {
+            blocks.push_back("INSNavGeod");
+        }
+        if (wanted(settings_->publish_exteventinsnavgeod, "/exteventinsnavgeod"))
+        {
+            blocks.push_back("ExtEventINSNavGeod");
+        }
+        if (wanted(settings_->publish_exteventinsnavcart, "/exteventinsnavcart"))
+        {
+            blocks.push_back("ExtEventINSNavCart");
+        }
+        if (wanted(settings_->publish_extsensormeas, "/extsensormeas") || imu)
+        {
+            blocks.push_back("ExtSensorMeas");
+        }
+    }
+    return blocks;
+}
+
+std::vector<std::string> io_comm_rx::Comm_IO::restBlocks() const
+{
+    std::vector<std::string> blocks;
+    if (settings_->septentrio_receiver_type == "ins")
+    {
+        if (wanted(settings_->publish_imusetup, "/imusetup"))
+        {
+            blocks.push_back("IMUSetup");
+        }
+        if (wanted(settings_->publish_velsensorsetup, "/velsensorsetup"))
+        {
+            blocks.push_back("VelSensorSetup");
+        }
+    }
+    if (wanted(settings_->publish_diagnostics, "/diagnostics"))
+    {
+        blocks.push_back("ReceiverStatus");
+        blocks.push_back("QualityInd");
+    }
+
+    blocks.push_back("ReceiverSetup");
+    return blocks;
+}
+
+bool io_comm_rx::Comm_IO::sendSbfStreams(const std::vector<std::string>& pvt_blocks,
+                                         const std::vector<std::string>& rest_blocks,
+                                         bool runtime)
+{
+    std::string pvt_interval = parsing_utilities::convertUserPeriodToRxCommand(
+        settings_->polling_period_pvt);
+
+    std::string rest_interval = parsing_utilities::convertUserPeriodToRxCommand(
+        settings_->polling_period_rest);
+
+    // The blocks are joined without a leading "+", which would add them to the
+    // blocks the stream outputs already instead of replacing those
+    auto streamCommand = [this](const std::string& stream,
+                                const std::vector<std::string>& blocks,
+                                const std::string& interval) {
+        std::stringstream ss;
+        ss << "sso, " << stream << ", " << mainPort_ << ", ";
+        if (blocks.empty())
+            ss << "none";
+        for (std::size_t i = 0; i < blocks.size(); ++i)
+            ss << (i ? "+" : "") << blocks[i];
+        ss << ", " << interval << "\x0D";
+        return ss.str();
+    };
+    std::string pvt_cmd = streamCommand("Stream1", pvt_blocks, pvt_interval);
+    std::string rest_cmd = streamCommand("Stream2", rest_blocks, rest_interval);
+
+    if (!runtime)
+    {
+        send(pvt_cmd);
+        send(rest_cmd);
+        return true;
+    }
+    boost::chrono::milliseconds timeout(2000);
+    return send(pvt_cmd, timeout) && send(rest_cmd, timeout);
+}
+
+void io_comm_rx::Comm_IO::followDemand()
+{
+    typedef boost::chrono::steady_clock Clock;
+    boost::chrono::milliseconds hold_time(settings_->demand_driven_output_hold_time);
+    uint32_t generation = node_->subscriptionGeneration();
+    bool pending = false;
+    Clock::time_point pending_since;
+    Clock::time_point last_rate_time = Clock::now();
+    uint64_t last_bytes = manager_->bytesReceived();
+
+    while (!stopping_)
+    {
+        try
+        {
+            boost::this_thread::sleep_for(boost::chrono::seconds(1));
+        } catch (boost::thread_interrupted&)
+        {
+            return;
+        }
+
+        Clock::time_point now = Clock::now();
+        uint64_t bytes = manager_->bytesReceived();
+        double seconds =
+            boost::chrono::duration<double>(now - last_rate_time).count();
+        if (seconds > 0.0)
+            link_byte_rate_ = (bytes - last_bytes) / seconds;
+        last_bytes = bytes;
+        last_rate_time = now;
+        node_->log(LogLevel::DEBUG,
+                   "Rx link byte rate: " +
+                       std::to_string(static_cast<uint32_t>(link_byte_rate_)) +
+                       " B/s");
+
+        if (!pending && (node_->subscriptionGeneration() == generation))
+            continue;
+        generation = node_->subscriptionGeneration();
+
+        std::vector<std::string> pvt_blocks = pvtBlocks();
+        std::vector<std::string> rest_blocks = restBlocks();
+        if ((pvt_blocks == active_pvt_blocks_) &&
+            (rest_blocks == active_rest_blocks_))
+        {
+            pending = false;
+            continue;
+        }
+        if (!pending)
+        {
+            pending = true;
+            pending_since = now;
+        }
+        // Blocks are added right away but only removed once they have not been
+        // needed for the hold time, which avoids command churn when subscribers
+        // come and go
+        if (addsBlocks(active_pvt_blocks_, pvt_blocks) ||
+            addsBlocks(active_rest_blocks_, rest_blocks) ||
+            (now - pending_since >= hold_time))
+        {
+            node_->log(LogLevel::INFO,
+                       "Reconfiguring SBF output of Rx for the current "
+                       "subscribers, link byte rate was " +
+                           std::to_string(static_cast<uint32_t>(link_byte_rate_)) +
+                           " B/s");
+            if (!sendSbfStreams(pvt_blocks, rest_blocks, true))
+            {
+                // The active blocks are unknown now, hence the streams are sent
+                // again at the next change of the subscribers
+                node_->log(LogLevel::WARN,
+                           "Rx did not reply to the reconfiguration of its SBF "
+                           "output, retrying once the subscribers change.");
+                active_pvt_blocks_.clear();
+                active_rest_blocks_.clear();
+                pending = false;
+                continue;
+            }
+            active_pvt_blocks_ = pvt_blocks;
+            active_rest_blocks_ = rest_blocks;
+            pending = false;
+        }
+    }
+}
+
+bool io_comm_rx::Comm_IO::addsBlocks(const std::vector<std::string>& active,
+                                     const std::vector<std::string>& needed)
+{
+    return std::any_of(needed.begin(), needed.end(),
+                       [&active](const std::string& block) {
+                           return std::find(active.begin(), active.end(), block) ==
+                                  active.end();
+                       });
+}
+
 //! initializeSerial is not self-contained: The for loop in Callbackhandlers' handle
 //! method would never open a specific handler unless the handler is added
 //! (=inserted) to the C++ map via this function. This way, the specific handler can
@@ -986,6 +1163,8 @@ void io_comm_rx::Comm_IO::defineMessages()
 {
     node_->log(LogLevel::DEBUG, "Called defineMessages() method");
 
+    handlers_.configureStreamMonitor();
+
     if (settings_->use_gnss_time || settings_->publish_gpst)
     {
         handlers_.callbackmap_ = handlers_.insert<ReceiverTimeMsg>("5914");
@@ -1002,7 +1181,7 @@ void io_comm_rx::Comm_IO::defineMessages()
     {
         handlers_.callbackmap_ = handlers_.insert<GpgsaMsg>("$GPGSA");
     }
-    if (settings_->publish_gpgsv)
+    if (settings_->publish_gpgsv || settings_->publish_satellites)
     {
         handlers_.callbackmap_ = handlers_.insert<GpgsvMsg>("$GPGSV");
         handlers_.callbackmap_ = handlers_.insert<GpgsvMsg>("$GLGSV");
@@ -1063,7 +1242,8 @@ void io_comm_rx::Comm_IO::defineMessages()
     {
         handlers_.callbackmap_ = handlers_.insert<AttCovEulerMsg>("5939");
     }
-    if (settings_->publish_measepoch || settings_->publish_gpsfix)
+    if (settings_->publish_measepoch || settings_->publish_rawobservables ||
+        settings_->publish_gpsfix)
     {
         handlers_.callbackmap_ =
             handlers_.insert<int32_t>("4027"); // MeasEpoch block
@@ -1082,6 +1262,8 @@ void io_comm_rx::Comm_IO::defineMessages()
         (settings_->publish_pose &&
          (settings_->septentrio_receiver_type == "ins")) ||
         (settings_->publish_imu && (settings_->septentrio_receiver_type == "ins")) ||
+        (settings_->publish_imubatch &&
+         (settings_->septentrio_receiver_type == "ins")) ||
         (settings_->publish_localization &&
          (settings_->septentrio_receiver_type == "ins")) ||
         (settings_->publish_twist &&
@@ -1094,7 +1276,8 @@ void io_comm_rx::Comm_IO::defineMessages()
     {
         handlers_.callbackmap_ = handlers_.insert<IMUSetupMsg>("4224");
     }
-    if (settings_->publish_extsensormeas || settings_->publish_imu)
+    if (settings_->publish_extsensormeas || settings_->publish_imu ||
+        settings_->publish_imubatch)
     {
         handlers_.callbackmap_ = handlers_.insert<ExtSensorMeasMsg>("4050");
     }
@@ -1191,19 +1374,58 @@ void io_comm_rx::Comm_IO::defineMessages()
 
 void io_comm_rx::Comm_IO::send(const std::string& cmd)
 {
-    // It is imperative to hold a lock on the mutex "g_response_mutex" while
-    // modifying the variable "g_response_received".
-    boost::mutex::scoped_lock lock(g_response_mutex);
+    // It is imperative to hold a lock on the mutex "response_mutex" while
+    // modifying the variable "response_received".
+    boost::mutex::scoped_lock lock(link_.response_mutex);
     // Determine byte size of cmd and hand over to send() method of manager_
-    manager_.get()->send(cmd);
-    g_response_condition.wait(lock, []() { return g_response_received; });
-    g_response_received = false;
+    if (!manager_.get()->send(cmd))
+    {
+        // No reply will come for a command that never left, e.g. when closing
+        node_->log(LogLevel::ERROR, "Command " + cmd.substr(0, cmd.find('\x0D')) +
+                                        " could not be queued for the Rx");
+        return;
+    }
+    link_.response_condition.wait(lock,
+                                  [this]() { return link_.response_received; });
+    link_.response_received = false;
+}
+
+bool io_comm_rx::Comm_IO::send(const std::string& cmd,
+                               const boost::chrono::milliseconds& timeout)
+{
+    boost::mutex::scoped_lock lock(link_.response_mutex);
+    // A reply that came in after an earlier timeout must not count for this one
+    link_.response_received = false;
+    if (!manager_.get()->send(cmd))
+    {
+        node_->log(LogLevel::ERROR, "Command " + cmd.substr(0, cmd.find('\x0D')) +
+                                        " could not be queued for the Rx");
+        return false;
+    }
+    if (!link_.response_condition.wait_for(
+            lock, timeout, [this]() { return link_.response_received; }))
+    {
+        node_->log(LogLevel::WARN,
+                   "No reply of the Rx to command " +
+                       cmd.substr(0, cmd.find('\x0D')) + " within " +
+                       std::to_string(timeout.count()) + " ms");
+        return false;
+    }
+    link_.response_received = false;
+    return true;
 }
 
-void io_comm_rx::Comm_IO::sendVelocity(const std::string& velNmea)
+void io_comm_rx::Comm_IO::sendVelocity(const char* velNmea, std::size_t size)
 {
     if (nmeaActivated_)
-        manager_.get()->send(velNmea);
+        manager_.get()->sendLatest(velNmea, size);
+}
+
+void io_comm_rx::Comm_IO::sendCorrections(const RtcmMsg::ConstPtr& rtcm)
+{
+    if (correctionsActivated_)
+        manager_.get()->send(rtcm, rtcm->message.data(), rtcm->message.size(),
+                             timestampFromRos(rtcm->header.stamp));
 }
 
 bool io_comm_rx::Comm_IO::initializeTCP(std::string host, std::string port)
@@ -1212,9 +1434,12 @@ bool io_comm_rx::Comm_IO::initializeTCP(std::string host, std::string port)
     host_ = host;
     port_ = port;
     // The io_context, of which io_service is a typedef of; it represents your
-    // program's link to the operating system's I/O services.
+    // program's link to the operating system's I/O services. With a shared reactor
+    // all Rx links use the same one.
     boost::shared_ptr<boost::asio::io_service> io_service(
-        new boost::asio::io_service);
+        reactor_ ? reactor_->ioService()
+                 : boost::shared_ptr<boost::asio::io_service>(
+                       new boost::asio::io_service));
     boost::asio::ip::tcp::resolver::iterator endpoint;
 
     try
@@ -1264,7 +1489,8 @@ bool io_comm_rx::Comm_IO::initializeTCP(std::string host, std::string port)
         return false;
     }
     setManager(boost::shared_ptr<Manager>(
-        new AsyncManager<boost::asio::ip::tcp::socket>(node_, socket, io_service)));
+        new AsyncManager<boost::asio::ip::tcp::socket>(node_, socket, io_service,
+                                                       settings_, reactor_)));
     node_->log(LogLevel::DEBUG, "Leaving initializeTCP() method..");
     return true;
 }
@@ -1272,12 +1498,36 @@ bool io_comm_rx::Comm_IO::initializeTCP(std::string host, std::string port)
 void io_comm_rx::Comm_IO::initializeSBFFileReading(std::string file_name)
 {
     node_->log(LogLevel::DEBUG, "Calling initializeSBFFileReading() method..");
-    std::size_t buffer_size = 8192;
-    uint8_t* to_be_parsed;
-    to_be_parsed = new uint8_t[buffer_size];
     std::ifstream bin_file(file_name, std::ios::binary);
     std::vector<uint8_t> vec_buf;
-    if (bin_file.good())
+    if (!bin_file.good())
+    {
+        throw std::runtime_error("I could not find your file. Or it is corrupted.");
+    }
+    if ((settings_->replay_start > 0.0) || (settings_->replay_end > 0.0))
+    {
+        // Seeks to the replay window via the time index instead of parsing the
+        // whole log
+        SbfIndex index(node_);
+        if (!index.load(file_name))
+            throw std::runtime_error("I could not index your file.");
+        uint64_t begin = index.offsetAt(settings_->replay_start);
+        uint64_t end = (settings_->replay_end > 0.0)
+                           ? index.offsetAt(settings_->replay_end)
+                           : std::numeric_limits<uint64_t>::max();
+        end = std::max(begin, end);
+        bin_file.seekg(0, std::ios::end);
+        end = std::min(end, static_cast<uint64_t>(bin_file.tellg()));
+        vec_buf.resize(end - begin);
+        bin_file.seekg(begin);
+        bin_file.read(reinterpret_cast<char*>(vec_buf.data()), vec_buf.size());
+        bin_file.close();
+        node_->log(LogLevel::INFO, "Replaying bytes " + std::to_string(begin) +
+                                       " to " + std::to_string(end) + " of " +
+                                       file_name);
+        if (vec_buf.empty())
+            return;
+    } else
     {
         /* Reads binary data using streambuffer iterators.
         Copies all SBF file content into bin_data. */
@@ -1285,43 +1535,47 @@ void io_comm_rx::Comm_IO::initializeSBFFileReading(std::string file_name)
                                    (std::istreambuf_iterator<char>()));
         vec_buf = v_buf;
         bin_file.close();
-    } else
-    {
-        throw std::runtime_error("I could not find your file. Or it is corrupted.");
     }
-    // The spec now guarantees that vectors store their elements contiguously.
-    to_be_parsed = vec_buf.data();
     std::stringstream ss;
     ss << "Opened and copied over from " << file_name;
     node_->log(LogLevel::DEBUG, ss.str());
 
-    while (!stopping_) // Loop will stop if we are done reading the SBF file
+    parseBuffer(vec_buf.data(), vec_buf.size());
+    node_->log(LogLevel::DEBUG, "Leaving initializeSBFFileReading() method..");
+}
+
+void io_comm_rx::Comm_IO::parseBuffer(const uint8_t* data, std::size_t size)
+{
+    const std::size_t buffer_size = 8192;
+    const uint8_t* to_be_parsed = data;
+    const uint8_t* end = data + size;
+    while (!stopping_ && (to_be_parsed < end))
     {
+        std::size_t parse_size = std::min(
+            buffer_size, static_cast<std::size_t>(end - to_be_parsed));
         try
         {
             node_->log(
                 LogLevel::DEBUG,
                 "Calling read_callback_() method, with number of bytes to be parsed being " +
-                    buffer_size);
-            handlers_.readCallback(node_->getTime(), to_be_parsed, buffer_size);
+                    std::to_string(parse_size));
+            handlers_.readCallback(node_->getTime(), to_be_parsed, parse_size);
         } catch (std::size_t& parsing_failed_here)
         {
-            if (to_be_parsed - vec_buf.data() >= vec_buf.size() * sizeof(uint8_t))
+            node_->log(LogLevel::DEBUG, "Parsing_failed_here is " +
+                                            std::to_string(parsing_failed_here));
+            // Restart the window at the incomplete message, unless it already
+            // starts the window, i.e. it is truncated or larger than the window
+            if (parsing_failed_here > 0)
             {
-                break;
+                to_be_parsed = to_be_parsed + parsing_failed_here;
+                continue;
             }
-            to_be_parsed = to_be_parsed + parsing_failed_here;
-            node_->log(LogLevel::DEBUG,
-                       "Parsing_failed_here is " + parsing_failed_here);
-            continue;
         }
-        if (to_be_parsed - vec_buf.data() >= vec_buf.size() * sizeof(uint8_t))
-        {
-            break;
-        }
-        to_be_parsed = to_be_parsed + buffer_size;
+        to_be_parsed = to_be_parsed + parse_size;
     }
-    node_->log(LogLevel::DEBUG, "Leaving initializeSBFFileReading() method..");
+    // The samples of the last batch would otherwise wait for the next buffer
+    handlers_.flushImuBatch(false);
 }
 
 void io_comm_rx::Comm_IO::initializePCAPFileReading(std::string file_name)
@@ -1374,6 +1628,7 @@ void io_comm_rx::Comm_IO::initializePCAPFileReading(std::string file_name)
         }
         to_be_parsed = to_be_parsed + buffer_size;
     }
+    handlers_.flushImuBatch(false);
     node_->log(LogLevel::DEBUG, "Leaving initializePCAPFileReading() method..");
 }
 
@@ -1384,9 +1639,12 @@ bool io_comm_rx::Comm_IO::initializeSerial(std::string port, uint32_t baudrate,
     serial_port_ = port;
     baudrate_ = baudrate;
     // The io_context, of which io_service is a typedef of; it represents your
-    // program's link to the operating system's I/O services.
+    // program's link to the operating system's I/O services. With a shared reactor
+    // all Rx links use the same one.
     boost::shared_ptr<boost::asio::io_service> io_service(
-        new boost::asio::io_service);
+        reactor_ ? reactor_->ioService()
+                 : boost::shared_ptr<boost::asio::io_service>(
+                       new boost::asio::io_service));
     // To perform I/O operations the program needs an I/O object, here "serial".
     boost::shared_ptr<boost::asio::serial_port> serial(
         new boost::asio::serial_port(*io_service));
@@ -1456,7 +1714,8 @@ bool io_comm_rx::Comm_IO::initializeSerial(std::string port, uint32_t baudrate,
     }
     node_->log(LogLevel::DEBUG, "Creating new Async-Manager object..");
     setManager(boost::shared_ptr<Manager>(
-        new AsyncManager<boost::asio::serial_port>(node_, serial, io_service)));
+        new AsyncManager<boost::asio::serial_port>(node_, serial, io_service,
+                                                   settings_, reactor_)));
 
     // Setting the baudrate, incrementally..
     node_->log(LogLevel::DEBUG,
@@ -1557,5 +1816,13 @@ void io_comm_rx::Comm_IO::setManager(const boost::shared_ptr<Manager>& manager)
     manager_ = manager;
     manager_->setCallback(boost::bind(&CallbackHandlers::readCallback, &handlers_,
                                       bp::_1, bp::_2, bp::_3));
+    if (!settings_->raw_recording_directory.empty())
+    {
+        // Slots as large as the input buffer of AsyncManager, which larger
+        // chunks are split across
+        if (!recorder_)
+            recorder_.reset(new RawRecorder(node_, settings_, 16384));
+        manager_->setRecorder(recorder_);
+    }
     node_->log(LogLevel::DEBUG, "Leaving setManager() method");
 }
\ No newline at end of file
@@ -0,0 +1,303 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C library includes
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+// C++ library includes
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+// ROSaic includes
+#include <septentrio_gnss_driver/communication/raw_recorder.hpp>
+
+/**
+ * @file raw_recorder.cpp
+ * @date 16/10/26
+ * @brief Defines a class recording the raw byte stream of the Rx into rotated files
+ */
+
+io_comm_rx::RawRecorder::RawRecorder(ROSaicNodeBase* node, const Settings* settings,
+                                     std::size_t chunk_size) :
+    node_(node),
+    directory_(settings->raw_recording_directory),
+    prefix_(node->receiver().empty() ? "rx" : "rx_" + node->receiver()),
+    max_file_size_(static_cast<uint64_t>(settings->raw_recording_max_file_size) *
+                   1000000),
+    max_file_duration_(
+        static_cast<uint64_t>(settings->raw_recording_max_file_duration) *
+        1000000000),
+    sync_period_(settings->raw_recording_sync_period), chunks_(QUEUE_SIZE - 1),
+    dropped_(0), stopping_(false), block_(nullptr), block_fill_(0), sbf_fd_(-1),
+    sidecar_fd_(-1), file_size_(0), file_start_(0),
+    last_sync_(boost::chrono::steady_clock::now()), file_count_(0),
+    dropped_reported_(0), failed_(false)
+{
+    // Names of Rxs in nested namespaces would otherwise become directories
+    std::replace(prefix_.begin(), prefix_.end(), '/', '_');
+    if (posix_memalign(reinterpret_cast<void**>(&block_), BLOCK_ALIGNMENT,
+                       BLOCK_SIZE) != 0)
+        throw std::runtime_error("Could not allocate buffer for raw recording");
+    // The spsc_queue holds one element less than its capacity, hence the size of
+    // chunks_.
+    for (auto& chunk : chunks_)
+    {
+        chunk.data.resize(chunk_size);
+        free_.push(&chunk);
+    }
+    sidecar_.reserve(SIDECAR_RECORD_SIZE * QUEUE_SIZE);
+    if ((::mkdir(directory_.c_str(), 0755) != 0) && (errno != EEXIST))
+    {
+        node_->log(LogLevel::ERROR, "Could not create directory " + directory_ +
+                                        " for raw recording: " +
+                                        std::strerror(errno));
+    }
+    writing_thread_ = boost::thread(boost::bind(&RawRecorder::run, this));
+}
+
+io_comm_rx::RawRecorder::~RawRecorder()
+{
+    stopping_ = true;
+    wake_condition_.notify_one();
+    writing_thread_.join();
+    std::free(block_);
+    if (dropped_ > 0)
+        node_->log(LogLevel::WARN, "Raw recording dropped " +
+                                       std::to_string(dropped_.load()) +
+                                       " chunks in total.");
+}
+
+void io_comm_rx::RawRecorder::record(Timestamp recvTime, const uint8_t* data,
+                                     std::size_t size)
+{
+    // Chunks larger than a slot are split, so that no byte is cut off
+    while (size > 0)
+    {
+        Chunk* chunk;
+        if (!free_.pop(chunk))
+        {
+            ++dropped_;
+            break;
+        }
+        chunk->recv_time = recvTime;
+        chunk->size = std::min(size, chunk->data.size());
+        std::memcpy(chunk->data.data(), data, chunk->size);
+        filled_.push(chunk);
+        data += chunk->size;
+        size -= chunk->size;
+    }
+    wake_condition_.notify_one();
+}
+
+void io_comm_rx::RawRecorder::run()
+{
+    while (true)
+    {
+        bool idle = true;
+        Chunk* chunk;
+        while (filled_.pop(chunk))
+        {
+            idle = false;
+            append(*chunk);
+            free_.push(chunk);
+        }
+
+        uint64_t dropped = dropped_;
+        if (dropped != dropped_reported_)
+        {
+            node_->log(LogLevel::WARN,
+                       "Raw recording could not keep up and dropped " +
+                           std::to_string(dropped - dropped_reported_) +
+                           " chunks.");
+            dropped_reported_ = dropped;
+        }
+
+        boost::chrono::steady_clock::time_point now =
+            boost::chrono::steady_clock::now();
+        if ((sbf_fd_ >= 0) && (now - last_sync_ >= sync_period_))
+        {
+            flush(true);
+            last_sync_ = now;
+        }
+
+        if (stopping_ && !filled_.read_available())
+            break;
+        if (idle)
+        {
+            boost::mutex::scoped_lock lock(wake_mutex_);
+            wake_condition_.wait_for(lock, boost::chrono::milliseconds(10));
+        }
+    }
+    closeFiles();
+}
+
+void io_comm_rx::RawRecorder::append(const Chunk& chunk)
+{
+    if (failed_)
+        return;
+    if ((sbf_fd_ >= 0) &&
+        ((max_file_size_ && (file_size_ + chunk.size > max_file_size_)) ||
+         (max_file_duration_ &&
+          (chunk.recv_time - file_start_ >= max_file_duration_))))
+        closeFiles();
+    if ((sbf_fd_ < 0) && !openFiles(chunk.recv_time))
+        return;
+
+    uint8_t record[SIDECAR_RECORD_SIZE];
+    uint64_t offset = file_size_;
+    uint32_t size = static_cast<uint32_t>(chunk.size);
+    std::memcpy(record, &chunk.recv_time, 8);
+    std::memcpy(record + 8, &offset, 8);
+    std::memcpy(record + 16, &size, 4);
+    sidecar_.insert(sidecar_.end(), record, record + SIDECAR_RECORD_SIZE);
+
+    const uint8_t* data = chunk.data.data();
+    std::size_t remaining = chunk.size;
+    while (remaining > 0)
+    {
+        std::size_t n = std::min(remaining, BLOCK_SIZE - block_fill_);
+        std::memcpy(block_ + block_fill_, data, n);
+        block_fill_ += n;
+        data += n;
+        remaining -= n;
+        if (block_fill_ == BLOCK_SIZE)
+            flush(false);
+    }
+    file_size_ += chunk.size;
+}
+
+bool io_comm_rx::RawRecorder::openFiles(Timestamp stamp)
+{
+    time_t seconds = stamp / 1000000000;
+    struct tm tm_utc;
+    gmtime_r(&seconds, &tm_utc);
+    char name[32];
+    std::strftime(name, sizeof(name), "%Y%m%d_%H%M%S", &tm_utc);
+    std::string base;
+    // Existing files, e.g. of another process recording to the same directory,
+    // are skipped by counting up instead of being overwritten
+    while (true)
+    {
+        base = directory_ + "/" + prefix_ + "_" + name + "_" +
+               std::to_string(file_count_++);
+        sbf_fd_ = ::open((base + ".sbf").c_str(), O_WRONLY | O_CREAT | O_EXCL,
+                         0644);
+        if (sbf_fd_ >= 0)
+        {
+            sidecar_fd_ = ::open((base + ".ts").c_str(),
+                                 O_WRONLY | O_CREAT | O_EXCL, 0644);
+            if (sidecar_fd_ >= 0)
+                break;
+            int error = errno;
+            ::close(sbf_fd_);
+            ::unlink((base + ".sbf").c_str());
+            sbf_fd_ = -1;
+            errno = error;
+        }
+        if (errno != EEXIST)
+            break;
+    }
+    if ((sbf_fd_ < 0) || (sidecar_fd_ < 0))
+    {
+        node_->log(LogLevel::ERROR, "Could not open " + base +
+                                        " for raw recording: " +
+                                        std::strerror(errno) +
+                                        ". Recording stopped.");
+        if (sbf_fd_ >= 0)
+            ::close(sbf_fd_);
+        if (sidecar_fd_ >= 0)
+            ::close(sidecar_fd_);
+        sbf_fd_ = -1;
+        sidecar_fd_ = -1;
+        failed_ = true;
+        return false;
+    }
+    file_size_ = 0;
+    file_start_ = stamp;
+    node_->log(LogLevel::INFO, "Recording raw Rx stream to " + base + ".sbf");
+    return true;
+}
+
+void io_comm_rx::RawRecorder::closeFiles()
+{
+    if (sbf_fd_ < 0)
+        return;
+    flush(true);
+    if (sbf_fd_ >= 0)
+        ::close(sbf_fd_);
+    if (sidecar_fd_ >= 0)
+        ::close(sidecar_fd_);
+    sbf_fd_ = -1;
+    sidecar_fd_ = -1;
+}
+
+void io_comm_rx::RawRecorder::flush(bool sync)
+{
+    if (sbf_fd_ < 0)
+        return;
+    bool ok = writeAll(sbf_fd_, block_, block_fill_) &&
+              writeAll(sidecar_fd_, sidecar_.data(), sidecar_.size());
+    block_fill_ = 0;
+    sidecar_.clear();
+    if (ok && sync)
+        ok = (::fdatasync(sbf_fd_) == 0) && (::fdatasync(sidecar_fd_) == 0);
+    if (!ok)
+    {
+        node_->log(LogLevel::ERROR, "Raw recording failed: " +
+                                        std::string(std::strerror(errno)) +
+                                        ". Recording stopped.");
+        ::close(sbf_fd_);
+        ::close(sidecar_fd_);
+        sbf_fd_ = -1;
+        sidecar_fd_ = -1;
+        failed_ = true;
+    }
+}
+
+bool io_comm_rx::RawRecorder::writeAll(int fd, const uint8_t* data,
+                                       std::size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
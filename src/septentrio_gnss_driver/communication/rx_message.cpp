@@ -28,8 +28,8 @@
 //
 // *****************************************************************************
 
-#include <GeographicLib/UTMUPS.hpp>
 #include <boost/tokenizer.hpp>
+#include <cstring>
 #include <septentrio_gnss_driver/communication/rx_message.hpp>
 #include <thread>
 
@@ -51,6 +51,16 @@ using parsing_utilities::deg2rad;
 using parsing_utilities::deg2radSq;
 using parsing_utilities::rad2deg;
 
+namespace {
+    //! Shortest SBF block, holding the header, TOW and WNc padded to 4 bytes
+    const uint16_t MIN_SBF_LENGTH = 16;
+    //! Longest SBF block deemed plausible, the size of the read buffer
+    const uint16_t MAX_SBF_LENGTH = 16384;
+    //! Highest block revision deemed plausible, one above those decoded, so that
+    //! a firmware update adding a revision does not silence a block
+    const uint8_t MAX_SBF_REVISION = 5;
+} // namespace
+
 PoseWithCovarianceStampedMsg
 io_comm_rx::RxMessage::PoseWithCovarianceStampedCallback()
 {
@@ -59,72 +69,72 @@ io_comm_rx::RxMessage::PoseWithCovarianceStampedCallback()
     {
         // Filling in the pose data
         double yaw = 0.0;
-        if (validValue(last_atteuler_.heading))
-            yaw = last_atteuler_.heading;
+        if (validValue(last_atteuler_->heading))
+            yaw = last_atteuler_->heading;
         double pitch = 0.0;
-        if (validValue(last_atteuler_.pitch))
-            pitch = last_atteuler_.pitch;
+        if (validValue(last_atteuler_->pitch))
+            pitch = last_atteuler_->pitch;
         double roll = 0.0;
-        if (validValue(last_atteuler_.roll))
-            roll = last_atteuler_.roll;
+        if (validValue(last_atteuler_->roll))
+            roll = last_atteuler_->roll;
         msg.pose.pose.orientation = parsing_utilities::convertEulerToQuaternion(
             deg2rad(yaw), deg2rad(pitch), deg2rad(roll));
-        msg.pose.pose.position.x = rad2deg(last_pvtgeodetic_.longitude);
-        msg.pose.pose.position.y = rad2deg(last_pvtgeodetic_.latitude);
-        msg.pose.pose.position.z = last_pvtgeodetic_.height;
+        msg.pose.pose.position.x = rad2deg(last_pvtgeodetic_->longitude);
+        msg.pose.pose.position.y = rad2deg(last_pvtgeodetic_->latitude);
+        msg.pose.pose.position.z = last_pvtgeodetic_->height;
         // Filling in the covariance data in row-major order
-        msg.pose.covariance[0] = last_poscovgeodetic_.cov_lonlon;
-        msg.pose.covariance[1] = last_poscovgeodetic_.cov_latlon;
-        msg.pose.covariance[2] = last_poscovgeodetic_.cov_lonhgt;
-        msg.pose.covariance[6] = last_poscovgeodetic_.cov_latlon;
-        msg.pose.covariance[7] = last_poscovgeodetic_.cov_latlat;
-        msg.pose.covariance[8] = last_poscovgeodetic_.cov_lathgt;
-        msg.pose.covariance[12] = last_poscovgeodetic_.cov_lonhgt;
-        msg.pose.covariance[13] = last_poscovgeodetic_.cov_lathgt;
-        msg.pose.covariance[14] = last_poscovgeodetic_.cov_hgthgt;
-        msg.pose.covariance[21] = deg2radSq(last_attcoveuler_.cov_rollroll);
-        msg.pose.covariance[22] = deg2radSq(last_attcoveuler_.cov_pitchroll);
-        msg.pose.covariance[23] = deg2radSq(last_attcoveuler_.cov_headroll);
-        msg.pose.covariance[27] = deg2radSq(last_attcoveuler_.cov_pitchroll);
-        msg.pose.covariance[28] = deg2radSq(last_attcoveuler_.cov_pitchpitch);
-        msg.pose.covariance[29] = deg2radSq(last_attcoveuler_.cov_headpitch);
-        msg.pose.covariance[33] = deg2radSq(last_attcoveuler_.cov_headroll);
-        msg.pose.covariance[34] = deg2radSq(last_attcoveuler_.cov_headpitch);
-        msg.pose.covariance[35] = deg2radSq(last_attcoveuler_.cov_headhead);
+        msg.pose.covariance[0] = last_poscovgeodetic_->cov_lonlon;
+        msg.pose.covariance[1] = last_poscovgeodetic_->cov_latlon;
+        msg.pose.covariance[2] = last_poscovgeodetic_->cov_lonhgt;
+        msg.pose.covariance[6] = last_poscovgeodetic_->cov_latlon;
+        msg.pose.covariance[7] = last_poscovgeodetic_->cov_latlat;
+        msg.pose.covariance[8] = last_poscovgeodetic_->cov_lathgt;
+        msg.pose.covariance[12] = last_poscovgeodetic_->cov_lonhgt;
+        msg.pose.covariance[13] = last_poscovgeodetic_->cov_lathgt;
+        msg.pose.covariance[14] = last_poscovgeodetic_->cov_hgthgt;
+        msg.pose.covariance[21] = deg2radSq(last_attcoveuler_->cov_rollroll);
+        msg.pose.covariance[22] = deg2radSq(last_attcoveuler_->cov_pitchroll);
+        msg.pose.covariance[23] = deg2radSq(last_attcoveuler_->cov_headroll);
+        msg.pose.covariance[27] = deg2radSq(last_attcoveuler_->cov_pitchroll);
+        msg.pose.covariance[28] = deg2radSq(last_attcoveuler_->cov_pitchpitch);
+        msg.pose.covariance[29] = deg2radSq(last_attcoveuler_->cov_headpitch);
+        msg.pose.covariance[33] = deg2radSq(last_attcoveuler_->cov_headroll);
+        msg.pose.covariance[34] = deg2radSq(last_attcoveuler_->cov_headpitch);
+        msg.pose.covariance[35] = deg2radSq(last_attcoveuler_->cov_headhead);
     }
     if (settings_->septentrio_receiver_type == "ins")
     {
-        msg.pose.pose.position.x = rad2deg(last_insnavgeod_.longitude);
-        msg.pose.pose.position.y = rad2deg(last_insnavgeod_.latitude);
-        msg.pose.pose.position.z = last_insnavgeod_.height;
+        msg.pose.pose.position.x = rad2deg(last_insnavgeod_->longitude);
+        msg.pose.pose.position.y = rad2deg(last_insnavgeod_->latitude);
+        msg.pose.pose.position.z = last_insnavgeod_->height;
 
         // Filling in the pose data
-        if ((last_insnavgeod_.sb_list & 1) != 0)
+        if ((last_insnavgeod_->sb_list & 1) != 0)
         {
             // Pos autocov
             msg.pose.covariance[0] =
-                parsing_utilities::square(last_insnavgeod_.longitude_std_dev);
+                parsing_utilities::square(last_insnavgeod_->longitude_std_dev);
             msg.pose.covariance[7] =
-                parsing_utilities::square(last_insnavgeod_.latitude_std_dev);
+                parsing_utilities::square(last_insnavgeod_->latitude_std_dev);
             msg.pose.covariance[14] =
-                parsing_utilities::square(last_insnavgeod_.height_std_dev);
+                parsing_utilities::square(last_insnavgeod_->height_std_dev);
         } else
         {
             msg.pose.covariance[0] = -1.0;
             msg.pose.covariance[7] = -1.0;
             msg.pose.covariance[14] = -1.0;
         }
-        if ((last_insnavgeod_.sb_list & 2) != 0)
+        if ((last_insnavgeod_->sb_list & 2) != 0)
         {
             double yaw = 0.0;
-            if (validValue(last_insnavgeod_.heading))
-                yaw = last_insnavgeod_.heading;
+            if (validValue(last_insnavgeod_->heading))
+                yaw = last_insnavgeod_->heading;
             double pitch = 0.0;
-            if (validValue(last_insnavgeod_.pitch))
-                pitch = last_insnavgeod_.pitch;
+            if (validValue(last_insnavgeod_->pitch))
+                pitch = last_insnavgeod_->pitch;
             double roll = 0.0;
-            if (validValue(last_insnavgeod_.roll))
-                roll = last_insnavgeod_.roll;
+            if (validValue(last_insnavgeod_->roll))
+                roll = last_insnavgeod_->roll;
             // Attitude
             msg.pose.pose.orientation = parsing_utilities::convertEulerToQuaternion(
                 deg2rad(yaw), deg2rad(pitch), deg2rad(roll));
@@ -135,22 +145,22 @@ io_comm_rx::RxMessage::PoseWithCovarianceStampedCallback()
             msg.pose.pose.orientation.y = std::numeric_limits<double>::quiet_NaN();
             msg.pose.pose.orientation.z = std::numeric_limits<double>::quiet_NaN();
         }
-        if ((last_insnavgeod_.sb_list & 4) != 0)
+        if ((last_insnavgeod_->sb_list & 4) != 0)
         {
             // Attitude autocov
-            if (validValue(last_insnavgeod_.roll_std_dev))
+            if (validValue(last_insnavgeod_->roll_std_dev))
                 msg.pose.covariance[21] = parsing_utilities::square(
-                    deg2rad(last_insnavgeod_.roll_std_dev));
+                    deg2rad(last_insnavgeod_->roll_std_dev));
             else
                 msg.pose.covariance[21] = -1.0;
-            if (validValue(last_insnavgeod_.pitch_std_dev))
+            if (validValue(last_insnavgeod_->pitch_std_dev))
                 msg.pose.covariance[28] = parsing_utilities::square(
-                    deg2rad(last_insnavgeod_.pitch_std_dev));
+                    deg2rad(last_insnavgeod_->pitch_std_dev));
             else
                 msg.pose.covariance[28] = -1.0;
-            if (validValue(last_insnavgeod_.heading_std_dev))
+            if (validValue(last_insnavgeod_->heading_std_dev))
                 msg.pose.covariance[35] = parsing_utilities::square(
-                    deg2rad(last_insnavgeod_.heading_std_dev));
+                    deg2rad(last_insnavgeod_->heading_std_dev));
             else
                 msg.pose.covariance[35] = -1.0;
         } else
@@ -159,26 +169,26 @@ io_comm_rx::RxMessage::PoseWithCovarianceStampedCallback()
             msg.pose.covariance[28] = -1.0;
             msg.pose.covariance[35] = -1.0;
         }
-        if ((last_insnavgeod_.sb_list & 32) != 0)
+        if ((last_insnavgeod_->sb_list & 32) != 0)
         {
             // Pos cov
-            msg.pose.covariance[1] = last_insnavgeod_.latitude_longitude_cov;
-            msg.pose.covariance[2] = last_insnavgeod_.longitude_height_cov;
-            msg.pose.covariance[6] = last_insnavgeod_.latitude_longitude_cov;
-            msg.pose.covariance[8] = last_insnavgeod_.latitude_height_cov;
-            msg.pose.covariance[12] = last_insnavgeod_.longitude_height_cov;
-            msg.pose.covariance[13] = last_insnavgeod_.latitude_height_cov;
+            msg.pose.covariance[1] = last_insnavgeod_->latitude_longitude_cov;
+            msg.pose.covariance[2] = last_insnavgeod_->longitude_height_cov;
+            msg.pose.covariance[6] = last_insnavgeod_->latitude_longitude_cov;
+            msg.pose.covariance[8] = last_insnavgeod_->latitude_height_cov;
+            msg.pose.covariance[12] = last_insnavgeod_->longitude_height_cov;
+            msg.pose.covariance[13] = last_insnavgeod_->latitude_height_cov;
         }
-        if ((last_insnavgeod_.sb_list & 64) != 0)
+        if ((last_insnavgeod_->sb_list & 64) != 0)
         {
             // Attitude cov
-            msg.pose.covariance[22] = deg2radSq(last_insnavgeod_.pitch_roll_cov);
-            msg.pose.covariance[23] = deg2radSq(last_insnavgeod_.heading_roll_cov);
-            msg.pose.covariance[27] = deg2radSq(last_insnavgeod_.pitch_roll_cov);
+            msg.pose.covariance[22] = deg2radSq(last_insnavgeod_->pitch_roll_cov);
+            msg.pose.covariance[23] = deg2radSq(last_insnavgeod_->heading_roll_cov);
+            msg.pose.covariance[27] = deg2radSq(last_insnavgeod_->pitch_roll_cov);
 
-            msg.pose.covariance[29] = deg2radSq(last_insnavgeod_.heading_pitch_cov);
-            msg.pose.covariance[33] = deg2radSq(last_insnavgeod_.heading_roll_cov);
-            msg.pose.covariance[34] = deg2radSq(last_insnavgeod_.heading_pitch_cov);
+            msg.pose.covariance[29] = deg2radSq(last_insnavgeod_->heading_pitch_cov);
+            msg.pose.covariance[33] = deg2radSq(last_insnavgeod_->heading_roll_cov);
+            msg.pose.covariance[34] = deg2radSq(last_insnavgeod_->heading_pitch_cov);
         }
     }
     return msg;
@@ -288,6 +298,25 @@ DiagnosticArrayMsg io_comm_rx::RxMessage::DiagnosticArrayCallback()
     gnss_status.message =
         "Quality Indicators (from 0 for low quality to 10 for high quality, 15 if unknown)";
     msg.status.push_back(gnss_status);
+
+    // Continuity of the SBF stream in the last second
+    DiagnosticStatusMsg stream_status;
+    const auto& degradation = stream_monitor_.lastDegradation();
+    const char* keys[] = {"Missing Epochs", "Late Blocks", "Out-of-Order Blocks",
+                          "CRC Errors"};
+    stream_status.level = DiagnosticStatusMsg::OK;
+    stream_status.values.resize(degradation.size());
+    for (std::size_t i = 0; i < degradation.size(); ++i)
+    {
+        if (degradation[i] > 0)
+            stream_status.level = DiagnosticStatusMsg::WARN;
+        stream_status.values[i].key = keys[i];
+        stream_status.values[i].value = std::to_string(degradation[i]);
+    }
+    stream_status.hardware_id = serialnumber;
+    stream_status.name = "stream";
+    stream_status.message = "SBF stream continuity in the last second";
+    msg.status.push_back(stream_status);
     return msg;
 };
 
@@ -295,45 +324,51 @@ ImuMsg io_comm_rx::RxMessage::ImuCallback()
 {
     ImuMsg msg;
 
-    msg.linear_acceleration.x = last_extsensmeas_.acceleration_x;
-    msg.linear_acceleration.y = last_extsensmeas_.acceleration_y;
-    msg.linear_acceleration.z = last_extsensmeas_.acceleration_z;
+    msg.linear_acceleration.x = last_extsensmeas_->acceleration_x;
+    msg.linear_acceleration.y = last_extsensmeas_->acceleration_y;
+    msg.linear_acceleration.z = last_extsensmeas_->acceleration_z;
 
-    msg.angular_velocity.x = last_extsensmeas_.angular_rate_x;
-    msg.angular_velocity.y = last_extsensmeas_.angular_rate_y;
-    msg.angular_velocity.z = last_extsensmeas_.angular_rate_z;
+    msg.angular_velocity.x = last_extsensmeas_->angular_rate_x;
+    msg.angular_velocity.y = last_extsensmeas_->angular_rate_y;
+    msg.angular_velocity.z = last_extsensmeas_->angular_rate_z;
 
     bool valid_orientation = true;
     if (settings_->septentrio_receiver_type == "ins")
     {
-        if (validValue(last_insnavgeod_.block_header.tow))
+        if (validValue(last_insnavgeod_->block_header.tow))
         {
-            Timestamp tsImu = timestampSBF(last_extsensmeas_.block_header.tow,
-                                           last_extsensmeas_.block_header.wnc, true);
-            Timestamp tsIns = timestampSBF(last_insnavgeod_.block_header.tow,
-                                           last_insnavgeod_.block_header.wnc,
+            Timestamp tsImu =
+                timestampSBF(last_extsensmeas_->block_header.tow,
+                             last_extsensmeas_->block_header.wnc, true);
+            Timestamp tsIns = timestampSBF(last_insnavgeod_->block_header.tow,
+                                           last_insnavgeod_->block_header.wnc,
                                            true); // Filling in the oreintation data
 
-            static int64_t maxDt = (settings_->polling_period_pvt == 0)
+            // Not a function-local static, which would be shared by all Rxs of
+            // the process
+            if (imu_max_ins_age_ == 0)
+                imu_max_ins_age_ = (settings_->polling_period_pvt == 0)
                                        ? 10000000
-                                       : settings_->polling_period_pvt * 1000000;
-            if ((tsImu - tsIns) > maxDt)
+                                       : static_cast<int64_t>(
+                                             settings_->polling_period_pvt) *
+                                             1000000;
+            if ((tsImu - tsIns) > imu_max_ins_age_)
             {
                 valid_orientation = false;
             } else
             {
-                if ((last_insnavgeod_.sb_list & 2) != 0)
+                if ((last_insnavgeod_->sb_list & 2) != 0)
                 {
                     // Attitude
-                    if (validValue(last_insnavgeod_.heading) &&
-                        validValue(last_insnavgeod_.pitch) &&
-                        validValue(last_insnavgeod_.roll))
+                    if (validValue(last_insnavgeod_->heading) &&
+                        validValue(last_insnavgeod_->pitch) &&
+                        validValue(last_insnavgeod_->roll))
                     {
                         msg.orientation =
                             parsing_utilities::convertEulerToQuaternion(
-                                deg2rad(last_insnavgeod_.heading),
-                                deg2rad(last_insnavgeod_.pitch),
-                                deg2rad(last_insnavgeod_.roll));
+                                deg2rad(last_insnavgeod_->heading),
+                                deg2rad(last_insnavgeod_->pitch),
+                                deg2rad(last_insnavgeod_->roll));
                     } else
                     {
                         valid_orientation = false;
@@ -342,19 +377,19 @@ ImuMsg io_comm_rx::RxMessage::ImuCallback()
                 {
                     valid_orientation = false;
                 }
-                if ((last_insnavgeod_.sb_list & 4) != 0)
+                if ((last_insnavgeod_->sb_list & 4) != 0)
                 {
                     // Attitude autocov
-                    if (validValue(last_insnavgeod_.roll_std_dev) &&
-                        validValue(last_insnavgeod_.pitch_std_dev) &&
-                        validValue(last_insnavgeod_.heading_std_dev))
+                    if (validValue(last_insnavgeod_->roll_std_dev) &&
+                        validValue(last_insnavgeod_->pitch_std_dev) &&
+                        validValue(last_insnavgeod_->heading_std_dev))
                     {
                         msg.orientation_covariance[0] = parsing_utilities::square(
-                            deg2rad(last_insnavgeod_.roll_std_dev));
+                            deg2rad(last_insnavgeod_->roll_std_dev));
                         msg.orientation_covariance[4] = parsing_utilities::square(
-                            deg2rad(last_insnavgeod_.pitch_std_dev));
+                            deg2rad(last_insnavgeod_->pitch_std_dev));
                         msg.orientation_covariance[8] = parsing_utilities::square(
-                            deg2rad(last_insnavgeod_.heading_std_dev));
+                            deg2rad(last_insnavgeod_->heading_std_dev));
                     } else
                     {
                         valid_orientation = false;
@@ -363,22 +398,22 @@ ImuMsg io_comm_rx::RxMessage::ImuCallback()
                 {
                     valid_orientation = false;
                 }
-                if ((last_insnavgeod_.sb_list & 64) != 0)
+                if ((last_insnavgeod_->sb_list & 64) != 0)
                 {
                     // Attitude cov
                     msg.orientation_covariance[1] =
-                        deg2radSq(last_insnavgeod_.pitch_roll_cov);
+                        deg2radSq(last_insnavgeod_->pitch_roll_cov);
                     msg.orientation_covariance[2] =
-                        deg2radSq(last_insnavgeod_.heading_roll_cov);
+                        deg2radSq(last_insnavgeod_->heading_roll_cov);
                     msg.orientation_covariance[3] =
-                        deg2radSq(last_insnavgeod_.pitch_roll_cov);
+                        deg2radSq(last_insnavgeod_->pitch_roll_cov);
 
                     msg.orientation_covariance[5] =
-                        deg2radSq(last_insnavgeod_.heading_pitch_cov);
+                        deg2radSq(last_insnavgeod_->heading_pitch_cov);
                     msg.orientation_covariance[6] =
-                        deg2radSq(last_insnavgeod_.heading_roll_cov);
+                        deg2radSq(last_insnavgeod_->heading_roll_cov);
                     msg.orientation_covariance[7] =
-                        deg2radSq(last_insnavgeod_.heading_pitch_cov);
+                        deg2radSq(last_insnavgeod_->heading_pitch_cov);
                 }
             }
         } else
@@ -411,20 +446,20 @@ io_comm_rx::RxMessage::TwistCallback(bool fromIns /* = false*/)
 
     if (fromIns)
     {
-        msg.header = last_insnavgeod_.header;
+        msg.header = last_insnavgeod_->header;
 
-        if ((last_insnavgeod_.sb_list & 8) != 0)
+        if ((last_insnavgeod_->sb_list & 8) != 0)
         {
             // Linear velocity in navigation frame
             double ve = 0.0;
-            if (validValue(last_insnavgeod_.ve))
-                ve = last_insnavgeod_.ve;
+            if (validValue(last_insnavgeod_->ve))
+                ve = last_insnavgeod_->ve;
             double vn = 0.0;
-            if (validValue(last_insnavgeod_.vn))
-                vn = last_insnavgeod_.vn;
+            if (validValue(last_insnavgeod_->vn))
+                vn = last_insnavgeod_->vn;
             double vu = 0.0;
-            if (validValue(last_insnavgeod_.vu))
-                vu = last_insnavgeod_.vu;
+            if (validValue(last_insnavgeod_->vu))
+                vu = last_insnavgeod_->vu;
             Eigen::Vector3d vel;
             if (settings_->use_ros_axis_orientation)
             {
@@ -446,56 +481,56 @@ io_comm_rx::RxMessage::TwistCallback(bool fromIns /* = false*/)
             msg.twist.twist.linear.z = std::numeric_limits<double>::quiet_NaN();
         }
 
-        if (((last_insnavgeod_.sb_list & 16) != 0) &&
-            ((last_insnavgeod_.sb_list & 2) != 0) &&
-            ((last_insnavgeod_.sb_list & 8) != 0))
+        if (((last_insnavgeod_->sb_list & 16) != 0) &&
+            ((last_insnavgeod_->sb_list & 2) != 0) &&
+            ((last_insnavgeod_->sb_list & 8) != 0))
         {
             Eigen::Matrix3d Cov_vel_n = Eigen::Matrix3d::Zero();
-            if ((last_insnavgeod_.sb_list & 128) != 0)
+            if ((last_insnavgeod_->sb_list & 128) != 0)
             {
                 // Linear velocity covariance
-                if (validValue(last_insnavgeod_.ve_std_dev))
+                if (validValue(last_insnavgeod_->ve_std_dev))
                     if (settings_->use_ros_axis_orientation)
                         Cov_vel_n(0, 0) =
-                            parsing_utilities::square(last_insnavgeod_.ve_std_dev);
+                            parsing_utilities::square(last_insnavgeod_->ve_std_dev);
                     else
                         Cov_vel_n(1, 1) =
-                            parsing_utilities::square(last_insnavgeod_.ve_std_dev);
+                            parsing_utilities::square(last_insnavgeod_->ve_std_dev);
                 else
                     Cov_vel_n(0, 0) = -1.0;
-                if (validValue(last_insnavgeod_.vn_std_dev))
+                if (validValue(last_insnavgeod_->vn_std_dev))
                     if (settings_->use_ros_axis_orientation)
                         Cov_vel_n(1, 1) =
-                            parsing_utilities::square(last_insnavgeod_.vn_std_dev);
+                            parsing_utilities::square(last_insnavgeod_->vn_std_dev);
                     else
                         Cov_vel_n(0, 0) =
-                            parsing_utilities::square(last_insnavgeod_.vn_std_dev);
+                            parsing_utilities::square(last_insnavgeod_->vn_std_dev);
                 else
                     Cov_vel_n(1, 1) = -1.0;
-                if (validValue(last_insnavgeod_.vu_std_dev))
+                if (validValue(last_insnavgeod_->vu_std_dev))
                     Cov_vel_n(2, 2) =
-                        parsing_utilities::square(last_insnavgeod_.vu_std_dev);
+                        parsing_utilities::square(last_insnavgeod_->vu_std_dev);
                 else
                     Cov_vel_n(2, 2) = -1.0;
 
-                if (validValue(last_insnavgeod_.ve_vn_cov))
-                    Cov_vel_n(0, 1) = Cov_vel_n(1, 0) = last_insnavgeod_.ve_vn_cov;
+                if (validValue(last_insnavgeod_->ve_vn_cov))
+                    Cov_vel_n(0, 1) = Cov_vel_n(1, 0) = last_insnavgeod_->ve_vn_cov;
                 if (settings_->use_ros_axis_orientation)
                 {
-                    if (validValue(last_insnavgeod_.ve_vu_cov))
+                    if (validValue(last_insnavgeod_->ve_vu_cov))
                         Cov_vel_n(0, 2) = Cov_vel_n(2, 0) =
-                            last_insnavgeod_.ve_vu_cov;
-                    if (validValue(last_insnavgeod_.vn_vu_cov))
+                            last_insnavgeod_->ve_vu_cov;
+                    if (validValue(last_insnavgeod_->vn_vu_cov))
                         Cov_vel_n(2, 1) = Cov_vel_n(1, 2) =
-                            last_insnavgeod_.vn_vu_cov;
+                            last_insnavgeod_->vn_vu_cov;
                 } else
                 {
-                    if (validValue(last_insnavgeod_.vn_vu_cov))
+                    if (validValue(last_insnavgeod_->vn_vu_cov))
                         Cov_vel_n(0, 2) = Cov_vel_n(2, 0) =
-                            -last_insnavgeod_.vn_vu_cov;
-                    if (validValue(last_insnavgeod_.ve_vu_cov))
+                            -last_insnavgeod_->vn_vu_cov;
+                    if (validValue(last_insnavgeod_->ve_vu_cov))
                         Cov_vel_n(2, 1) = Cov_vel_n(1, 2) =
-                            -last_insnavgeod_.ve_vu_cov;
+                            -last_insnavgeod_->ve_vu_cov;
                 }
             } else
             {
@@ -526,20 +561,20 @@ io_comm_rx::RxMessage::TwistCallback(bool fromIns /* = false*/)
 
     } else
     {
-        msg.header = last_pvtgeodetic_.header;
+        msg.header = last_pvtgeodetic_->header;
 
-        if (last_pvtgeodetic_.error == 0)
+        if (last_pvtgeodetic_->error == 0)
         {
             // Linear velocity in navigation frame
             double ve = 0.0;
-            if (validValue(last_pvtgeodetic_.ve))
-                ve = last_pvtgeodetic_.ve;
+            if (validValue(last_pvtgeodetic_->ve))
+                ve = last_pvtgeodetic_->ve;
             double vn = 0.0;
-            if (validValue(last_pvtgeodetic_.vn))
-                vn = last_pvtgeodetic_.vn;
+            if (validValue(last_pvtgeodetic_->vn))
+                vn = last_pvtgeodetic_->vn;
             double vu = 0.0;
-            if (validValue(last_pvtgeodetic_.vu))
-                vu = last_pvtgeodetic_.vu;
+            if (validValue(last_pvtgeodetic_->vu))
+                vu = last_pvtgeodetic_->vu;
             Eigen::Vector3d vel;
             if (settings_->use_ros_axis_orientation)
             {
@@ -561,38 +596,38 @@ io_comm_rx::RxMessage::TwistCallback(bool fromIns /* = false*/)
             msg.twist.twist.linear.z = std::numeric_limits<double>::quiet_NaN();
         }
 
-        if (last_velcovgeodetic_.error == 0)
+        if (last_velcovgeodetic_->error == 0)
         {
             Eigen::Matrix3d Cov_vel_n = Eigen::Matrix3d::Zero();
             // Linear velocity covariance in navigation frame
-            if (validValue(last_velcovgeodetic_.cov_veve))
+            if (validValue(last_velcovgeodetic_->cov_veve))
                 if (settings_->use_ros_axis_orientation)
-                    Cov_vel_n(0, 0) = last_velcovgeodetic_.cov_veve;
+                    Cov_vel_n(0, 0) = last_velcovgeodetic_->cov_veve;
                 else
-                    Cov_vel_n(1, 1) = last_velcovgeodetic_.cov_veve;
+                    Cov_vel_n(1, 1) = last_velcovgeodetic_->cov_veve;
             else
                 Cov_vel_n(0, 0) = -1.0;
-            if (validValue(last_velcovgeodetic_.cov_vnvn))
+            if (validValue(last_velcovgeodetic_->cov_vnvn))
                 if (settings_->use_ros_axis_orientation)
-                    Cov_vel_n(1, 1) = last_velcovgeodetic_.cov_vnvn;
+                    Cov_vel_n(1, 1) = last_velcovgeodetic_->cov_vnvn;
                 else
-                    Cov_vel_n(0, 0) = last_velcovgeodetic_.cov_vnvn;
+                    Cov_vel_n(0, 0) = last_velcovgeodetic_->cov_vnvn;
             else
                 Cov_vel_n(1, 1) = -1.0;
-            if (validValue(last_velcovgeodetic_.cov_vuvu))
-                Cov_vel_n(2, 2) = last_velcovgeodetic_.cov_vuvu;
+            if (validValue(last_velcovgeodetic_->cov_vuvu))
+                Cov_vel_n(2, 2) = last_velcovgeodetic_->cov_vuvu;
             else
                 Cov_vel_n(2, 2) = -1.0;
 
-            Cov_vel_n(0, 1) = Cov_vel_n(1, 0) = last_velcovgeodetic_.cov_vnve;
+            Cov_vel_n(0, 1) = Cov_vel_n(1, 0) = last_velcovgeodetic_->cov_vnve;
             if (settings_->use_ros_axis_orientation)
             {
-                Cov_vel_n(0, 2) = Cov_vel_n(2, 0) = last_velcovgeodetic_.cov_vevu;
-                Cov_vel_n(2, 1) = Cov_vel_n(1, 2) = last_velcovgeodetic_.cov_vnvu;
+                Cov_vel_n(0, 2) = Cov_vel_n(2, 0) = last_velcovgeodetic_->cov_vevu;
+                Cov_vel_n(2, 1) = Cov_vel_n(1, 2) = last_velcovgeodetic_->cov_vnvu;
             } else
             {
-                Cov_vel_n(0, 2) = Cov_vel_n(2, 0) = -last_velcovgeodetic_.cov_vnvu;
-                Cov_vel_n(2, 1) = Cov_vel_n(1, 2) = -last_velcovgeodetic_.cov_vevu;
+                Cov_vel_n(0, 2) = Cov_vel_n(2, 0) = -last_velcovgeodetic_->cov_vnvu;
+                Cov_vel_n(2, 1) = Cov_vel_n(1, 2) = -last_velcovgeodetic_->cov_vevu;
             }
 
             msg.twist.covariance[0] = Cov_vel_n(0, 0);
@@ -630,59 +665,42 @@ LocalizationUtmMsg io_comm_rx::RxMessage::LocalizationUtmCallback()
 {
     LocalizationUtmMsg msg;
 
-    int zone;
-    std::string zonestring;
-    bool northernHemisphere;
     double easting;
     double northing;
     double gamma = 0.0;
-    if (fixedUtmZone_)
-    {
-        double k;
-        GeographicLib::UTMUPS::DecodeZone(*fixedUtmZone_, zone, northernHemisphere);
-        GeographicLib::UTMUPS::Forward(
-            rad2deg(last_insnavgeod_.latitude), rad2deg(last_insnavgeod_.longitude),
-            zone, northernHemisphere, easting, northing, gamma, k, zone);
-        zonestring = *fixedUtmZone_;
-    } else
-    {
-        double k;
-        GeographicLib::UTMUPS::Forward(
-            rad2deg(last_insnavgeod_.latitude), rad2deg(last_insnavgeod_.longitude),
-            zone, northernHemisphere, easting, northing, gamma, k);
-        zonestring = GeographicLib::UTMUPS::EncodeZone(zone, northernHemisphere);
-    }
-    if (settings_->lock_utm_zone && !fixedUtmZone_)
-        fixedUtmZone_ = std::make_shared<std::string>(zonestring);
+    utm_.forward(rad2deg(last_insnavgeod_->latitude),
+                 rad2deg(last_insnavgeod_->longitude), easting, northing, gamma);
+    if (settings_->lock_utm_zone)
+        utm_.lockZone();
 
     // UTM position (ENU)
     if (settings_->use_ros_axis_orientation)
     {
         msg.pose.pose.position.x = easting;
         msg.pose.pose.position.y = northing;
-        msg.pose.pose.position.z = last_insnavgeod_.height;
+        msg.pose.pose.position.z = last_insnavgeod_->height;
     } else // (NED)
     {
         msg.pose.pose.position.x = northing;
         msg.pose.pose.position.y = easting;
-        msg.pose.pose.position.z = -last_insnavgeod_.height;
+        msg.pose.pose.position.z = -last_insnavgeod_->height;
     }
 
-    msg.header.frame_id = "utm_" + zonestring;
+    msg.header.frame_id = utm_.frameId();
     if (settings_->ins_use_poi)
         msg.child_frame_id = settings_->poi_frame_id; // TODO param
     else
         msg.child_frame_id = settings_->frame_id;
 
-    if ((last_insnavgeod_.sb_list & 1) != 0)
+    if ((last_insnavgeod_->sb_list & 1) != 0)
     {
         // Position autocovariance
         msg.pose.covariance[0] =
-            parsing_utilities::square(last_insnavgeod_.longitude_std_dev);
+            parsing_utilities::square(last_insnavgeod_->longitude_std_dev);
         msg.pose.covariance[7] =
-            parsing_utilities::square(last_insnavgeod_.latitude_std_dev);
+            parsing_utilities::square(last_insnavgeod_->latitude_std_dev);
         msg.pose.covariance[14] =
-            parsing_utilities::square(last_insnavgeod_.height_std_dev);
+            parsing_utilities::square(last_insnavgeod_->height_std_dev);
     } else
     {
         msg.pose.covariance[0] = -1.0;
@@ -692,14 +710,14 @@ LocalizationUtmMsg io_comm_rx::RxMessage::LocalizationUtmCallback()
 
     // Euler angles
     double roll = 0.0;
-    if (validValue(last_insnavgeod_.roll))
-        roll = deg2rad(last_insnavgeod_.roll);
+    if (validValue(last_insnavgeod_->roll))
+        roll = deg2rad(last_insnavgeod_->roll);
     double pitch = 0.0;
-    if (validValue(last_insnavgeod_.pitch))
-        pitch = deg2rad(last_insnavgeod_.pitch);
+    if (validValue(last_insnavgeod_->pitch))
+        pitch = deg2rad(last_insnavgeod_->pitch);
     double yaw = 0.0;
-    if (validValue(last_insnavgeod_.heading))
-        yaw = deg2rad(last_insnavgeod_.heading);
+    if (validValue(last_insnavgeod_->heading))
+        yaw = deg2rad(last_insnavgeod_->heading);
     // gamma for conversion from true north to grid north
     if (settings_->use_ros_axis_orientation)
         yaw -= deg2rad(gamma);
@@ -707,7 +725,7 @@ LocalizationUtmMsg io_comm_rx::RxMessage::LocalizationUtmCallback()
         yaw += deg2rad(gamma);
 
     Eigen::Matrix3d R_n_b = parsing_utilities::rpyToRot(roll, pitch, yaw).inverse();
-    if ((last_insnavgeod_.sb_list & 2) != 0)
+    if ((last_insnavgeod_->sb_list & 2) != 0)
     {
         // Attitude
         msg.pose.pose.orientation =
@@ -719,22 +737,22 @@ LocalizationUtmMsg io_comm_rx::RxMessage::LocalizationUtmCallback()
         msg.pose.pose.orientation.y = std::numeric_limits<double>::quiet_NaN();
         msg.pose.pose.orientation.z = std::numeric_limits<double>::quiet_NaN();
     }
-    if ((last_insnavgeod_.sb_list & 4) != 0)
+    if ((last_insnavgeod_->sb_list & 4) != 0)
     {
         // Attitude autocovariance
-        if (validValue(last_insnavgeod_.roll_std_dev))
+        if (validValue(last_insnavgeod_->roll_std_dev))
             msg.pose.covariance[21] =
-                parsing_utilities::square(deg2rad(last_insnavgeod_.roll_std_dev));
+                parsing_utilities::square(deg2rad(last_insnavgeod_->roll_std_dev));
         else
             msg.pose.covariance[21] = -1.0;
-        if (validValue(last_insnavgeod_.pitch_std_dev))
+        if (validValue(last_insnavgeod_->pitch_std_dev))
             msg.pose.covariance[28] =
-                parsing_utilities::square(deg2rad(last_insnavgeod_.pitch_std_dev));
+                parsing_utilities::square(deg2rad(last_insnavgeod_->pitch_std_dev));
         else
             msg.pose.covariance[28] = -1.0;
-        if (validValue(last_insnavgeod_.heading_std_dev))
-            msg.pose.covariance[35] =
-                parsing_utilities::square(deg2rad(last_insnavgeod_.heading_std_dev));
+        if (validValue(last_insnavgeod_->heading_std_dev))
+            msg.pose.covariance[35] = parsing_utilities::square(
+                deg2rad(last_insnavgeod_->heading_std_dev));
         else
             msg.pose.covariance[35] = -1.0;
     } else
@@ -743,18 +761,18 @@ LocalizationUtmMsg io_comm_rx::RxMessage::LocalizationUtmCallback()
         msg.pose.covariance[28] = -1.0;
         msg.pose.covariance[35] = -1.0;
     }
-    if ((last_insnavgeod_.sb_list & 8) != 0)
+    if ((last_insnavgeod_->sb_list & 8) != 0)
     {
         // Linear velocity (ENU)
         double ve = 0.0;
-        if (validValue(last_insnavgeod_.ve))
-            ve = last_insnavgeod_.ve;
+        if (validValue(last_insnavgeod_->ve))
+            ve = last_insnavgeod_->ve;
         double vn = 0.0;
-        if (validValue(last_insnavgeod_.vn))
-            vn = last_insnavgeod_.vn;
+        if (validValue(last_insnavgeod_->vn))
+            vn = last_insnavgeod_->vn;
         double vu = 0.0;
-        if (validValue(last_insnavgeod_.vu))
-            vu = last_insnavgeod_.vu;
+        if (validValue(last_insnavgeod_->vu))
+            vu = last_insnavgeod_->vu;
         Eigen::Vector3d vel_enu;
         if (settings_->use_ros_axis_orientation)
         {
@@ -777,29 +795,30 @@ LocalizationUtmMsg io_comm_rx::RxMessage::LocalizationUtmCallback()
         msg.twist.twist.linear.z = std::numeric_limits<double>::quiet_NaN();
     }
     Eigen::Matrix3d Cov_vel_n = Eigen::Matrix3d::Zero();
-    if ((last_insnavgeod_.sb_list & 16) != 0)
+    if ((last_insnavgeod_->sb_list & 16) != 0)
     {
         // Linear velocity autocovariance
-        if (validValue(last_insnavgeod_.ve_std_dev))
+        if (validValue(last_insnavgeod_->ve_std_dev))
             if (settings_->use_ros_axis_orientation)
                 Cov_vel_n(0, 0) =
-                    parsing_utilities::square(last_insnavgeod_.ve_std_dev);
+                    parsing_utilities::square(last_insnavgeod_->ve_std_dev);
             else
                 Cov_vel_n(0, 0) =
-                    parsing_utilities::square(last_insnavgeod_.vn_std_dev);
+                    parsing_utilities::square(last_insnavgeod_->vn_std_dev);
         else
             Cov_vel_n(0, 0) = -1.0;
-        if (validValue(last_insnavgeod_.vn_std_dev))
+        if (validValue(last_insnavgeod_->vn_std_dev))
             if (settings_->use_ros_axis_orientation)
                 Cov_vel_n(1, 1) =
-                    parsing_utilities::square(last_insnavgeod_.vn_std_dev);
+                    parsing_utilities::square(last_insnavgeod_->vn_std_dev);
             else
                 Cov_vel_n(1, 1) =
-                    parsing_utilities::square(last_insnavgeod_.ve_std_dev);
+                    parsing_utilities::square(last_insnavgeod_->ve_std_dev);
         else
             Cov_vel_n(1, 1) = -1.0;
-        if (validValue(last_insnavgeod_.vu_std_dev))
-            Cov_vel_n(2, 2) = parsing_utilities::square(last_insnavgeod_.vu_std_dev);
+        if (validValue(last_insnavgeod_->vu_std_dev))
+            Cov_vel_n(2, 2) =
+                parsing_utilities::square(last_insnavgeod_->vu_std_dev);
         else
             Cov_vel_n(2, 2) = -1.0;
     } else
@@ -808,38 +827,38 @@ LocalizationUtmMsg io_comm_rx::RxMessage::LocalizationUtmCallback()
         Cov_vel_n(1, 1) = -1.0;
         Cov_vel_n(2, 2) = -1.0;
     }
-    if ((last_insnavgeod_.sb_list & 32) != 0)
+    if ((last_insnavgeod_->sb_list & 32) != 0)
     {
         // Position covariance
-        msg.pose.covariance[1] = last_insnavgeod_.latitude_longitude_cov;
-        msg.pose.covariance[6] = last_insnavgeod_.latitude_longitude_cov;
+        msg.pose.covariance[1] = last_insnavgeod_->latitude_longitude_cov;
+        msg.pose.covariance[6] = last_insnavgeod_->latitude_longitude_cov;
 
         if (settings_->use_ros_axis_orientation)
         {
             // (ENU)
-            msg.pose.covariance[2] = last_insnavgeod_.longitude_height_cov;
-            msg.pose.covariance[8] = last_insnavgeod_.latitude_height_cov;
-            msg.pose.covariance[12] = last_insnavgeod_.longitude_height_cov;
-            msg.pose.covariance[13] = last_insnavgeod_.latitude_height_cov;
+            msg.pose.covariance[2] = last_insnavgeod_->longitude_height_cov;
+            msg.pose.covariance[8] = last_insnavgeod_->latitude_height_cov;
+            msg.pose.covariance[12] = last_insnavgeod_->longitude_height_cov;
+            msg.pose.covariance[13] = last_insnavgeod_->latitude_height_cov;
         } else
         {
             // (NED)
-            msg.pose.covariance[2] = -last_insnavgeod_.latitude_height_cov;
-            msg.pose.covariance[8] = -last_insnavgeod_.longitude_height_cov;
-            msg.pose.covariance[12] = -last_insnavgeod_.latitude_height_cov;
-            msg.pose.covariance[13] = -last_insnavgeod_.longitude_height_cov;
+            msg.pose.covariance[2] = -last_insnavgeod_->latitude_height_cov;
+            msg.pose.covariance[8] = -last_insnavgeod_->longitude_height_cov;
+            msg.pose.covariance[12] = -last_insnavgeod_->latitude_height_cov;
+            msg.pose.covariance[13] = -last_insnavgeod_->longitude_height_cov;
         }
     }
-    if ((last_insnavgeod_.sb_list & 64) != 0)
+    if ((last_insnavgeod_->sb_list & 64) != 0)
     {
         // Attitude covariancae
-        msg.pose.covariance[22] = deg2radSq(last_insnavgeod_.pitch_roll_cov);
-        msg.pose.covariance[23] = deg2radSq(last_insnavgeod_.heading_roll_cov);
-        msg.pose.covariance[27] = deg2radSq(last_insnavgeod_.pitch_roll_cov);
+        msg.pose.covariance[22] = deg2radSq(last_insnavgeod_->pitch_roll_cov);
+        msg.pose.covariance[23] = deg2radSq(last_insnavgeod_->heading_roll_cov);
+        msg.pose.covariance[27] = deg2radSq(last_insnavgeod_->pitch_roll_cov);
 
-        msg.pose.covariance[29] = deg2radSq(last_insnavgeod_.heading_pitch_cov);
-        msg.pose.covariance[33] = deg2radSq(last_insnavgeod_.heading_roll_cov);
-        msg.pose.covariance[34] = deg2radSq(last_insnavgeod_.heading_pitch_cov);
+        msg.pose.covariance[29] = deg2radSq(last_insnavgeod_->heading_pitch_cov);
+        msg.pose.covariance[33] = deg2radSq(last_insnavgeod_->heading_roll_cov);
+        msg.pose.covariance[34] = deg2radSq(last_insnavgeod_->heading_pitch_cov);
 
         if (!settings_->use_ros_axis_orientation)
         {
@@ -850,26 +869,26 @@ LocalizationUtmMsg io_comm_rx::RxMessage::LocalizationUtmCallback()
             msg.pose.covariance[27] *= -1.0;
         }
     }
-    if ((last_insnavgeod_.sb_list & 128) != 0)
+    if ((last_insnavgeod_->sb_list & 128) != 0)
     {
-        Cov_vel_n(0, 1) = Cov_vel_n(1, 0) = last_insnavgeod_.ve_vn_cov;
+        Cov_vel_n(0, 1) = Cov_vel_n(1, 0) = last_insnavgeod_->ve_vn_cov;
         if (settings_->use_ros_axis_orientation)
         {
-            Cov_vel_n(0, 2) = Cov_vel_n(2, 0) = last_insnavgeod_.ve_vu_cov;
-            Cov_vel_n(2, 1) = Cov_vel_n(1, 2) = last_insnavgeod_.vn_vu_cov;
+            Cov_vel_n(0, 2) = Cov_vel_n(2, 0) = last_insnavgeod_->ve_vu_cov;
+            Cov_vel_n(2, 1) = Cov_vel_n(1, 2) = last_insnavgeod_->vn_vu_cov;
         } else
         {
-            Cov_vel_n(0, 2) = Cov_vel_n(2, 0) = -last_insnavgeod_.vn_vu_cov;
-            Cov_vel_n(2, 1) = Cov_vel_n(1, 2) = -last_insnavgeod_.ve_vu_cov;
+            Cov_vel_n(0, 2) = Cov_vel_n(2, 0) = -last_insnavgeod_->vn_vu_cov;
+            Cov_vel_n(2, 1) = Cov_vel_n(1, 2) = -last_insnavgeod_->ve_vu_cov;
         }
     }
 
-    if (((last_insnavgeod_.sb_list & 16) != 0) &&
-        ((last_insnavgeod_.sb_list & 2) != 0) &&
-        ((last_insnavgeod_.sb_list & 8) != 0) &&
-        validValue(last_insnavgeod_.ve_std_dev) &&
-        validValue(last_insnavgeod_.vn_std_dev) &&
-        validValue(last_insnavgeod_.vu_std_dev))
+    if (((last_insnavgeod_->sb_list & 16) != 0) &&
+        ((last_insnavgeod_->sb_list & 2) != 0) &&
+        ((last_insnavgeod_->sb_list & 8) != 0) &&
+        validValue(last_insnavgeod_->ve_std_dev) &&
+        validValue(last_insnavgeod_->vn_std_dev) &&
+        validValue(last_insnavgeod_->vu_std_dev))
     {
         // Rotate covariance matrix to body coordinates
         Eigen::Matrix3d Cov_vel_body = R_n_b * Cov_vel_n * R_n_b.transpose();
@@ -909,7 +928,7 @@ NavSatFixMsg io_comm_rx::RxMessage::NavSatFixCallback()
     uint16_t mask = 15; // We extract the first four bits using this mask.
     if (settings_->septentrio_receiver_type == "gnss")
     {
-        uint16_t type_of_pvt = ((uint16_t)(last_pvtgeodetic_.mode)) & mask;
+        uint16_t type_of_pvt = ((uint16_t)(last_pvtgeodetic_->mode)) & mask;
         switch (type_of_pvt_map[type_of_pvt])
         {
         case evNoPVT:
@@ -953,7 +972,7 @@ NavSatFixMsg io_comm_rx::RxMessage::NavSatFixCallback()
         uint32_t mask_2 = 1;
         for (int bit = 0; bit != 31; ++bit)
         {
-            bool in_use = last_pvtgeodetic_.signal_info & mask_2;
+            bool in_use = last_pvtgeodetic_->signal_info & mask_2;
             if (bit <= 5 && in_use)
             {
                 gps_in_pvt = true;
@@ -970,18 +989,18 @@ NavSatFixMsg io_comm_rx::RxMessage::NavSatFixCallback()
         uint16_t service =
             gps_in_pvt * 1 + glo_in_pvt * 2 + com_in_pvt * 4 + gal_in_pvt * 8;
         msg.status.service = service;
-        msg.latitude = rad2deg(last_pvtgeodetic_.latitude);
-        msg.longitude = rad2deg(last_pvtgeodetic_.longitude);
-        msg.altitude = last_pvtgeodetic_.height;
-        msg.position_covariance[0] = last_poscovgeodetic_.cov_lonlon;
-        msg.position_covariance[1] = last_poscovgeodetic_.cov_latlon;
-        msg.position_covariance[2] = last_poscovgeodetic_.cov_lonhgt;
-        msg.position_covariance[3] = last_poscovgeodetic_.cov_latlon;
-        msg.position_covariance[4] = last_poscovgeodetic_.cov_latlat;
-        msg.position_covariance[5] = last_poscovgeodetic_.cov_lathgt;
-        msg.position_covariance[6] = last_poscovgeodetic_.cov_lonhgt;
-        msg.position_covariance[7] = last_poscovgeodetic_.cov_lathgt;
-        msg.position_covariance[8] = last_poscovgeodetic_.cov_hgthgt;
+        msg.latitude = rad2deg(last_pvtgeodetic_->latitude);
+        msg.longitude = rad2deg(last_pvtgeodetic_->longitude);
+        msg.altitude = last_pvtgeodetic_->height;
+        msg.position_covariance[0] = last_poscovgeodetic_->cov_lonlon;
+        msg.position_covariance[1] = last_poscovgeodetic_->cov_latlon;
+        msg.position_covariance[2] = last_poscovgeodetic_->cov_lonhgt;
+        msg.position_covariance[3] = last_poscovgeodetic_->cov_latlon;
+        msg.position_covariance[4] = last_poscovgeodetic_->cov_latlat;
+        msg.position_covariance[5] = last_poscovgeodetic_->cov_lathgt;
+        msg.position_covariance[6] = last_poscovgeodetic_->cov_lonhgt;
+        msg.position_covariance[7] = last_poscovgeodetic_->cov_lathgt;
+        msg.position_covariance[8] = last_poscovgeodetic_->cov_hgthgt;
         msg.position_covariance_type = NavSatFixMsg::COVARIANCE_TYPE_KNOWN;
         return msg;
     }
@@ -989,7 +1008,7 @@ NavSatFixMsg io_comm_rx::RxMessage::NavSatFixCallback()
     if (settings_->septentrio_receiver_type == "ins")
     {
         NavSatFixMsg msg;
-        uint16_t type_of_pvt = ((uint16_t)(last_insnavgeod_.gnss_mode)) & mask;
+        uint16_t type_of_pvt = ((uint16_t)(last_insnavgeod_->gnss_mode)) & mask;
         switch (type_of_pvt_map[type_of_pvt])
         {
         case evNoPVT:
@@ -1033,7 +1052,7 @@ NavSatFixMsg io_comm_rx::RxMessage::NavSatFixCallback()
         uint32_t mask_2 = 1;
         for (int bit = 0; bit != 31; ++bit)
         {
-            bool in_use = last_pvtgeodetic_.signal_info & mask_2;
+            bool in_use = last_pvtgeodetic_->signal_info & mask_2;
             if (bit <= 5 && in_use)
             {
                 gps_in_pvt = true;
@@ -1050,27 +1069,27 @@ NavSatFixMsg io_comm_rx::RxMessage::NavSatFixCallback()
         uint16_t service =
             gps_in_pvt * 1 + glo_in_pvt * 2 + com_in_pvt * 4 + gal_in_pvt * 8;
         msg.status.service = service;
-        msg.latitude = rad2deg(last_insnavgeod_.latitude);
-        msg.longitude = rad2deg(last_insnavgeod_.longitude);
-        msg.altitude = last_insnavgeod_.height;
+        msg.latitude = rad2deg(last_insnavgeod_->latitude);
+        msg.longitude = rad2deg(last_insnavgeod_->longitude);
+        msg.altitude = last_insnavgeod_->height;
 
-        if ((last_insnavgeod_.sb_list & 1) != 0)
+        if ((last_insnavgeod_->sb_list & 1) != 0)
         {
             msg.position_covariance[0] =
-                parsing_utilities::square(last_insnavgeod_.longitude_std_dev);
+                parsing_utilities::square(last_insnavgeod_->longitude_std_dev);
             msg.position_covariance[4] =
-                parsing_utilities::square(last_insnavgeod_.latitude_std_dev);
+                parsing_utilities::square(last_insnavgeod_->latitude_std_dev);
             msg.position_covariance[8] =
-                parsing_utilities::square(last_insnavgeod_.height_std_dev);
+                parsing_utilities::square(last_insnavgeod_->height_std_dev);
         }
-        if ((last_insnavgeod_.sb_list & 32) != 0)
+        if ((last_insnavgeod_->sb_list & 32) != 0)
         {
-            msg.position_covariance[1] = last_insnavgeod_.latitude_longitude_cov;
-            msg.position_covariance[2] = last_insnavgeod_.longitude_height_cov;
-            msg.position_covariance[3] = last_insnavgeod_.latitude_longitude_cov;
-            msg.position_covariance[5] = last_insnavgeod_.latitude_height_cov;
-            msg.position_covariance[6] = last_insnavgeod_.longitude_height_cov;
-            msg.position_covariance[7] = last_insnavgeod_.latitude_height_cov;
+            msg.position_covariance[1] = last_insnavgeod_->latitude_longitude_cov;
+            msg.position_covariance[2] = last_insnavgeod_->longitude_height_cov;
+            msg.position_covariance[3] = last_insnavgeod_->latitude_longitude_cov;
+            msg.position_covariance[5] = last_insnavgeod_->latitude_height_cov;
+            msg.position_covariance[6] = last_insnavgeod_->longitude_height_cov;
+            msg.position_covariance[7] = last_insnavgeod_->latitude_height_cov;
         }
         msg.position_covariance_type = NavSatFixMsg::COVARIANCE_TYPE_DIAGONAL_KNOWN;
     }
@@ -1084,7 +1103,7 @@ NavSatFixMsg io_comm_rx::RxMessage::NavSatFixCallback()
  * receivers. We assume that for the ROS field "err_time", we are requested to
  * provide the 2 sigma uncertainty on the clock bias estimate in square meters, not
  * the clock drift estimate (latter would be
- * "2*std::sqrt(last_velcovgeodetic_.Cov_DtDt)").
+ * "2*std::sqrt(last_velcovgeodetic_->Cov_DtDt)").
  * The "err_track" entry is calculated via the Gaussian error propagation formula
  * from the eastward and the northward velocities. For the formula's usage we have to
  * assume that the eastward and the northward velocities are independent variables.
@@ -1098,18 +1117,35 @@ NavSatFixMsg io_comm_rx::RxMessage::NavSatFixCallback()
  * values appear unphysical, please consult the firmware, since those most likely
  * refer to Do-Not-Use values.
  */
-GPSFixMsg io_comm_rx::RxMessage::GPSFixCallback()
+void io_comm_rx::RxMessage::GPSFixCallback(GPSFixMsg& msg)
 {
-    GPSFixMsg msg;
-    msg.status.satellites_used = static_cast<uint16_t>(last_pvtgeodetic_.nr_sv);
+    // Reset the message, keeping the capacity of its satellite arrays
+    std::vector<int32_t> svid_pvt = std::move(msg.status.satellite_used_prn);
+    std::vector<int32_t> svid_in_sync_2 =
+        std::move(msg.status.satellite_visible_prn);
+    std::vector<int32_t> elevation_tracked =
+        std::move(msg.status.satellite_visible_z);
+    std::vector<int32_t> azimuth_tracked =
+        std::move(msg.status.satellite_visible_azimuth);
+    std::vector<int32_t> cno_tracked_reordered =
+        std::move(msg.status.satellite_visible_snr);
+    svid_pvt.clear();
+    svid_in_sync_2.clear();
+    elevation_tracked.clear();
+    azimuth_tracked.clear();
+    cno_tracked_reordered.clear();
+    msg = GPSFixMsg();
+    msg.status.satellites_used = static_cast<uint16_t>(last_pvtgeodetic_->nr_sv);
 
     // MeasEpoch Processing
-    std::vector<int32_t> cno_tracked;
-    std::vector<int32_t> svid_in_sync;
+    std::vector<int32_t>& cno_tracked = gpsfix_scratch_.cno_tracked;
+    std::vector<int32_t>& svid_in_sync = gpsfix_scratch_.svid_in_sync;
+    cno_tracked.clear();
+    svid_in_sync.clear();
     {
-        cno_tracked.reserve(last_measepoch_.type1.size());
-        svid_in_sync.reserve(last_measepoch_.type1.size());
-        for (const auto& measepoch_channel_type1 : last_measepoch_.type1)
+        cno_tracked.reserve(last_measepoch_->type1.size());
+        svid_in_sync.reserve(last_measepoch_->type1.size());
+        for (const auto& measepoch_channel_type1 : last_measepoch_->type1)
         {
             // Define MeasEpochChannelType1 struct for the corresponding sub-block
             svid_in_sync.push_back(
@@ -1133,12 +1169,8 @@ GPSFixMsg io_comm_rx::RxMessage::GPSFixCallback()
     }
 
     // ChannelStatus Processing
-    std::vector<int32_t> svid_in_sync_2;
-    std::vector<int32_t> elevation_tracked;
-    std::vector<int32_t> azimuth_tracked;
-    std::vector<int32_t> svid_pvt;
-    svid_pvt.clear();
-    std::vector<int32_t> ordering;
+    std::vector<int32_t>& ordering = gpsfix_scratch_.ordering;
+    ordering.clear();
     {
         svid_in_sync_2.reserve(last_channelstatus_.satInfo.size());
         elevation_tracked.reserve(last_channelstatus_.satInfo.size());
@@ -1193,16 +1225,15 @@ GPSFixMsg io_comm_rx::RxMessage::GPSFixCallback()
             }
         }
     }
-    msg.status.satellite_used_prn =
-        svid_pvt; // Entries such as int32[] in ROS messages are to be treated as
-                  // std::vectors.
+    // Entries such as int32[] in ROS messages are std::vectors, which are moved
+    // into the message rather than copied
+    msg.status.satellite_used_prn = std::move(svid_pvt);
     msg.status.satellites_visible = static_cast<uint16_t>(svid_in_sync.size());
-    msg.status.satellite_visible_prn = svid_in_sync_2;
-    msg.status.satellite_visible_z = elevation_tracked;
-    msg.status.satellite_visible_azimuth = azimuth_tracked;
+    msg.status.satellite_visible_prn = std::move(svid_in_sync_2);
+    msg.status.satellite_visible_z = std::move(elevation_tracked);
+    msg.status.satellite_visible_azimuth = std::move(azimuth_tracked);
 
     // Reordering CNO vector to that of all previous arrays
-    std::vector<int32_t> cno_tracked_reordered;
     if (static_cast<int32_t>(last_channelstatus_.n) != 0)
     {
         for (int32_t k = 0; k < static_cast<int32_t>(ordering.size()); ++k)
@@ -1210,15 +1241,15 @@ GPSFixMsg io_comm_rx::RxMessage::GPSFixCallback()
             cno_tracked_reordered.push_back(cno_tracked[ordering[k]]);
         }
     }
-    msg.status.satellite_visible_snr = cno_tracked_reordered;
-    msg.err_time = 2 * std::sqrt(last_poscovgeodetic_.cov_bb);
+    msg.status.satellite_visible_snr = std::move(cno_tracked_reordered);
+    msg.err_time = 2 * std::sqrt(last_poscovgeodetic_->cov_bb);
 
     if (settings_->septentrio_receiver_type == "gnss")
     {
 
         // PVT Status Analysis
         uint16_t status_mask = 15; // We extract the first four bits using this mask.
-        uint16_t type_of_pvt = ((uint16_t)(last_pvtgeodetic_.mode)) & status_mask;
+        uint16_t type_of_pvt = ((uint16_t)(last_pvtgeodetic_->mode)) & status_mask;
         switch (type_of_pvt_map[type_of_pvt])
         {
         case evNoPVT:
@@ -1244,7 +1275,7 @@ GPSFixMsg io_comm_rx::RxMessage::GPSFixCallback()
         }
         case evSBAS:
         {
-            uint16_t reference_id = last_pvtgeodetic_.reference_id;
+            uint16_t reference_id = last_pvtgeodetic_->reference_id;
             // Here come the PRNs of the 4 WAAS satellites..
             if (reference_id == 131 || reference_id == 133 || reference_id == 135 ||
                 reference_id == 135)
@@ -1271,16 +1302,16 @@ GPSFixMsg io_comm_rx::RxMessage::GPSFixCallback()
         // hence:
         msg.status.orientation_source = GPSStatusMsg::SOURCE_POINTS;
         msg.status.position_source = GPSStatusMsg::SOURCE_GPS;
-        msg.latitude = rad2deg(last_pvtgeodetic_.latitude);
-        msg.longitude = rad2deg(last_pvtgeodetic_.longitude);
-        msg.altitude = last_pvtgeodetic_.height;
+        msg.latitude = rad2deg(last_pvtgeodetic_->latitude);
+        msg.longitude = rad2deg(last_pvtgeodetic_->longitude);
+        msg.altitude = last_pvtgeodetic_->height;
         // Note that cog is of type float32 while track is of type float64.
-        msg.track = last_pvtgeodetic_.cog;
-        msg.speed = std::sqrt(parsing_utilities::square(last_pvtgeodetic_.vn) +
-                              parsing_utilities::square(last_pvtgeodetic_.ve));
-        msg.climb = last_pvtgeodetic_.vu;
-        msg.pitch = last_atteuler_.pitch;
-        msg.roll = last_atteuler_.roll;
+        msg.track = last_pvtgeodetic_->cog;
+        msg.speed = std::sqrt(parsing_utilities::square(last_pvtgeodetic_->vn) +
+                              parsing_utilities::square(last_pvtgeodetic_->ve));
+        msg.climb = last_pvtgeodetic_->vu;
+        msg.pitch = last_atteuler_->pitch;
+        msg.roll = last_atteuler_->roll;
         if (last_dop_.pdop == 0.0 || last_dop_.tdop == 0.0)
         {
             msg.gdop = -1.0;
@@ -1317,48 +1348,48 @@ GPSFixMsg io_comm_rx::RxMessage::GPSFixCallback()
         {
             msg.tdop = last_dop_.tdop;
         }
-        msg.time = static_cast<double>(last_pvtgeodetic_.block_header.tow) / 1000 +
-                   static_cast<double>(last_pvtgeodetic_.block_header.wnc * 7 * 24 *
+        msg.time = static_cast<double>(last_pvtgeodetic_->block_header.tow) / 1000 +
+                   static_cast<double>(last_pvtgeodetic_->block_header.wnc * 7 * 24 *
                                        60 * 60);
         msg.err =
-            2 * (std::sqrt(static_cast<double>(last_poscovgeodetic_.cov_latlat) +
-                           static_cast<double>(last_poscovgeodetic_.cov_lonlon) +
-                           static_cast<double>(last_poscovgeodetic_.cov_hgthgt)));
+            2 * (std::sqrt(static_cast<double>(last_poscovgeodetic_->cov_latlat) +
+                           static_cast<double>(last_poscovgeodetic_->cov_lonlon) +
+                           static_cast<double>(last_poscovgeodetic_->cov_hgthgt)));
         msg.err_horz =
-            2 * (std::sqrt(static_cast<double>(last_poscovgeodetic_.cov_latlat) +
-                           static_cast<double>(last_poscovgeodetic_.cov_lonlon)));
+            2 * (std::sqrt(static_cast<double>(last_poscovgeodetic_->cov_latlat) +
+                           static_cast<double>(last_poscovgeodetic_->cov_lonlon)));
         msg.err_vert =
-            2 * std::sqrt(static_cast<double>(last_poscovgeodetic_.cov_hgthgt));
+            2 * std::sqrt(static_cast<double>(last_poscovgeodetic_->cov_hgthgt));
         msg.err_track =
             2 *
             (std::sqrt(parsing_utilities::square(
-                           1.0 / (last_pvtgeodetic_.vn +
-                                  parsing_utilities::square(last_pvtgeodetic_.ve) /
-                                      last_pvtgeodetic_.vn)) *
-                           last_poscovgeodetic_.cov_lonlon +
+                           1.0 / (last_pvtgeodetic_->vn +
+                                  parsing_utilities::square(last_pvtgeodetic_->ve) /
+                                      last_pvtgeodetic_->vn)) *
+                           last_poscovgeodetic_->cov_lonlon +
                        parsing_utilities::square(
-                           (last_pvtgeodetic_.ve) /
-                           (parsing_utilities::square(last_pvtgeodetic_.vn) +
-                            parsing_utilities::square(last_pvtgeodetic_.ve))) *
-                           last_poscovgeodetic_.cov_latlat));
+                           (last_pvtgeodetic_->ve) /
+                           (parsing_utilities::square(last_pvtgeodetic_->vn) +
+                            parsing_utilities::square(last_pvtgeodetic_->ve))) *
+                           last_poscovgeodetic_->cov_latlat));
         msg.err_speed =
-            2 * (std::sqrt(static_cast<double>(last_velcovgeodetic_.cov_vnvn) +
-                           static_cast<double>(last_velcovgeodetic_.cov_veve)));
+            2 * (std::sqrt(static_cast<double>(last_velcovgeodetic_->cov_vnvn) +
+                           static_cast<double>(last_velcovgeodetic_->cov_veve)));
         msg.err_climb =
-            2 * std::sqrt(static_cast<double>(last_velcovgeodetic_.cov_vuvu));
+            2 * std::sqrt(static_cast<double>(last_velcovgeodetic_->cov_vuvu));
         msg.err_pitch =
-            2 * std::sqrt(static_cast<double>(last_attcoveuler_.cov_pitchpitch));
+            2 * std::sqrt(static_cast<double>(last_attcoveuler_->cov_pitchpitch));
         msg.err_roll =
-            2 * std::sqrt(static_cast<double>(last_attcoveuler_.cov_rollroll));
-        msg.position_covariance[0] = last_poscovgeodetic_.cov_lonlon;
-        msg.position_covariance[1] = last_poscovgeodetic_.cov_latlon;
-        msg.position_covariance[2] = last_poscovgeodetic_.cov_lonhgt;
-        msg.position_covariance[3] = last_poscovgeodetic_.cov_latlon;
-        msg.position_covariance[4] = last_poscovgeodetic_.cov_latlat;
-        msg.position_covariance[5] = last_poscovgeodetic_.cov_lathgt;
-        msg.position_covariance[6] = last_poscovgeodetic_.cov_lonhgt;
-        msg.position_covariance[7] = last_poscovgeodetic_.cov_lathgt;
-        msg.position_covariance[8] = last_poscovgeodetic_.cov_hgthgt;
+            2 * std::sqrt(static_cast<double>(last_attcoveuler_->cov_rollroll));
+        msg.position_covariance[0] = last_poscovgeodetic_->cov_lonlon;
+        msg.position_covariance[1] = last_poscovgeodetic_->cov_latlon;
+        msg.position_covariance[2] = last_poscovgeodetic_->cov_lonhgt;
+        msg.position_covariance[3] = last_poscovgeodetic_->cov_latlon;
+        msg.position_covariance[4] = last_poscovgeodetic_->cov_latlat;
+        msg.position_covariance[5] = last_poscovgeodetic_->cov_lathgt;
+        msg.position_covariance[6] = last_poscovgeodetic_->cov_lonhgt;
+        msg.position_covariance[7] = last_poscovgeodetic_->cov_lathgt;
+        msg.position_covariance[8] = last_poscovgeodetic_->cov_hgthgt;
         msg.position_covariance_type = NavSatFixMsg::COVARIANCE_TYPE_KNOWN;
     }
 
@@ -1367,7 +1398,7 @@ GPSFixMsg io_comm_rx::RxMessage::GPSFixCallback()
         // PVT Status Analysis
         uint16_t status_mask = 15; // We extract the first four bits using this mask.
         uint16_t type_of_pvt =
-            ((uint16_t)(last_insnavgeod_.gnss_mode)) & status_mask;
+            ((uint16_t)(last_insnavgeod_->gnss_mode)) & status_mask;
         switch (type_of_pvt_map[type_of_pvt])
         {
         case evNoPVT:
@@ -1407,22 +1438,22 @@ GPSFixMsg io_comm_rx::RxMessage::GPSFixCallback()
         // hence:
         msg.status.orientation_source = GPSStatusMsg::SOURCE_POINTS;
         msg.status.position_source = GPSStatusMsg::SOURCE_GPS;
-        msg.latitude = rad2deg(last_insnavgeod_.latitude);
-        msg.longitude = rad2deg(last_insnavgeod_.longitude);
-        msg.altitude = last_insnavgeod_.height;
+        msg.latitude = rad2deg(last_insnavgeod_->latitude);
+        msg.longitude = rad2deg(last_insnavgeod_->longitude);
+        msg.altitude = last_insnavgeod_->height;
         // Note that cog is of type float32 while track is of type float64.
-        if ((last_insnavgeod_.sb_list & 2) != 0)
+        if ((last_insnavgeod_->sb_list & 2) != 0)
         {
-            msg.track = last_insnavgeod_.heading;
-            msg.pitch = last_insnavgeod_.pitch;
-            msg.roll = last_insnavgeod_.roll;
+            msg.track = last_insnavgeod_->heading;
+            msg.pitch = last_insnavgeod_->pitch;
+            msg.roll = last_insnavgeod_->roll;
         }
-        if ((last_insnavgeod_.sb_list & 8) != 0)
+        if ((last_insnavgeod_->sb_list & 8) != 0)
         {
-            msg.speed = std::sqrt(parsing_utilities::square(last_insnavgeod_.vn) +
-                                  parsing_utilities::square(last_insnavgeod_.ve));
+            msg.speed = std::sqrt(parsing_utilities::square(last_insnavgeod_->vn) +
+                                  parsing_utilities::square(last_insnavgeod_->ve));
 
-            msg.climb = last_insnavgeod_.vu;
+            msg.climb = last_insnavgeod_->vu;
         }
         if (last_dop_.pdop == 0.0 || last_dop_.tdop == 0.0)
         {
@@ -1460,82 +1491,81 @@ GPSFixMsg io_comm_rx::RxMessage::GPSFixCallback()
         {
             msg.tdop = last_dop_.tdop;
         }
-        msg.time = static_cast<double>(last_insnavgeod_.block_header.tow) / 1000 +
-                   static_cast<double>(last_insnavgeod_.block_header.wnc * 7 * 24 *
+        msg.time = static_cast<double>(last_insnavgeod_->block_header.tow) / 1000 +
+                   static_cast<double>(last_insnavgeod_->block_header.wnc * 7 * 24 *
                                        60 * 60);
-        if ((last_insnavgeod_.sb_list & 1) != 0)
+        if ((last_insnavgeod_->sb_list & 1) != 0)
         {
             msg.err =
                 2 *
                 (std::sqrt(
-                    parsing_utilities::square(last_insnavgeod_.latitude_std_dev) +
-                    parsing_utilities::square(last_insnavgeod_.longitude_std_dev) +
-                    parsing_utilities::square(last_insnavgeod_.height_std_dev)));
+                    parsing_utilities::square(last_insnavgeod_->latitude_std_dev) +
+                    parsing_utilities::square(last_insnavgeod_->longitude_std_dev) +
+                    parsing_utilities::square(last_insnavgeod_->height_std_dev)));
             msg.err_horz =
                 2 *
                 (std::sqrt(
-                    parsing_utilities::square(last_insnavgeod_.latitude_std_dev) +
-                    parsing_utilities::square(last_insnavgeod_.longitude_std_dev)));
+                    parsing_utilities::square(last_insnavgeod_->latitude_std_dev) +
+                    parsing_utilities::square(last_insnavgeod_->longitude_std_dev)));
             msg.err_vert = 2 * (std::sqrt(parsing_utilities::square(
-                                   last_insnavgeod_.height_std_dev)));
+                                   last_insnavgeod_->height_std_dev)));
         }
-        if (((last_insnavgeod_.sb_list & 8) != 0) ||
-            ((last_insnavgeod_.sb_list & 1) != 0))
+        if (((last_insnavgeod_->sb_list & 8) != 0) ||
+            ((last_insnavgeod_->sb_list & 1) != 0))
         {
             msg.err_track =
                 2 * (std::sqrt(
                         parsing_utilities::square(
-                            1.0 / (last_insnavgeod_.vn +
-                                   parsing_utilities::square(last_insnavgeod_.ve) /
-                                       last_insnavgeod_.vn)) *
+                            1.0 / (last_insnavgeod_->vn +
+                                   parsing_utilities::square(last_insnavgeod_->ve) /
+                                       last_insnavgeod_->vn)) *
                             parsing_utilities::square(
-                                last_insnavgeod_.longitude_std_dev) +
+                                last_insnavgeod_->longitude_std_dev) +
                         parsing_utilities::square(
-                            (last_insnavgeod_.ve) /
-                            (parsing_utilities::square(last_insnavgeod_.vn) +
-                             parsing_utilities::square(last_insnavgeod_.ve))) *
+                            (last_insnavgeod_->ve) /
+                            (parsing_utilities::square(last_insnavgeod_->vn) +
+                             parsing_utilities::square(last_insnavgeod_->ve))) *
                             parsing_utilities::square(
-                                last_insnavgeod_.latitude_std_dev)));
+                                last_insnavgeod_->latitude_std_dev)));
         }
-        if ((last_insnavgeod_.sb_list & 8) != 0)
+        if ((last_insnavgeod_->sb_list & 8) != 0)
         {
             msg.err_speed =
-                2 * (std::sqrt(parsing_utilities::square(last_insnavgeod_.vn) +
-                               parsing_utilities::square(last_insnavgeod_.ve)));
+                2 * (std::sqrt(parsing_utilities::square(last_insnavgeod_->vn) +
+                               parsing_utilities::square(last_insnavgeod_->ve)));
             msg.err_climb =
-                2 * std::sqrt(parsing_utilities::square(last_insnavgeod_.vn));
+                2 * std::sqrt(parsing_utilities::square(last_insnavgeod_->vn));
         }
-        if ((last_insnavgeod_.sb_list & 2) != 0)
+        if ((last_insnavgeod_->sb_list & 2) != 0)
         {
             msg.err_pitch =
-                2 * std::sqrt(parsing_utilities::square(last_insnavgeod_.pitch));
+                2 * std::sqrt(parsing_utilities::square(last_insnavgeod_->pitch));
         }
-        if ((last_insnavgeod_.sb_list & 2) != 0)
+        if ((last_insnavgeod_->sb_list & 2) != 0)
         {
             msg.err_pitch =
-                2 * std::sqrt(parsing_utilities::square(last_insnavgeod_.roll));
+                2 * std::sqrt(parsing_utilities::square(last_insnavgeod_->roll));
         }
-        if ((last_insnavgeod_.sb_list & 1) != 0)
+        if ((last_insnavgeod_->sb_list & 1) != 0)
         {
             msg.position_covariance[0] =
-                parsing_utilities::square(last_insnavgeod_.longitude_std_dev);
+                parsing_utilities::square(last_insnavgeod_->longitude_std_dev);
             msg.position_covariance[4] =
-                parsing_utilities::square(last_insnavgeod_.latitude_std_dev);
+                parsing_utilities::square(last_insnavgeod_->latitude_std_dev);
             msg.position_covariance[8] =
-                parsing_utilities::square(last_insnavgeod_.height_std_dev);
+                parsing_utilities::square(last_insnavgeod_->height_std_dev);
         }
-        if ((last_insnavgeod_.sb_list & 32) != 0)
+        if ((last_insnavgeod_->sb_list & 32) != 0)
         {
-            msg.position_covariance[1] = last_insnavgeod_.latitude_longitude_cov;
-            msg.position_covariance[2] = last_insnavgeod_.longitude_height_cov;
-            msg.position_covariance[3] = last_insnavgeod_.latitude_longitude_cov;
-            msg.position_covariance[5] = last_insnavgeod_.latitude_height_cov;
-            msg.position_covariance[6] = last_insnavgeod_.longitude_height_cov;
-            msg.position_covariance[7] = last_insnavgeod_.latitude_height_cov;
+            msg.position_covariance[1] = last_insnavgeod_->latitude_longitude_cov;
+            msg.position_covariance[2] = last_insnavgeod_->longitude_height_cov;
+            msg.position_covariance[3] = last_insnavgeod_->latitude_longitude_cov;
+            msg.position_covariance[5] = last_insnavgeod_->latitude_height_cov;
+            msg.position_covariance[6] = last_insnavgeod_->longitude_height_cov;
+            msg.position_covariance[7] = last_insnavgeod_->latitude_height_cov;
         }
         msg.position_covariance_type = NavSatFixMsg::COVARIANCE_TYPE_DIAGONAL_KNOWN;
     }
-    return msg;
 };
 
 Timestamp io_comm_rx::RxMessage::timestampSBF(const uint8_t* data,
@@ -1586,7 +1616,7 @@ bool io_comm_rx::RxMessage::found()
 
     // Verify header bytes
     if (!this->isSBF() && !this->isNMEA() && !this->isResponse() &&
-        !(g_read_cd && this->isConnectionDescriptor()))
+        !(link_->read_cd && this->isConnectionDescriptor()))
     {
         return false;
     }
@@ -1601,19 +1631,80 @@ const uint8_t* io_comm_rx::RxMessage::search()
     {
         next();
     }
+    const uint8_t* start = data_;
+    // Bytes of valid blocks skipped as a whole, which are not discarded
+    std::size_t skipped = 0;
     // Search for message or a response header
-    for (; count_ > 0; --count_, ++data_)
-    {
-        if (this->isSBF() || this->isNMEA() || this->isResponse() ||
-            (g_read_cd && this->isConnectionDescriptor()))
+    while (count_ > 0)
+    {
+        // All sync bytes but those of the connection descriptor start with $
+        if (!link_->read_cd)
+        {
+            auto sync = static_cast<const uint8_t*>(
+                std::memchr(data_, NMEA_SYNC_BYTE_1, count_));
+            std::size_t skip =
+                sync ? static_cast<std::size_t>(sync - data_) : count_;
+            data_ += skip;
+            count_ -= skip;
+            if (count_ == 0)
+                break;
+        }
+        if (this->isSBF())
+        {
+            if (plausibleSBF())
+            {
+                // Valid blocks the driver does not decode, e.g. requested by
+                // another client of the port, are no false syncs
+                std::size_t length = undecodedSBFLength();
+                if (length == 0)
+                    break;
+                data_ += length;
+                count_ -= length;
+                skipped += length;
+                continue;
+            }
+            stream_monitor_.falseSync();
+        } else if (this->isNMEA() || this->isResponse() ||
+                   (link_->read_cd && this->isConnectionDescriptor()))
         {
             break;
         }
+        ++data_;
+        --count_;
     }
+    std::size_t discarded = static_cast<std::size_t>(data_ - start) - skipped;
+    if (count_discarded_ && (discarded > 0))
+        stream_monitor_.discarded(discarded);
     found_ = true;
     return data_;
 }
 
+bool io_comm_rx::RxMessage::plausibleSBF() const
+{
+    // Judged once the header is complete
+    if (count_ < 8)
+        return true;
+    uint16_t length = parsing_utilities::getLength(data_);
+    uint16_t id = parsing_utilities::getId(data_);
+    if ((length % 4 != 0) || (length < MIN_SBF_LENGTH) ||
+        (length > MAX_SBF_LENGTH) ||
+        (parsing_utilities::parseUInt16(data_ + 4) >> 13 > MAX_SBF_REVISION))
+        return false;
+    if (known_sbf_ids_.test(id))
+        return true;
+    // A block the driver does not decode is judged by its CRC once complete
+    return parsing_utilities::isSbfBlockNumber(id) &&
+           ((count_ < length) || isValid(data_));
+}
+
+std::size_t io_comm_rx::RxMessage::undecodedSBFLength() const
+{
+    if ((count_ < 8) || known_sbf_ids_.test(parsing_utilities::getId(data_)))
+        return 0;
+    std::size_t length = parsing_utilities::getLength(data_);
+    return count_ >= length ? length : 0;
+}
+
 std::size_t io_comm_rx::RxMessage::messageSize()
 {
     uint16_t pos = 0;
@@ -1824,16 +1915,19 @@ void io_comm_rx::RxMessage::next()
     if (found())
     {
         if (this->isNMEA() || this->isResponse() ||
-            (g_read_cd && this->isConnectionDescriptor()))
+            (link_->read_cd && this->isConnectionDescriptor()))
         {
-            if (g_read_cd && this->isConnectionDescriptor() && g_cd_count == 2)
+            if (link_->read_cd && this->isConnectionDescriptor() &&
+                link_->cd_count == 2)
             {
-                g_read_cd = false;
+                link_->read_cd = false;
             }
             jump_size = static_cast<uint32_t>(1);
+            count_discarded_ = false;
         }
         if (this->isSBF())
         {
+            count_discarded_ = true;
             if (crc_check_)
             {
                 jump_size = static_cast<std::size_t>(this->getBlockLength());
@@ -1862,22 +1956,32 @@ void io_comm_rx::RxMessage::next()
  */
 template <typename M>
 void io_comm_rx::RxMessage::publish(const std::string& topic, const M& msg)
+{
+    if (publishable())
+        node_->publishMessage<M>(topic, msg);
+}
+
+template <typename M>
+void io_comm_rx::RxMessage::publish(const std::string& topic,
+                                    const boost::shared_ptr<const M>& msg)
+{
+    if (publishable())
+        node_->publishMessage<M>(topic, msg);
+}
+
+bool io_comm_rx::RxMessage::publishable()
 {
     // TODO: maybe publish only if wnc and tow is valid?
     if (!settings_->use_gnss_time ||
         (settings_->use_gnss_time && (current_leap_seconds_ != -128)))
-    {
-        node_->publishMessage<M>(topic, msg);
-    } else
-    {
-        node_->log(
-            LogLevel::DEBUG,
-            "Not publishing message with GNSS time because no leap seconds are available yet.");
-        if (settings_->read_from_sbf_log || settings_->read_from_pcap)
-            node_->log(
-                LogLevel::WARN,
-                "No leap seconds were set and none were received from log yet.");
-    }
+        return true;
+    node_->log(
+        LogLevel::DEBUG,
+        "Not publishing message with GNSS time because no leap seconds are available yet.");
+    if (settings_->read_from_sbf_log || settings_->read_from_pcap)
+        node_->log(LogLevel::WARN,
+                   "No leap seconds were set and none were received from log yet.");
+    return false;
 }
 
 /**
@@ -1923,8 +2027,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     if (this->isSBF())
     {
         // If the CRC check is unsuccessful, return false
-        crc_check_ = isValid(data_);
-        if (!crc_check_)
+        if (!checkCrc())
         {
             node_->log(
                 LogLevel::DEBUG,
@@ -1932,16 +2035,27 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
             return false;
         }
     }
-    switch (rx_id_map[message_key])
+    RxID_Enum rx_id = rx_id_map[message_key];
+    // Skips decoding what no subscribed output consumes
+    if (node_->subscriptionGeneration() != demand_generation_)
+        updateDemand();
+    // A pending IMU batch is due after its delay, checked on every block in case
+    // IMU samples stop arriving, including blocks nobody needs
+    flushImuBatch(true);
+    if (!needed_[rx_id])
+        return true;
+    reportPools();
+    // SBF blocks are parsed straight from the buffer, without copying them
+    const uint8_t* blockEnd =
+        this->isSBF() ? data_ + parsing_utilities::getLength(data_) : data_;
+    switch (rx_id)
     {
     case evPVTCartesian: // Position and velocity in XYZ
     { // The curly bracket here is crucial: Declarations inside a block remain
         // inside, and will die at
         // the end of the block. Otherwise variable overloading etc.
         PVTCartesianMsg msg;
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!PVTCartesianParser(node_, dvec.begin(), dvec.end(), msg))
+        if (!PVTCartesianParser(node_, data_, blockEnd, msg))
         {
             node_->log(LogLevel::ERROR,
                        "septentrio_gnss_driver: parse error in PVTCartesian");
@@ -1961,17 +2075,17 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     case evPVTGeodetic: // Position and velocity in geodetic coordinate frame (ENU
                         // frame)
     {
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!PVTGeodeticParser(node_, dvec.begin(), dvec.end(), last_pvtgeodetic_))
+        auto block = pvtgeodetic_pool_.acquire();
+        if (!PVTGeodeticParser(node_, data_, blockEnd, *block))
         {
             node_->log(LogLevel::ERROR,
                        "septentrio_gnss_driver: parse error in PVTGeodetic");
             break;
         }
-        last_pvtgeodetic_.header.frame_id = settings_->frame_id;
+        block->header.frame_id = settings_->frame_id;
         Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-        last_pvtgeodetic_.header.stamp = timestampToRos(time_obj);
+        block->header.stamp = timestampToRos(time_obj);
+        last_pvtgeodetic_ = block;
         pvtgeodetic_has_arrived_gpsfix_ = true;
         pvtgeodetic_has_arrived_navsatfix_ = true;
         pvtgeodetic_has_arrived_pose_ = true;
@@ -1987,9 +2101,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     case evBaseVectorCart:
     {
         BaseVectorCartMsg msg;
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!BaseVectorCartParser(node_, dvec.begin(), dvec.end(), msg))
+        if (!BaseVectorCartParser(node_, data_, blockEnd, msg))
         {
             node_->log(LogLevel::ERROR,
                        "septentrio_gnss_driver: parse error in BaseVectorCart");
@@ -2009,9 +2121,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     case evBaseVectorGeod:
     {
         BaseVectorGeodMsg msg;
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!BaseVectorGeodParser(node_, dvec.begin(), dvec.end(), msg))
+        if (!BaseVectorGeodParser(node_, data_, blockEnd, msg))
         {
             node_->log(LogLevel::ERROR,
                        "septentrio_gnss_driver: parse error in BaseVectorGeod");
@@ -2031,9 +2141,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     case evPosCovCartesian:
     {
         PosCovCartesianMsg msg;
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!PosCovCartesianParser(node_, dvec.begin(), dvec.end(), msg))
+        if (!PosCovCartesianParser(node_, data_, blockEnd, msg))
         {
             node_->log(LogLevel::ERROR,
                        "septentrio_gnss_driver: parse error in PosCovCartesian");
@@ -2052,10 +2160,9 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     }
     case evPosCovGeodetic:
     {
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!PosCovGeodeticParser(node_, dvec.begin(), dvec.end(),
-                                  last_poscovgeodetic_))
+        auto block = poscovgeodetic_pool_.acquire();
+        if (!PosCovGeodeticParser(node_, data_, blockEnd,
+                                  *block))
         {
             poscovgeodetic_has_arrived_gpsfix_ = false;
             poscovgeodetic_has_arrived_navsatfix_ = false;
@@ -2064,9 +2171,10 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
                        "septentrio_gnss_driver: parse error in PosCovGeodetic");
             break;
         }
-        last_poscovgeodetic_.header.frame_id = settings_->frame_id;
+        block->header.frame_id = settings_->frame_id;
         Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-        last_poscovgeodetic_.header.stamp = timestampToRos(time_obj);
+        block->header.stamp = timestampToRos(time_obj);
+        last_poscovgeodetic_ = block;
         poscovgeodetic_has_arrived_gpsfix_ = true;
         poscovgeodetic_has_arrived_navsatfix_ = true;
         poscovgeodetic_has_arrived_pose_ = true;
@@ -2081,9 +2189,8 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     }
     case evAttEuler:
     {
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!AttEulerParser(node_, dvec.begin(), dvec.end(), last_atteuler_,
+        auto block = atteuler_pool_.acquire();
+        if (!AttEulerParser(node_, data_, blockEnd, *block,
                             settings_->use_ros_axis_orientation))
         {
             atteuler_has_arrived_gpsfix_ = false;
@@ -2092,9 +2199,10 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
                        "septentrio_gnss_driver: parse error in AttEuler");
             break;
         }
-        last_atteuler_.header.frame_id = settings_->frame_id;
+        block->header.frame_id = settings_->frame_id;
         Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-        last_atteuler_.header.stamp = timestampToRos(time_obj);
+        block->header.stamp = timestampToRos(time_obj);
+        last_atteuler_ = block;
         atteuler_has_arrived_gpsfix_ = true;
         atteuler_has_arrived_pose_ = true;
         // Wait as long as necessary (only when reading from SBF/PCAP file)
@@ -2108,9 +2216,8 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     }
     case evAttCovEuler:
     {
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!AttCovEulerParser(node_, dvec.begin(), dvec.end(), last_attcoveuler_,
+        auto block = attcoveuler_pool_.acquire();
+        if (!AttCovEulerParser(node_, data_, blockEnd, *block,
                                settings_->use_ros_axis_orientation))
         {
             attcoveuler_has_arrived_gpsfix_ = false;
@@ -2119,9 +2226,10 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
                        "septentrio_gnss_driver: parse error in AttCovEuler");
             break;
         }
-        last_attcoveuler_.header.frame_id = settings_->frame_id;
+        block->header.frame_id = settings_->frame_id;
         Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-        last_attcoveuler_.header.stamp = timestampToRos(time_obj);
+        block->header.stamp = timestampToRos(time_obj);
+        last_attcoveuler_ = block;
         attcoveuler_has_arrived_gpsfix_ = true;
         attcoveuler_has_arrived_pose_ = true;
         // Wait as long as necessary (only when reading from SBF/PCAP file)
@@ -2137,9 +2245,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
                        // frame (ENU frame)
     {
         INSNavCartMsg msg;
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!INSNavCartParser(node_, dvec.begin(), dvec.end(), msg,
+        if (!INSNavCartParser(node_, data_, blockEnd, msg,
                               settings_->use_ros_axis_orientation))
         {
             node_->log(LogLevel::ERROR,
@@ -2166,9 +2272,8 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     case evINSNavGeod: // Position, velocity and orientation in geodetic coordinate
                        // frame (ENU frame)
     {
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!INSNavGeodParser(node_, dvec.begin(), dvec.end(), last_insnavgeod_,
+        auto block = insnavgeod_pool_.acquire();
+        if (!INSNavGeodParser(node_, data_, blockEnd, *block,
                               settings_->use_ros_axis_orientation))
         {
             insnavgeod_has_arrived_gpsfix_ = false;
@@ -2181,13 +2286,14 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
         }
         if (settings_->ins_use_poi)
         {
-            last_insnavgeod_.header.frame_id = settings_->poi_frame_id;
+            block->header.frame_id = settings_->poi_frame_id;
         } else
         {
-            last_insnavgeod_.header.frame_id = settings_->frame_id;
+            block->header.frame_id = settings_->frame_id;
         }
         Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-        last_insnavgeod_.header.stamp = timestampToRos(time_obj);
+        block->header.stamp = timestampToRos(time_obj);
+        last_insnavgeod_ = block;
         insnavgeod_has_arrived_gpsfix_ = true;
         insnavgeod_has_arrived_navsatfix_ = true;
         insnavgeod_has_arrived_pose_ = true;
@@ -2210,9 +2316,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     case evIMUSetup: // IMU orientation and lever arm
     {
         IMUSetupMsg msg;
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!IMUSetupParser(node_, dvec.begin(), dvec.end(), msg,
+        if (!IMUSetupParser(node_, data_, blockEnd, msg,
                             settings_->use_ros_axis_orientation))
         {
             node_->log(LogLevel::ERROR,
@@ -2234,9 +2338,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     case evVelSensorSetup: // Velocity sensor lever arm
     {
         VelSensorSetupMsg msg;
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!VelSensorSetupParser(node_, dvec.begin(), dvec.end(), msg,
+        if (!VelSensorSetupParser(node_, data_, blockEnd, msg,
                                   settings_->use_ros_axis_orientation))
         {
             node_->log(LogLevel::ERROR,
@@ -2259,9 +2361,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
                                // coordinate frame (ENU frame)
     {
         INSNavCartMsg msg;
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!INSNavCartParser(node_, dvec.begin(), dvec.end(), msg,
+        if (!INSNavCartParser(node_, data_, blockEnd, msg,
                               settings_->use_ros_axis_orientation))
         {
             node_->log(LogLevel::ERROR,
@@ -2289,9 +2389,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     case evExtEventINSNavGeod:
     {
         INSNavGeodMsg msg;
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!INSNavGeodParser(node_, dvec.begin(), dvec.end(), msg,
+        if (!INSNavGeodParser(node_, data_, blockEnd, msg,
                               settings_->use_ros_axis_orientation))
         {
             node_->log(LogLevel::ERROR,
@@ -2318,19 +2416,19 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
 
     case evExtSensorMeas:
     {
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
+        auto block = extsensmeas_pool_.acquire();
         bool hasImuMeas = false;
-        if (!ExtSensorMeasParser(node_, dvec.begin(), dvec.end(), last_extsensmeas_,
+        if (!ExtSensorMeasParser(node_, data_, blockEnd, *block,
                                  settings_->use_ros_axis_orientation, hasImuMeas))
         {
             node_->log(LogLevel::ERROR,
                        "septentrio_gnss_driver: parse error in ExtSensorMeas");
             break;
         }
-        last_extsensmeas_.header.frame_id = settings_->imu_frame_id;
+        block->header.frame_id = settings_->imu_frame_id;
         Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-        last_extsensmeas_.header.stamp = timestampToRos(time_obj);
+        block->header.stamp = timestampToRos(time_obj);
+        last_extsensmeas_ = block;
         // Wait as long as necessary (only when reading from SBF/PCAP file)
         if (settings_->read_from_sbf_log || settings_->read_from_pcap)
         {
@@ -2338,7 +2436,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
         }
         if (settings_->publish_extsensormeas)
             publish<ExtSensorMeasMsg>("/extsensormeas", last_extsensmeas_);
-        if (settings_->publish_imu && hasImuMeas)
+        if ((settings_->publish_imu || settings_->publish_imubatch) && hasImuMeas)
         {
             ImuMsg msg;
             try
@@ -2350,8 +2448,11 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
                 break;
             }
             msg.header.frame_id = settings_->imu_frame_id;
-            msg.header.stamp = last_extsensmeas_.header.stamp;
-            publish<ImuMsg>("/imu", msg);
+            msg.header.stamp = block->header.stamp;
+            if (settings_->publish_imu)
+                publish<ImuMsg>("/imu", msg);
+            if (settings_->publish_imubatch)
+                batchImu(msg);
         }
         break;
     }
@@ -2492,16 +2593,16 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
         if (settings_->septentrio_receiver_type == "gnss")
         {
             Timestamp time_obj;
-            time_obj = timestampSBF(last_pvtgeodetic_.block_header.tow,
-                                    last_pvtgeodetic_.block_header.wnc,
+            time_obj = timestampSBF(last_pvtgeodetic_->block_header.tow,
+                                    last_pvtgeodetic_->block_header.wnc,
                                     settings_->use_gnss_time);
             msg.header.stamp = timestampToRos(time_obj);
         }
         if (settings_->septentrio_receiver_type == "ins")
         {
             Timestamp time_obj;
-            time_obj = timestampSBF(last_insnavgeod_.block_header.tow,
-                                    last_insnavgeod_.block_header.wnc,
+            time_obj = timestampSBF(last_insnavgeod_->block_header.tow,
+                                    last_insnavgeod_->block_header.wnc,
                                     settings_->use_gnss_time);
             msg.header.stamp = timestampToRos(time_obj);
         }
@@ -2517,6 +2618,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     case evGPGSV:
     case evGLGSV:
     case evGAGSV:
+    case evGBGSV:
     {
         boost::char_separator<char> sep("\r");
         typedef boost::tokenizer<boost::char_separator<char>> tokenizer;
@@ -2550,16 +2652,16 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
         if (settings_->septentrio_receiver_type == "gnss")
         {
             Timestamp time_obj;
-            time_obj = timestampSBF(last_pvtgeodetic_.block_header.tow,
-                                    last_pvtgeodetic_.block_header.wnc,
+            time_obj = timestampSBF(last_pvtgeodetic_->block_header.tow,
+                                    last_pvtgeodetic_->block_header.wnc,
                                     settings_->use_gnss_time);
             msg.header.stamp = timestampToRos(time_obj);
         }
         if (settings_->septentrio_receiver_type == "ins")
         {
             Timestamp time_obj;
-            time_obj = timestampSBF(last_insnavgeod_.block_header.tow,
-                                    last_insnavgeod_.block_header.wnc,
+            time_obj = timestampSBF(last_insnavgeod_->block_header.tow,
+                                    last_insnavgeod_->block_header.wnc,
                                     settings_->use_gnss_time);
             msg.header.stamp = timestampToRos(time_obj);
         }
@@ -2569,7 +2671,24 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
             Timestamp time_obj = timestampFromRos(msg.header.stamp);
             wait(time_obj);
         }
-        publish<GpgsvMsg>("/gpgsv", msg);
+        if (settings_->publish_gpgsv)
+            publish<GpgsvMsg>("/gpgsv", msg);
+        uint8_t constellation;
+        if (settings_->publish_satellites &&
+            parsing_utilities::GsvAssembler::constellation(id, constellation))
+        {
+            SatellitesInViewMsg satellites;
+            if (gsv_assembler_.add(constellation, msg, satellites))
+                publish<SatellitesInViewMsg>("/satellites", satellites);
+            if (gsv_assembler_.rejected() != gsv_rejected_logged_)
+            {
+                gsv_rejected_logged_ = gsv_assembler_.rejected();
+                node_->log(LogLevel::DEBUG,
+                           "Incomplete GSV sequence left out, " +
+                               std::to_string(gsv_rejected_logged_) +
+                               " so far");
+            }
+        }
         break;
     }
 
@@ -2639,20 +2758,20 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
         {
         case evGPSFix:
         {
-            GPSFixMsg msg;
+            boost::shared_ptr<GPSFixMsg> msg = gpsfix_pool_.acquire();
             try
             {
-                msg = GPSFixCallback();
+                GPSFixCallback(*msg);
             } catch (std::runtime_error& e)
             {
                 node_->log(LogLevel::DEBUG, "GPSFixMsg: " + std::string(e.what()));
                 break;
             }
-            msg.header.frame_id = settings_->frame_id;
-            msg.status.header.frame_id = settings_->frame_id;
+            msg->header.frame_id = settings_->frame_id;
+            msg->status.header.frame_id = settings_->frame_id;
             Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-            msg.header.stamp = timestampToRos(time_obj);
-            msg.status.header.stamp = timestampToRos(time_obj);
+            msg->header.stamp = timestampToRos(time_obj);
+            msg->status.header.stamp = timestampToRos(time_obj);
             ++count_gpsfix_;
             channelstatus_has_arrived_gpsfix_ = false;
             measepoch_has_arrived_gpsfix_ = false;
@@ -2675,10 +2794,10 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
         {
         case evINSGPSFix:
         {
-            GPSFixMsg msg;
+            boost::shared_ptr<GPSFixMsg> msg = gpsfix_pool_.acquire();
             try
             {
-                msg = GPSFixCallback();
+                GPSFixCallback(*msg);
             } catch (std::runtime_error& e)
             {
                 node_->log(LogLevel::DEBUG, "GPSFixMsg: " + std::string(e.what()));
@@ -2686,15 +2805,15 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
             }
             if (settings_->ins_use_poi)
             {
-                msg.header.frame_id = settings_->poi_frame_id;
+                msg->header.frame_id = settings_->poi_frame_id;
             } else
             {
-                msg.header.frame_id = settings_->frame_id;
+                msg->header.frame_id = settings_->frame_id;
             }
-            msg.status.header.frame_id = msg.header.frame_id;
+            msg->status.header.frame_id = msg->header.frame_id;
             Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-            msg.header.stamp = timestampToRos(time_obj);
-            msg.status.header.stamp = timestampToRos(time_obj);
+            msg->header.stamp = timestampToRos(time_obj);
+            msg->status.header.stamp = timestampToRos(time_obj);
             ++count_gpsfix_;
             channelstatus_has_arrived_gpsfix_ = false;
             measepoch_has_arrived_gpsfix_ = false;
@@ -2774,9 +2893,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
         }
     case evChannelStatus:
     {
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!ChannelStatusParser(node_, dvec.begin(), dvec.end(),
+        if (!ChannelStatusParser(node_, data_, blockEnd,
                                  last_channelstatus_))
         {
             node_->log(LogLevel::ERROR,
@@ -2788,27 +2905,31 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     }
     case evMeasEpoch:
     {
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!MeasEpochParser(node_, dvec.begin(), dvec.end(), last_measepoch_))
+        auto block = measepoch_pool_.acquire();
+        if (!MeasEpochParser(node_, data_, blockEnd, *block))
         {
             node_->log(LogLevel::ERROR,
                        "septentrio_gnss_driver: parse error in MeasEpoch");
             break;
         }
-        last_measepoch_.header.frame_id = settings_->frame_id;
+        block->header.frame_id = settings_->frame_id;
         Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-        last_measepoch_.header.stamp = timestampToRos(time_obj);
+        block->header.stamp = timestampToRos(time_obj);
+        last_measepoch_ = block;
         measepoch_has_arrived_gpsfix_ = true;
         if (settings_->publish_measepoch)
             publish<MeasEpochMsg>("/measepoch", last_measepoch_);
+        if (settings_->publish_rawobservables)
+        {
+            auto raw = rawobservables_pool_.acquire();
+            measepoch_decoder_.decode(*block, *raw);
+            publish<RawObservablesMsg>("/rawobservables", raw);
+        }
         break;
     }
     case evDOP:
     {
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!DOPParser(node_, dvec.begin(), dvec.end(), last_dop_))
+        if (!DOPParser(node_, data_, blockEnd, last_dop_))
         {
             dop_has_arrived_gpsfix_ = false;
             node_->log(LogLevel::ERROR,
@@ -2820,19 +2941,19 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     }
     case evVelCovGeodetic:
     {
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!VelCovGeodeticParser(node_, dvec.begin(), dvec.end(),
-                                  last_velcovgeodetic_))
+        auto block = velcovgeodetic_pool_.acquire();
+        if (!VelCovGeodeticParser(node_, data_, blockEnd,
+                                  *block))
         {
             velcovgeodetic_has_arrived_gpsfix_ = false;
             node_->log(LogLevel::ERROR,
                        "septentrio_gnss_driver: parse error in VelCovGeodetic");
             break;
         }
-        last_velcovgeodetic_.header.frame_id = settings_->frame_id;
+        block->header.frame_id = settings_->frame_id;
         Timestamp time_obj = timestampSBF(data_, settings_->use_gnss_time);
-        last_velcovgeodetic_.header.stamp = timestampToRos(time_obj);
+        block->header.stamp = timestampToRos(time_obj);
+        last_velcovgeodetic_ = block;
         velcovgeodetic_has_arrived_gpsfix_ = true;
         // Wait as long as necessary (only when reading from SBF/PCAP file)
         if (settings_->read_from_sbf_log || settings_->read_from_pcap)
@@ -2913,9 +3034,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     }
     case evReceiverStatus:
     {
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!ReceiverStatusParser(node_, dvec.begin(), dvec.end(),
+        if (!ReceiverStatusParser(node_, data_, blockEnd,
                                   last_receiverstatus_))
         {
             receiverstatus_has_arrived_diagnostics_ = false;
@@ -2928,9 +3047,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     }
     case evQualityInd:
     {
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!QualityIndParser(node_, dvec.begin(), dvec.end(), last_qualityind_))
+        if (!QualityIndParser(node_, data_, blockEnd, last_qualityind_))
         {
             qualityind_has_arrived_diagnostics_ = false;
             node_->log(LogLevel::ERROR,
@@ -2942,9 +3059,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     }
     case evReceiverSetup:
     {
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!ReceiverSetupParser(node_, dvec.begin(), dvec.end(),
+        if (!ReceiverSetupParser(node_, data_, blockEnd,
                                  last_receiversetup_))
         {
             node_->log(LogLevel::ERROR,
@@ -3023,9 +3138,7 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     case evReceiverTime:
     {
         ReceiverTimeMsg msg;
-        std::vector<uint8_t> dvec(data_,
-                                  data_ + parsing_utilities::getLength(data_));
-        if (!ReceiverTimeParser(node_, dvec.begin(), dvec.end(), msg))
+        if (!ReceiverTimeParser(node_, data_, blockEnd, msg))
         {
             node_->log(LogLevel::ERROR,
                        "septentrio_gnss_driver: parse error in ReceiverTime");
@@ -3040,11 +3153,232 @@ bool io_comm_rx::RxMessage::read(std::string message_key, bool search)
     return true;
 }
 
+void io_comm_rx::RxMessage::updateDemand()
+{
+    demand_generation_ = node_->subscriptionGeneration();
+    bool gnss = (settings_->septentrio_receiver_type == "gnss");
+    bool ins = (settings_->septentrio_receiver_type == "ins");
+
+    bool gpsfix = wanted(settings_->publish_gpsfix, "/gpsfix");
+    bool navsatfix = wanted(settings_->publish_navsatfix, "/navsatfix");
+    bool pose = wanted(settings_->publish_pose, "/pose");
+    bool diagnostics = wanted(settings_->publish_diagnostics, "/diagnostics");
+    // Subscribers of tf cannot be counted
+    bool localization = wanted(settings_->publish_localization, "/localization") ||
+                        settings_->publish_tf;
+    bool twist = wanted(settings_->publish_twist, "/twist");
+    bool twist_ins = wanted(settings_->publish_twist, "/twist_ins");
+    bool imu = wanted(settings_->publish_imu, "/imu") ||
+               wanted(settings_->publish_imubatch, "/imubatch");
+    bool gpgsv = wanted(settings_->publish_gpgsv, "/gpgsv") ||
+                 wanted(settings_->publish_satellites, "/satellites");
+
+    // ReceiverTime and ReceiverSetup are always needed
+    needed_.assign(evReceiverSetup + 1, true);
+    needed_[evNavSatFix] = navsatfix;
+    needed_[evINSNavSatFix] = navsatfix;
+    needed_[evGPSFix] = gpsfix;
+    needed_[evINSGPSFix] = gpsfix;
+    needed_[evPoseWithCovarianceStamped] = pose;
+    needed_[evINSPoseWithCovarianceStamped] = pose;
+    needed_[evGPGGA] = wanted(settings_->publish_gpgga, "/gpgga");
+    needed_[evGPRMC] = wanted(settings_->publish_gprmc, "/gprmc");
+    needed_[evGPGSA] = wanted(settings_->publish_gpgsa, "/gpgsa");
+    needed_[evGPGSV] = gpgsv;
+    needed_[evGLGSV] = gpgsv;
+    needed_[evGAGSV] = gpgsv;
+    needed_[evGBGSV] = gpgsv;
+    needed_[evPVTCartesian] =
+        wanted(settings_->publish_pvtcartesian, "/pvtcartesian");
+    needed_[evPVTGeodetic] =
+        wanted(settings_->publish_pvtgeodetic, "/pvtgeodetic") ||
+        (gnss && (gpsfix || navsatfix || pose || twist || gpgsv));
+    needed_[evBaseVectorCart] =
+        wanted(settings_->publish_basevectorcart, "/basevectorcart");
+    needed_[evBaseVectorGeod] =
+        wanted(settings_->publish_basevectorgeod, "/basevectorgeod");
+    needed_[evPosCovCartesian] =
+        wanted(settings_->publish_poscovcartesian, "/poscovcartesian");
+    needed_[evPosCovGeodetic] =
+        wanted(settings_->publish_poscovgeodetic, "/poscovgeodetic") ||
+        (gnss && (gpsfix || navsatfix || pose));
+    needed_[evAttEuler] = wanted(settings_->publish_atteuler, "/atteuler") ||
+                          (gnss && (gpsfix || pose));
+    needed_[evAttCovEuler] =
+        wanted(settings_->publish_attcoveuler, "/attcoveuler") ||
+        (gnss && (gpsfix || pose));
+    needed_[evINSNavCart] = wanted(settings_->publish_insnavcart, "/insnavcart");
+    needed_[evINSNavGeod] =
+        wanted(settings_->publish_insnavgeod, "/insnavgeod") || twist_ins ||
+        (ins && (gpsfix || navsatfix || pose || localization || imu || gpgsv));
+    needed_[evIMUSetup] = wanted(settings_->publish_imusetup, "/imusetup");
+    needed_[evVelSensorSetup] =
+        wanted(settings_->publish_velsensorsetup, "/velsensorsetup");
+    needed_[evExtEventINSNavGeod] =
+        wanted(settings_->publish_exteventinsnavgeod, "/exteventinsnavgeod");
+    needed_[evExtEventINSNavCart] =
+        wanted(settings_->publish_exteventinsnavcart, "/exteventinsnavcart");
+    needed_[evExtSensorMeas] =
+        wanted(settings_->publish_extsensormeas, "/extsensormeas") || imu;
+    needed_[evGPST] = wanted(settings_->publish_gpst, "/gpst");
+    needed_[evChannelStatus] = gpsfix;
+    needed_[evMeasEpoch] =
+        wanted(settings_->publish_measepoch, "/measepoch") ||
+        wanted(settings_->publish_rawobservables, "/rawobservables") || gpsfix;
+    needed_[evDOP] = gpsfix;
+    needed_[evVelCovGeodetic] =
+        wanted(settings_->publish_velcovgeodetic, "/velcovgeodetic") || twist ||
+        (gnss && gpsfix);
+    needed_[evDiagnosticArray] = diagnostics;
+    needed_[evReceiverStatus] = diagnostics;
+    needed_[evQualityInd] = diagnostics;
+    needed_[evLocalization] = localization;
+}
+
+bool io_comm_rx::RxMessage::wanted(bool publish, const std::string& topic) const
+{
+    return publish && node_->isSubscribed(topic);
+}
+
+void io_comm_rx::RxMessage::reportPools()
+{
+    auto now = boost::chrono::steady_clock::now();
+    if (now - last_pool_report_ < boost::chrono::seconds(60))
+        return;
+    last_pool_report_ = now;
+    uint64_t allocations =
+        pvtgeodetic_pool_.allocations() + poscovgeodetic_pool_.allocations() +
+        atteuler_pool_.allocations() + attcoveuler_pool_.allocations() +
+        insnavgeod_pool_.allocations() + extsensmeas_pool_.allocations() +
+        measepoch_pool_.allocations() + velcovgeodetic_pool_.allocations() +
+        gpsfix_pool_.allocations() + rawobservables_pool_.allocations() +
+        imubatch_pool_.allocations();
+    uint64_t reuses = pvtgeodetic_pool_.reuses() + poscovgeodetic_pool_.reuses() +
+                      atteuler_pool_.reuses() + attcoveuler_pool_.reuses() +
+                      insnavgeod_pool_.reuses() + extsensmeas_pool_.reuses() +
+                      measepoch_pool_.reuses() + velcovgeodetic_pool_.reuses() +
+                      gpsfix_pool_.reuses() + rawobservables_pool_.reuses() +
+                      imubatch_pool_.reuses();
+    node_->log(LogLevel::DEBUG,
+               "Message pools: " + std::to_string(allocations) +
+                   " messages allocated, " + std::to_string(reuses) +
+                   " reused so far");
+}
+
+void io_comm_rx::RxMessage::batchImu(const ImuMsg& msg)
+{
+    if (!imubatch_)
+    {
+        imubatch_ = imubatch_pool_.acquire();
+        imubatch_->samples.clear();
+        imubatch_start_ = boost::chrono::steady_clock::now();
+    }
+    imubatch_->samples.push_back(msg);
+    if (imubatch_->samples.size() >= settings_->imu_batch_size)
+        publishImuBatch();
+}
+
+void io_comm_rx::RxMessage::flushImuBatch(bool due_only)
+{
+    if (!imubatch_)
+        return;
+    if (due_only &&
+        (boost::chrono::steady_clock::now() - imubatch_start_ <
+         boost::chrono::duration<double>(settings_->imu_batch_max_delay)))
+        return;
+    publishImuBatch();
+}
+
+void io_comm_rx::RxMessage::publishImuBatch()
+{
+    imubatch_->header = imubatch_->samples.back().header;
+    publish<ImuBatchMsg>("/imubatch", imubatch_);
+    imubatch_.reset();
+}
+
+bool io_comm_rx::RxMessage::checkCrc()
+{
+    if (crc_checked_block_ != data_)
+    {
+        crc_check_ = isValid(data_);
+        crc_checked_block_ = data_;
+    }
+    return crc_check_;
+}
+
+/**
+ * The blocks of Stream1 and Stream2 mirror Comm_IO::pvtBlocks() and
+ * Comm_IO::restBlocks(). When reading from a file, the periods the blocks were
+ * logged at are unknown and inferred from their TOW steps.
+ */
+void io_comm_rx::RxMessage::configureStreamMonitor()
+{
+    // ExtEventINSNavCart, ExtEventINSNavGeod, IMUSetup, VelSensorSetup and
+    // ReceiverSetup are output on events or changes only
+    for (uint16_t id : {4229, 4230, 4224, 4244, 5902})
+        stream_monitor_.setInterval(id, 0);
+    if (settings_->read_from_sbf_log || settings_->read_from_pcap)
+        return;
+    // ReceiverTime, PVTCartesian, PVTGeodetic, BaseVectorCart, BaseVectorGeod,
+    // PosCovCartesian, PosCovGeodetic, VelCovGeodetic, AttEuler, AttCovEuler,
+    // MeasEpoch, ChannelStatus, DOP, INSNavCart, INSNavGeod and ExtSensorMeas
+    for (uint16_t id : {5914, 4006, 4007, 4043, 4028, 5905, 5906, 5908, 5938, 5939,
+                        4027, 4013, 4001, 4225, 4226, 4050})
+        stream_monitor_.setInterval(id, settings_->polling_period_pvt);
+    // ReceiverStatus and QualityInd
+    for (uint16_t id : {4014, 4082})
+        stream_monitor_.setInterval(id, settings_->polling_period_rest);
+}
+
+void io_comm_rx::RxMessage::monitorStream()
+{
+    auto now = boost::chrono::steady_clock::now();
+    if (!checkCrc())
+    {
+        stream_monitor_.crcError();
+    } else if (parsing_utilities::getLength(data_) >= 14) // Holds TOW and WNc
+    {
+        stream_monitor_.setCheckLate(!settings_->read_from_sbf_log &&
+                                     !settings_->read_from_pcap);
+        stream_monitor_.observe(
+            parsing_utilities::getId(data_), parsing_utilities::getTow(data_),
+            parsing_utilities::getWnc(data_),
+            boost::chrono::duration_cast<boost::chrono::milliseconds>(
+                now.time_since_epoch())
+                .count());
+    }
+    if (now - last_stream_report_ >= boost::chrono::seconds(1))
+        reportStream(now);
+}
+
+void io_comm_rx::RxMessage::reportStream(boost::chrono::steady_clock::time_point now)
+{
+    last_stream_report_ = now;
+    auto msg = streamstatus_pool_.acquire();
+    if (stream_monitor_.report(*msg))
+    {
+        const auto& degradation = stream_monitor_.lastDegradation();
+        node_->log(LogLevel::WARN,
+                   "SBF stream degraded in the last second: " +
+                       std::to_string(degradation[0]) + " epochs missing, " +
+                       std::to_string(degradation[1]) + " blocks late, " +
+                       std::to_string(degradation[2]) + " out of order, " +
+                       std::to_string(degradation[3]) + " CRC errors");
+    }
+    if (wanted(settings_->publish_streamstatus, "/streamstatus"))
+    {
+        msg->header.frame_id = settings_->frame_id;
+        msg->header.stamp = timestampToRos(recvTimestamp_);
+        publish<StreamStatusMsg>("/streamstatus", msg);
+    }
+}
+
 void io_comm_rx::RxMessage::wait(Timestamp time_obj)
 {
     Timestamp unix_old = unix_time_;
     unix_time_ = time_obj;
-    if ((unix_old != 0) && (unix_time_ != unix_old))
+    if (settings_->replay_in_realtime && (unix_old != 0) &&
+        (unix_time_ != unix_old))
     {
         if (unix_time_ > unix_old)
         {
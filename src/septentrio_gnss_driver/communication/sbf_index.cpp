@@ -0,0 +1,251 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C library includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+// C++ library includes
+#include <algorithm>
+#include <fstream>
+// Boost includes
+#include <boost/thread.hpp>
+// ROSaic includes
+#include <septentrio_gnss_driver/communication/sbf_index.hpp>
+#include <septentrio_gnss_driver/crc/crc.h>
+#include <septentrio_gnss_driver/parsers/parsing_utilities.hpp>
+
+/**
+ * @file sbf_index.cpp
+ * @date 16/10/26
+ * @brief Defines a class indexing the SBF blocks of a log by time, to seek in it
+ */
+
+namespace {
+    //! Identifies the cache file and its version
+    const char INDEX_MAGIC[8] = {'S', 'B', 'F', 'I', 'D', 'X', '0', '1'};
+    //! Minimum size of a chunk scanned by one thread
+    const uint64_t MIN_CHUNK_SIZE = 1 << 20;
+    //! Minimum length of an SBF block holding TOW and WNc
+    const uint16_t MIN_BLOCK_LENGTH = 16;
+    //! Do-not-use values of TOW and WNc
+    const uint32_t TOW_DNU = 4294967295U;
+    const uint16_t WNC_DNU = 65535;
+} // namespace
+
+io_comm_rx::SbfIndex::SbfIndex(ROSaicNodeBase* node) :
+    node_(node), file_size_(0), first_ms_(0)
+{
+}
+
+bool io_comm_rx::SbfIndex::load(const std::string& file_name)
+{
+    int fd = ::open(file_name.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        node_->log(LogLevel::ERROR, "Could not open " + file_name + " to index it.");
+        return false;
+    }
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    file_size_ = static_cast<uint64_t>(file_stat.st_size);
+    int64_t mtime = static_cast<int64_t>(file_stat.st_mtime);
+
+    std::string cache_name = file_name + ".idx";
+    if (readCache(cache_name, file_size_, mtime))
+    {
+        ::close(fd);
+        node_->log(LogLevel::DEBUG, "Loaded SBF index " + cache_name);
+    } else
+    {
+        if (file_size_ > 0)
+        {
+            void* data =
+                ::mmap(nullptr, file_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED)
+            {
+                ::close(fd);
+                node_->log(LogLevel::ERROR, "Could not map " + file_name +
+                                                " to index it.");
+                return false;
+            }
+            ::madvise(data, file_size_, MADV_SEQUENTIAL);
+            build(static_cast<const uint8_t*>(data), file_size_);
+            ::munmap(data, file_size_);
+        }
+        ::close(fd);
+        node_->log(LogLevel::INFO, "Indexed " + std::to_string(entries_.size()) +
+                                       " SBF blocks of " + file_name);
+        if (!writeCache(cache_name, file_size_, mtime))
+            node_->log(LogLevel::WARN, "Could not cache SBF index to " + cache_name);
+    }
+
+    first_ms_ = 0;
+    for (const auto& entry : entries_)
+    {
+        if ((entry.tow != TOW_DNU) && (entry.wnc != WNC_DNU))
+        {
+            first_ms_ = gpsMs(entry);
+            break;
+        }
+    }
+    return true;
+}
+
+uint64_t io_comm_rx::SbfIndex::offsetAt(double seconds) const
+{
+    uint64_t target_ms = first_ms_ + static_cast<uint64_t>(seconds * 1000.0);
+    // Blocks are in time order in the log except for those without time, hence
+    // these are skipped rather than bisected
+    auto it = std::find_if(entries_.begin(), entries_.end(),
+                           [target_ms](const Entry& entry) {
+                               return (entry.tow != TOW_DNU) &&
+                                      (entry.wnc != WNC_DNU) &&
+                                      (gpsMs(entry) >= target_ms);
+                           });
+    if (it == entries_.end())
+        return file_size_;
+    return it->offset;
+}
+
+void io_comm_rx::SbfIndex::build(const uint8_t* data, uint64_t size)
+{
+    uint64_t threads = std::max(1U, boost::thread::hardware_concurrency());
+    threads = std::max(static_cast<uint64_t>(1),
+                       std::min(threads, size / MIN_CHUNK_SIZE));
+    uint64_t chunk_size = (size + threads - 1) / threads;
+
+    std::vector<std::vector<Entry>> chunk_entries(threads);
+    boost::thread_group scanners;
+    for (uint64_t i = 0; i < threads; ++i)
+    {
+        uint64_t begin = i * chunk_size;
+        uint64_t end = std::min(size, begin + chunk_size);
+        scanners.create_thread(boost::bind(&SbfIndex::scan, data, size, begin, end,
+                                           boost::ref(chunk_entries[i])));
+    }
+    scanners.join_all();
+
+    // A chunk may start within a block found by the previous chunk, so entries
+    // overlapping the last block taken are dropped
+    entries_.clear();
+    uint64_t taken_until = 0;
+    for (const auto& entries : chunk_entries)
+    {
+        for (const auto& entry : entries)
+        {
+            if (entry.offset < taken_until)
+                continue;
+            entries_.push_back(entry);
+            taken_until =
+                entry.offset + parsing_utilities::getLength(data + entry.offset);
+        }
+    }
+}
+
+void io_comm_rx::SbfIndex::scan(const uint8_t* data, uint64_t size, uint64_t begin,
+                                uint64_t end, std::vector<Entry>& entries)
+{
+    uint64_t pos = begin;
+    while ((pos < end) && (pos + MIN_BLOCK_LENGTH <= size))
+    {
+        if ((data[pos] == '$') && (data[pos + 1] == '@'))
+        {
+            uint16_t length = parsing_utilities::getLength(data + pos);
+            if ((length >= MIN_BLOCK_LENGTH) && (length % 4 == 0) &&
+                (pos + length <= size) && isValid(data + pos))
+            {
+                Entry entry;
+                entry.offset = pos;
+                entry.tow = parsing_utilities::getTow(data + pos);
+                entry.wnc = parsing_utilities::getWnc(data + pos);
+                entry.block_id = parsing_utilities::getId(data + pos);
+                entries.push_back(entry);
+                pos += length;
+                continue;
+            }
+        }
+        ++pos;
+    }
+}
+
+bool io_comm_rx::SbfIndex::readCache(const std::string& cache_name, uint64_t size,
+                                     int64_t mtime)
+{
+    std::ifstream cache(cache_name, std::ios::binary);
+    if (!cache.good())
+        return false;
+    char magic[sizeof(INDEX_MAGIC)];
+    uint64_t cached_size;
+    int64_t cached_mtime;
+    uint64_t count;
+    cache.read(magic, sizeof(magic));
+    cache.read(reinterpret_cast<char*>(&cached_size), sizeof(cached_size));
+    cache.read(reinterpret_cast<char*>(&cached_mtime), sizeof(cached_mtime));
+    cache.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!cache.good() || !std::equal(magic, magic + sizeof(magic), INDEX_MAGIC) ||
+        (cached_size != size) || (cached_mtime != mtime) ||
+        (count > size / MIN_BLOCK_LENGTH))
+        return false;
+    entries_.resize(count);
+    cache.read(reinterpret_cast<char*>(entries_.data()), count * sizeof(Entry));
+    if (!cache.good())
+    {
+        entries_.clear();
+        return false;
+    }
+    return true;
+}
+
+bool io_comm_rx::SbfIndex::writeCache(const std::string& cache_name, uint64_t size,
+                                      int64_t mtime) const
+{
+    std::ofstream cache(cache_name, std::ios::binary | std::ios::trunc);
+    if (!cache.good())
+        return false;
+    uint64_t count = entries_.size();
+    cache.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    cache.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    cache.write(reinterpret_cast<const char*>(&mtime), sizeof(mtime));
+    cache.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    cache.write(reinterpret_cast<const char*>(entries_.data()),
+                count * sizeof(Entry));
+    return cache.good();
+}
+
+uint64_t io_comm_rx::SbfIndex::gpsMs(const Entry& entry)
+{
+    return static_cast<uint64_t>(entry.wnc) * 604800000ULL + entry.tow;
+}
@@ -0,0 +1,85 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROS includes
+#include <ros/console.h>
+// ROSaic includes
+#include <septentrio_gnss_driver/communication/shared_reactor.hpp>
+#include <septentrio_gnss_driver/communication/thread_config.hpp>
+
+/**
+ * @file shared_reactor.cpp
+ * @date 16/10/26
+ * @brief Defines an I/O reactor and a parsing pool that several Rx links share
+ */
+
+namespace {
+    //! Configures the calling thread and runs service until it is stopped
+    void runConfigured(const std::string& name, const ThreadSettings& settings,
+                       boost::asio::io_service* service)
+    {
+        std::string errors = io_comm_rx::configureThread(name, settings);
+        if (!errors.empty())
+            ROS_WARN_STREAM("Thread " << name
+                                      << " keeps part of its default scheduling ("
+                                      << errors << ").");
+        service->run();
+    }
+} // namespace
+
+io_comm_rx::SharedReactor::SharedReactor(std::size_t parse_threads,
+                                         const ThreadSettings& io_thread,
+                                         const ThreadSettings& parse_thread) :
+    io_service_(new boost::asio::io_service),
+    parse_service_(new boost::asio::io_service),
+    io_work_(new boost::asio::io_service::work(*io_service_)),
+    parse_work_(new boost::asio::io_service::work(*parse_service_))
+{
+    io_thread_ = boost::thread(boost::bind(&runConfigured, std::string("rx_io"),
+                                           io_thread, io_service_.get()));
+    if (parse_threads == 0)
+        parse_threads = 1;
+    for (std::size_t i = 0; i < parse_threads; ++i)
+    {
+        parse_threads_.create_thread(
+            boost::bind(&runConfigured, "rx_parse" + std::to_string(i),
+                        parse_thread, parse_service_.get()));
+    }
+}
+
+io_comm_rx::SharedReactor::~SharedReactor()
+{
+    io_work_.reset();
+    parse_work_.reset();
+    io_service_->stop();
+    parse_service_->stop();
+    io_thread_.join();
+    parse_threads_.join_all();
+}
@@ -0,0 +1,178 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <limits>
+// ROSaic includes
+#include <septentrio_gnss_driver/communication/stream_monitor.hpp>
+
+/**
+ * @file stream_monitor.cpp
+ * @date 16/10/26
+ * @brief Defines a monitor of the rate and TOW continuity of the SBF blocks
+ */
+
+namespace {
+    //! Do-not-use values of TOW and WNc
+    const uint32_t TOW_DNU = 4294967295U;
+    const uint16_t WNC_DNU = 65535;
+    //! Milliseconds of a GPS week
+    const uint64_t WEEK_MS = 604800000;
+    //! Relaxation of the arrival reference per report for the clock drift [ms]
+    const int64_t DRIFT_PER_REPORT_MS = 1;
+} // namespace
+
+io_comm_rx::StreamMonitor::StreamMonitor() :
+    check_late_(true), size_(0), crc_errors_(0), false_syncs_(0),
+    discarded_bytes_(0), untracked_blocks_(0), reported_{}, last_degradation_{}
+{
+}
+
+io_comm_rx::StreamMonitor::Block* io_comm_rx::StreamMonitor::find(uint16_t block_id)
+{
+    for (std::size_t i = 0; i < size_; ++i)
+    {
+        if (blocks_[i].id == block_id)
+            return &blocks_[i];
+    }
+    if (size_ == MAX_BLOCKS)
+        return nullptr;
+    blocks_[size_].id = block_id;
+    auto interval = intervals_.find(block_id);
+    if (interval != intervals_.end())
+    {
+        blocks_[size_].expected_ms = interval->second;
+        blocks_[size_].fixed = true;
+    }
+    return &blocks_[size_++];
+}
+
+void io_comm_rx::StreamMonitor::setInterval(uint16_t block_id, uint32_t interval_ms)
+{
+    intervals_[block_id] = interval_ms;
+    for (std::size_t i = 0; i < size_; ++i)
+    {
+        if (blocks_[i].id == block_id)
+        {
+            blocks_[i].expected_ms = interval_ms;
+            blocks_[i].fixed = true;
+        }
+    }
+}
+
+void io_comm_rx::StreamMonitor::observe(uint16_t block_id, uint32_t tow,
+                                        uint16_t wnc, int64_t arrival_ms)
+{
+    if ((tow == TOW_DNU) || (wnc == WNC_DNU))
+        return;
+    Block* block = find(block_id);
+    if (!block)
+    {
+        ++untracked_blocks_;
+        return;
+    }
+    uint64_t time_ms = wnc * WEEK_MS + tow;
+    int64_t offset_ms = arrival_ms - static_cast<int64_t>(time_ms);
+    if (block->received == 0)
+    {
+        block->min_offset_ms = offset_ms;
+    } else if (time_ms <= block->last_ms)
+    {
+        ++block->out_of_order;
+        ++block->received;
+        return;
+    } else
+    {
+        uint64_t step = time_ms - block->last_ms;
+        if (!block->fixed)
+        {
+            if ((block->expected_ms == 0) ||
+                ((step < block->expected_ms) && (step == block->last_step_ms)))
+                block->expected_ms = static_cast<uint32_t>(step);
+            block->last_step_ms = step;
+        }
+        block->step_sum_ms += step;
+        ++block->steps;
+        if (offset_ms < block->min_offset_ms)
+            block->min_offset_ms = offset_ms;
+        if (block->expected_ms > 0)
+        {
+            // Rounded, as TOWs may not be exact multiples of the interval
+            uint64_t intervals =
+                (step + block->expected_ms / 2) / block->expected_ms;
+            if (intervals > 1)
+                block->missing += static_cast<uint32_t>(intervals - 1);
+            if (check_late_ && (offset_ms - block->min_offset_ms >
+                                static_cast<int64_t>(block->expected_ms)))
+                ++block->late;
+        }
+    }
+    block->last_ms = time_ms;
+    ++block->received;
+}
+
+bool io_comm_rx::StreamMonitor::report(StreamStatusMsg& msg)
+{
+    msg.crc_errors = crc_errors_;
+    msg.false_syncs = false_syncs_;
+    msg.discarded_bytes = discarded_bytes_;
+    msg.untracked_blocks = untracked_blocks_;
+    msg.blocks.resize(size_);
+    std::array<uint32_t, 4> totals = {0, 0, 0, crc_errors_};
+    for (std::size_t i = 0; i < size_; ++i)
+    {
+        Block& block = blocks_[i];
+        StreamBlockStatusMsg& status = msg.blocks[i];
+        status.block_id = block.id;
+        status.expected_interval = block.expected_ms;
+        status.observed_interval =
+            (block.steps > 0)
+                ? static_cast<float>(block.step_sum_ms) / block.steps
+                : std::numeric_limits<float>::quiet_NaN();
+        status.received = block.received;
+        status.missing = block.missing;
+        status.late = block.late;
+        status.out_of_order = block.out_of_order;
+        totals[0] += block.missing;
+        totals[1] += block.late;
+        totals[2] += block.out_of_order;
+        block.step_sum_ms = 0;
+        block.steps = 0;
+        block.min_offset_ms += DRIFT_PER_REPORT_MS;
+    }
+    bool degraded = false;
+    for (std::size_t i = 0; i < totals.size(); ++i)
+    {
+        last_degradation_[i] = totals[i] - reported_[i];
+        degraded = degraded || (last_degradation_[i] > 0);
+    }
+    reported_ = totals;
+    return degraded;
+}
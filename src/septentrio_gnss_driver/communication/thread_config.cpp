@@ -0,0 +1,97 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+// Linux includes
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+// ROSaic includes
+#include <septentrio_gnss_driver/communication/thread_config.hpp>
+
+/**
+ * @file thread_config.cpp
+ * @date 16/10/26
+ * @brief Defines the naming, pinning and scheduling of the driver's threads
+ */
+
+std::string io_comm_rx::configureThread(const std::string& name,
+                                        const ThreadSettings& settings)
+{
+    std::string errors;
+    auto fail = [&errors](const std::string& what, int error) {
+        if (!errors.empty())
+            errors += ", ";
+        errors += what + ": " + std::strerror(error);
+    };
+
+    // Linux limits thread names to 16 bytes including the terminating zero
+    int ret = pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+    if (ret != 0)
+        fail("name", ret);
+
+    if (!settings.cpus.empty())
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (int cpu : settings.cpus)
+        {
+            if ((cpu >= 0) && (cpu < CPU_SETSIZE))
+                CPU_SET(cpu, &cpus);
+        }
+        ret = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (ret != 0)
+            fail("affinity", ret);
+    }
+
+    if ((settings.policy == "fifo") || (settings.policy == "rr"))
+    {
+        int policy = (settings.policy == "fifo") ? SCHED_FIFO : SCHED_RR;
+        sched_param param;
+        param.sched_priority =
+            std::min(std::max(settings.priority, sched_get_priority_min(policy)),
+                     sched_get_priority_max(policy));
+        ret = pthread_setschedparam(pthread_self(), policy, &param);
+        if (ret != 0)
+            fail("policy " + settings.policy, ret);
+    } else if (settings.nice != 0)
+    {
+        // On Linux the nice value is a per-thread attribute, addressed by its TID
+        if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)),
+                        settings.nice) != 0)
+            fail("nice", errno);
+    }
+    return errors;
+}
@@ -39,10 +39,39 @@
 int main(int argc, char** argv)
 {
     ros::init(argc, argv, "septentrio_gnss");
-  	
-    rosaic_node::ROSaicNode
-        rx_node; // This launches everything we need, in theory :)
-    ros::spin();
-    
+
+    // Several Rxs may be handled by this process, each with its parameters in the
+    // private sub-namespace of its name. They then share one I/O thread and a
+    // bounded pool of parsing threads.
+    ros::NodeHandle pnh("~");
+    std::vector<std::string> receivers;
+    pnh.param("receivers", receivers, std::vector<std::string>());
+    if (receivers.empty())
+    {
+        rosaic_node::ROSaicNode
+            rx_node; // This launches everything we need, in theory :)
+        ros::spin();
+        return 0;
+    }
+
+    int parse_threads;
+    pnh.param("parse_threads", parse_threads,
+              static_cast<int>(std::min<std::size_t>(
+                  receivers.size(),
+                  std::max(1u, boost::thread::hardware_concurrency()))));
+    ThreadSettings io_thread;
+    ThreadSettings parse_thread;
+    rosaic_node::getThreadParams(pnh, "io", io_thread);
+    rosaic_node::getThreadParams(pnh, "parse", parse_thread);
+    boost::shared_ptr<io_comm_rx::SharedReactor> reactor(
+        new io_comm_rx::SharedReactor(std::max(parse_threads, 1), io_thread,
+                                      parse_thread));
+    {
+        std::vector<std::unique_ptr<rosaic_node::ROSaicNode>> rx_nodes;
+        for (const auto& receiver : receivers)
+            rx_nodes.emplace_back(new rosaic_node::ROSaicNode(receiver, reactor));
+        ros::spin();
+    } // Rx links are closed before the reactor is stopped
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,889 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C library includes
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+// C++ library includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+// ROSaic includes
+#include <septentrio_gnss_driver/crc/crc.h>
+
+/**
+ * @file mock_rx.cpp
+ * @date 16/10/26
+ * @brief Mock Rx answering the commands of the driver and streaming SBF/NMEA, for
+ * testing the I/O path without hardware
+ */
+
+namespace {
+
+    typedef std::chrono::system_clock Clock;
+
+    //! Milliseconds between the Unix and the GPS epoch
+    constexpr int64_t GPS_EPOCH_UNIX_MS = 315964800000;
+    //! Milliseconds of a GPS week
+    constexpr int64_t WEEK_MS = 604800000;
+    //! Leap seconds reported in ReceiverTime and contained in the GPS time
+    constexpr int8_t LEAP_SECONDS = 18;
+
+    //! Command line options
+    struct Options
+    {
+        //! TCP port listened on, unless a pty is used
+        uint16_t tcp_port = 28784;
+        //! Whether to emulate a serial port by a pty
+        bool pty = false;
+        //! Connection descriptor, e.g. IP10 or COM1
+        std::string cd;
+        //! Recorded SBF/NMEA log replayed instead of synthetic blocks
+        std::string log;
+        //! Epoch rate in Hz overriding the intervals of the sso commands, 0 if
+        //! not overridden
+        double rate = 0.0;
+        //! Emulated baud rate throttling the output, 0 for no throttling
+        uint32_t baudrate = 0;
+        //! Multiple of the realistic rates of INSNavGeod, ExtSensorMeas and
+        //! MeasEpoch sent regardless of the stream intervals, 0 if not stressing
+        double stress = 0.0;
+        //! Period of the output bursts [s], 0 for no bursts
+        double burst_period = 0.0;
+        //! Time the output is held back at the start of each burst period [ms]
+        int64_t burst_hold_ms = 0;
+    };
+
+    //! Block sent at its own rate in stress mode
+    struct Profile
+    {
+        //! Name of the SBF block
+        std::string name;
+        //! Realistic output rate of the block [Hz]
+        double rate;
+        //! Next output of the block
+        Clock::time_point next;
+    };
+
+    //! Output stream configured by an sso or sno command
+    struct Stream
+    {
+        //! Names of the SBF blocks or NMEA sentences of the stream
+        std::set<std::string> messages;
+        //! Output interval [ms]
+        int64_t interval_ms;
+        //! Next output of the stream
+        Clock::time_point next;
+    };
+
+    //! Appends a little-endian value to a buffer
+    template <typename T>
+    void put(std::vector<uint8_t>& buffer, T value)
+    {
+        uint8_t bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    //! Parses an output interval such as msec100, sec1 or OnChange [ms], 0 if off
+    int64_t intervalMs(const std::string& interval, int64_t on_change_ms)
+    {
+        if (interval.compare(0, 4, "msec") == 0)
+            return std::max(1, std::atoi(interval.c_str() + 4));
+        if (interval.compare(0, 3, "sec") == 0)
+            return 1000 * std::max(1, std::atoi(interval.c_str() + 3));
+        if (interval.compare(0, 3, "min") == 0)
+            return 60000 * std::max(1, std::atoi(interval.c_str() + 3));
+        if (interval == "OnChange")
+            return on_change_ms;
+        return 0;
+    }
+
+    //! Splits a command into its comma-separated, trimmed arguments
+    std::vector<std::string> arguments(const std::string& cmd)
+    {
+        std::vector<std::string> args;
+        std::stringstream ss(cmd);
+        std::string arg;
+        while (std::getline(ss, arg, ','))
+        {
+            std::size_t first = arg.find_first_not_of(' ');
+            std::size_t last = arg.find_last_not_of(' ');
+            args.push_back(first == std::string::npos
+                               ? std::string()
+                               : arg.substr(first, last - first + 1));
+        }
+        return args;
+    }
+
+    /**
+     * @class MockRx
+     * @brief Emulates the command interface and the output of a Septentrio Rx on
+     * one connection
+     *
+     * Every carriage return received is answered by the prompt, i.e. the connection
+     * descriptor, and every command by its "$R:" echo. sso and sno commands
+     * configure the output streams, which are sent at their intervals: synthetic
+     * PVTGeodetic and ReceiverTime blocks stamped with the current GPS time, or the
+     * epochs of a recorded log, replayed in a loop on the fastest stream.
+     */
+    class MockRx
+    {
+    public:
+        /**
+         * @brief Constructor of the class MockRx
+         * @param[in] options Command line options
+         * @param[in] epochs Epochs of the recorded log, empty for synthetic blocks
+         */
+        MockRx(const Options& options, const std::vector<std::string>& epochs) :
+            options_(options), epochs_(epochs)
+        {
+        }
+
+        /**
+         * @brief Serves a connection until the peer closes it
+         * @param[in] fd File descriptor of the connection
+         */
+        void serve(int fd)
+        {
+            fd_ = fd;
+            connected_ = true;
+            streams_.clear();
+            next_write_ = Clock::now();
+            std::thread streamer(options_.stress > 0.0 ? &MockRx::streamStress
+                                                       : &MockRx::streamData,
+                                 this);
+            readCommands();
+            connected_ = false;
+            streamer.join();
+            report();
+        }
+
+    private:
+        //! Reads commands, which are terminated by carriage returns
+        void readCommands()
+        {
+            std::string line;
+            char buffer[1024];
+            while (true)
+            {
+                ssize_t n = ::read(fd_, buffer, sizeof(buffer));
+                if (n <= 0)
+                    return;
+                for (ssize_t i = 0; i < n; ++i)
+                {
+                    if ((buffer[i] == '\r') || (buffer[i] == '\n'))
+                    {
+                        if (buffer[i] == '\r')
+                            handleCommand(line);
+                        line.clear();
+                    } else
+                        line += buffer[i];
+                }
+            }
+        }
+
+        //! Answers a command and applies it if it configures an output stream
+        void handleCommand(const std::string& line)
+        {
+            std::string prompt = options_.cd + ">";
+            std::string cmd(line);
+            cmd.erase(0, cmd.find_first_not_of(' '));
+            cmd.erase(cmd.find_last_not_of(' ') + 1);
+            // Empty lines and the escape sequence only return the prompt
+            if (cmd.empty() || (cmd.find_first_not_of('S') == std::string::npos))
+            {
+                write(prompt);
+                return;
+            }
+            ++commands_;
+            std::vector<std::string> args = arguments(cmd);
+            if (!std::isalpha(static_cast<unsigned char>(cmd[0])))
+            {
+                write("$R? " + cmd + ": Invalid command!\r\n" + prompt);
+                return;
+            }
+            const std::string& name = args[0];
+            bool sbf = (name == "sso") || (name == "setSBFOutput");
+            bool nmea = (name == "sno") || (name == "setNMEAOutput");
+            if ((sbf || nmea) && (args.size() >= 5))
+                configureStream(nmea, args);
+            write("$R: " + cmd + "\r\n" + prompt);
+        }
+
+        //! Sets or clears output streams. Like on a Rx, a list starting with "+"
+        //! or "-" adds to or removes from the messages of the stream, any other
+        //! list replaces them.
+        void configureStream(bool nmea, const std::vector<std::string>& args)
+        {
+            std::string kind(nmea ? "NMEA " : "SBF ");
+            std::string key = kind + args[1];
+            int64_t interval = intervalMs(args[4], onChangeMs());
+            std::string list(args[3]);
+            list.erase(std::remove(list.begin(), list.end(), ' '), list.end());
+            bool relative =
+                !list.empty() && ((list[0] == '+') || (list[0] == '-'));
+
+            std::lock_guard<std::mutex> lock(streams_mutex_);
+            std::set<std::string> messages;
+            auto current = streams_.find(key);
+            if (relative && (current != streams_.end()))
+                messages = current->second.messages;
+            char op = '+';
+            std::string message;
+            for (std::size_t i = 0; i <= list.size(); ++i)
+            {
+                if ((i < list.size()) && (list[i] != '+') && (list[i] != '-'))
+                {
+                    message += list[i];
+                    continue;
+                }
+                if (!message.empty() && (message != "none"))
+                {
+                    if (op == '+')
+                        messages.insert(message);
+                    else
+                        messages.erase(message);
+                }
+                message.clear();
+                if (i < list.size())
+                    op = list[i];
+            }
+
+            if (args[1] == "all")
+            {
+                for (auto it = streams_.begin(); it != streams_.end();)
+                {
+                    if (it->first.compare(0, kind.size(), kind) == 0)
+                        it = streams_.erase(it);
+                    else
+                        ++it;
+                }
+                return;
+            }
+            if (messages.empty() || (interval == 0))
+            {
+                streams_.erase(key);
+                return;
+            }
+            // Output happens at multiples of the interval like on a Rx
+            int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                 Clock::now().time_since_epoch())
+                                 .count();
+            int64_t next_ms = (now_ms / interval + 1) * interval;
+            streams_[key] = Stream{messages, interval,
+                                   Clock::time_point(
+                                       std::chrono::milliseconds(next_ms))};
+        }
+
+        //! Interval of OnChange streams and of all streams if a rate is given [ms]
+        int64_t onChangeMs() const
+        {
+            return options_.rate > 0.0
+                       ? std::max<int64_t>(1, std::llround(1000.0 / options_.rate))
+                       : 100;
+        }
+
+        //! Sends the output streams at their intervals
+        void streamData()
+        {
+            std::vector<uint8_t> data;
+            auto last_report = Clock::now();
+            while (connected_)
+            {
+                Clock::time_point due = Clock::now() + std::chrono::milliseconds(10);
+                std::string key;
+                std::set<std::string> messages;
+                bool fastest = false;
+                {
+                    std::lock_guard<std::mutex> lock(streams_mutex_);
+                    int64_t min_interval = 0;
+                    for (const auto& stream : streams_)
+                    {
+                        if ((min_interval == 0) ||
+                            (stream.second.interval_ms < min_interval))
+                            min_interval = stream.second.interval_ms;
+                        if (stream.second.next < due)
+                        {
+                            due = stream.second.next;
+                            key = stream.first;
+                        }
+                    }
+                    if (!key.empty())
+                    {
+                        Stream& stream = streams_[key];
+                        messages = stream.messages;
+                        fastest = (stream.interval_ms == min_interval);
+                        int64_t interval = (options_.rate > 0.0)
+                                               ? onChangeMs()
+                                               : stream.interval_ms;
+                        stream.next += std::chrono::milliseconds(interval);
+                    }
+                }
+                std::this_thread::sleep_until(due);
+                if (!key.empty())
+                {
+                    data.clear();
+                    if (epochs_.empty())
+                        synthesize(due, messages, data);
+                    else if (fastest)
+                    {
+                        const std::string& epoch = epochs_[epoch_index_];
+                        data.assign(epoch.begin(), epoch.end());
+                        epoch_index_ = (epoch_index_ + 1) % epochs_.size();
+                    }
+                    if (!data.empty())
+                    {
+                        write(data.data(), data.size());
+                        ++epochs_sent_;
+                    }
+                }
+                if (Clock::now() - last_report > std::chrono::seconds(10))
+                {
+                    last_report = Clock::now();
+                    report();
+                }
+            }
+        }
+
+        /**
+         * @brief Sends INSNavGeod, ExtSensorMeas and MeasEpoch at multiples of
+         * 200, 400 and 20 Hz as long as any stream lists them, holding the output
+         * back at the start of each burst period and then sending it at once
+         */
+        void streamStress()
+        {
+            std::vector<Profile> profiles = {{"INSNavGeod", 200.0, Clock::now()},
+                                             {"ExtSensorMeas", 400.0, Clock::now()},
+                                             {"MeasEpoch", 20.0, Clock::now()}};
+            std::vector<uint8_t> data;
+            std::vector<uint8_t> held;
+            auto start = Clock::now();
+            auto last_report = start;
+            while (connected_)
+            {
+                auto profile =
+                    std::min_element(profiles.begin(), profiles.end(),
+                                     [](const Profile& a, const Profile& b) {
+                                         return a.next < b.next;
+                                     });
+                Clock::time_point due = std::min(
+                    profile->next, Clock::now() + std::chrono::milliseconds(10));
+                std::this_thread::sleep_until(due);
+                bool holding = false;
+                if (options_.burst_period > 0.0)
+                {
+                    int64_t period_ms = std::llround(1000.0 * options_.burst_period);
+                    int64_t phase_ms =
+                        std::chrono::duration_cast<std::chrono::milliseconds>(due -
+                                                                              start)
+                            .count() %
+                        period_ms;
+                    holding = phase_ms < options_.burst_hold_ms;
+                }
+                if (!holding && !held.empty())
+                {
+                    write(held.data(), held.size());
+                    held.clear();
+                }
+                if (due == profile->next)
+                {
+                    profile->next += std::chrono::microseconds(
+                        std::llround(1e6 / (profile->rate * options_.stress)));
+                    if (listed(profile->name))
+                    {
+                        data.clear();
+                        synthesize(due, {profile->name}, data);
+                        if (holding)
+                            held.insert(held.end(), data.begin(), data.end());
+                        else
+                            write(data.data(), data.size());
+                        ++epochs_sent_;
+                    }
+                }
+                if (Clock::now() - last_report > std::chrono::seconds(10))
+                {
+                    last_report = Clock::now();
+                    report();
+                }
+            }
+        }
+
+        //! Whether any output stream lists the message
+        bool listed(const std::string& message)
+        {
+            std::lock_guard<std::mutex> lock(streams_mutex_);
+            for (const auto& stream : streams_)
+            {
+                if (stream.second.messages.count(message))
+                    return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Appends the synthetic blocks of a stream, stamped with time
+         *
+         * INSNavGeod (in GNSSAge), ExtSensorMeas (in the x-axis acceleration) and
+         * MeasEpoch (in the code of the first channel) carry a sequence number
+         * per block, from which lost blocks can be counted.
+         */
+        void synthesize(Clock::time_point time,
+                        const std::set<std::string>& messages,
+                        std::vector<uint8_t>& data)
+        {
+            int64_t unix_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                  time.time_since_epoch())
+                                  .count();
+            int64_t gps_ms = unix_ms - GPS_EPOCH_UNIX_MS + LEAP_SECONDS * 1000;
+            uint32_t tow = static_cast<uint32_t>(gps_ms % WEEK_MS);
+            uint16_t wnc = static_cast<uint16_t>(gps_ms / WEEK_MS);
+
+            if (messages.count("PVTGeodetic"))
+            {
+                std::size_t start = beginBlock(data, 4007, 2, tow, wnc);
+                put<uint8_t>(data, 1);                     // Mode: standalone
+                put<uint8_t>(data, 0);                     // Error
+                put<double>(data, 50.8792 * M_PI / 180.0); // Latitude
+                put<double>(data, 4.7005 * M_PI / 180.0);  // Longitude
+                put<double>(data, 100.0);                  // Height
+                put<float>(data, 47.0f);                   // Undulation
+                put<float>(data, 0.0f);                    // Vn
+                put<float>(data, 0.0f);                    // Ve
+                put<float>(data, 0.0f);                    // Vu
+                put<float>(data, -2e10f);                  // COG: do-not-use
+                put<double>(data, 0.0);                    // RxClkBias
+                put<float>(data, 0.0f);                    // RxClkDrift
+                put<uint8_t>(data, 0);                     // TimeSystem: GPS
+                put<uint8_t>(data, 0);                     // Datum: WGS84
+                put<uint8_t>(data, 12);                    // NrSV
+                put<uint8_t>(data, 0);                     // WACorrInfo
+                put<uint16_t>(data, 65535);                // ReferenceID
+                put<uint16_t>(data, 65535);                // MeanCorrAge
+                put<uint32_t>(data, 1);                    // SignalInfo: GPS L1CA
+                put<uint8_t>(data, 0);                     // AlertFlag
+                put<uint8_t>(data, 0);                     // NrBases
+                put<uint16_t>(data, 0);                    // PPPInfo
+                put<uint16_t>(data, 0);                    // Latency
+                put<uint16_t>(data, 150);                  // HAccuracy [cm]
+                put<uint16_t>(data, 250);                  // VAccuracy [cm]
+                put<uint8_t>(data, 0);                     // Misc
+                finishBlock(data, start);
+            }
+            if (messages.count("ReceiverTime"))
+            {
+                std::time_t utc_s = static_cast<std::time_t>(unix_ms / 1000);
+                std::tm utc;
+                gmtime_r(&utc_s, &utc);
+                std::size_t start = beginBlock(data, 5914, 0, tow, wnc);
+                put<int8_t>(data, static_cast<int8_t>(utc.tm_year - 100));
+                put<int8_t>(data, static_cast<int8_t>(utc.tm_mon + 1));
+                put<int8_t>(data, static_cast<int8_t>(utc.tm_mday));
+                put<int8_t>(data, static_cast<int8_t>(utc.tm_hour));
+                put<int8_t>(data, static_cast<int8_t>(utc.tm_min));
+                put<int8_t>(data, static_cast<int8_t>(utc.tm_sec));
+                put<int8_t>(data, LEAP_SECONDS);
+                put<uint8_t>(data, 3); // SyncLevel: fully synchronized
+                finishBlock(data, start);
+            }
+            if (messages.count("INSNavGeod"))
+            {
+                std::size_t start = beginBlock(data, 4226, 0, tow, wnc);
+                put<uint8_t>(data, 4);                     // GNSSMode: RTK fixed
+                put<uint8_t>(data, 0);                     // Error
+                put<uint16_t>(data, 0);                    // Info
+                put<uint16_t>(data, sequences_[0]++);      // GNSSAge: sequence
+                put<double>(data, 50.8792 * M_PI / 180.0); // Latitude
+                put<double>(data, 4.7005 * M_PI / 180.0);  // Longitude
+                put<double>(data, 100.0);                  // Height
+                put<float>(data, 47.0f);                   // Undulation
+                put<uint16_t>(data, 2);                    // Accuracy [cm]
+                put<uint16_t>(data, 5);                    // Latency [0.1 ms]
+                put<uint8_t>(data, 0);                     // Datum: WGS84
+                put<uint8_t>(data, 0);                     // Reserved
+                put<uint16_t>(data, 1 | 2 | 8); // SBList: PosStdDev, Att, Vel
+                for (float value : {0.01f, 0.01f, 0.02f, 90.0f, 0.5f, -0.5f, 0.0f,
+                                    0.0f, 0.0f})
+                    put<float>(data, value);
+                finishBlock(data, start);
+            }
+            if (messages.count("ExtSensorMeas"))
+            {
+                std::size_t start = beginBlock(data, 4050, 0, tow, wnc);
+                put<uint8_t>(data, 2);  // N
+                put<uint8_t>(data, 28); // SBLength
+                for (uint8_t type : {0, 1})
+                {
+                    put<uint8_t>(data, 0);    // Source: internal IMU
+                    put<uint8_t>(data, 0);    // SensorModel
+                    put<uint8_t>(data, type); // Type: acceleration or rate
+                    put<uint8_t>(data, 0);    // ObsInfo
+                    put<double>(data, type == 0 ? sequences_[1]++ : 0.0);
+                    put<double>(data, 0.0);
+                    put<double>(data, type == 0 ? 9.81 : 0.0);
+                }
+                finishBlock(data, start);
+            }
+            if (messages.count("MeasEpoch"))
+            {
+                const uint8_t channels = 30;
+                std::size_t start = beginBlock(data, 4027, 1, tow, wnc);
+                put<uint8_t>(data, channels); // N1
+                put<uint8_t>(data, 20);       // SB1Length
+                put<uint8_t>(data, 12);       // SB2Length
+                put<uint8_t>(data, 0);        // CommonFlags
+                put<uint8_t>(data, 0);        // CumClkJumps
+                put<uint8_t>(data, 0);        // Reserved
+                for (uint8_t channel = 0; channel < channels; ++channel)
+                {
+                    put<uint8_t>(data, channel + 1);        // RxChannel
+                    put<uint8_t>(data, 0);                  // Type: GPS L1CA
+                    put<uint8_t>(data, channel % 32 + 1);   // SVID
+                    put<uint8_t>(data, 0);                  // Misc
+                    put<uint32_t>(data, channel == 0 ? sequences_[2]++
+                                                     : 1000000u); // CodeLSB
+                    put<int32_t>(data, 0);                  // Doppler
+                    put<uint16_t>(data, 0);                 // CarrierLSB
+                    put<int8_t>(data, 0);                   // CarrierMSB
+                    put<uint8_t>(data, 180);                // CN0
+                    put<uint16_t>(data, 600);               // LockTime
+                    put<uint8_t>(data, 0);                  // ObsInfo
+                    put<uint8_t>(data, 1);                  // N2
+                    put<uint8_t>(data, 3);                  // Type: GPS L2C
+                    put<uint8_t>(data, 60);                 // LockTime
+                    put<uint8_t>(data, 160);                // CN0
+                    put<uint8_t>(data, 0);                  // OffsetsMSB
+                    put<int8_t>(data, 0);                   // CarrierMSB
+                    put<uint8_t>(data, 0);                  // ObsInfo
+                    put<uint16_t>(data, 0);                 // CodeOffsetLSB
+                    put<uint16_t>(data, 0);                 // CarrierLSB
+                    put<uint16_t>(data, 0);                 // DopplerOffsetLSB
+                }
+                finishBlock(data, start);
+            }
+        }
+
+        //! Appends the header of an SBF block and returns its start
+        std::size_t beginBlock(std::vector<uint8_t>& data, uint16_t id,
+                               uint16_t revision, uint32_t tow, uint16_t wnc)
+        {
+            std::size_t start = data.size();
+            data.push_back('$');
+            data.push_back('@');
+            put<uint16_t>(data, 0); // CRC
+            put<uint16_t>(data, static_cast<uint16_t>(id | (revision << 13)));
+            put<uint16_t>(data, 0); // Length
+            put<uint32_t>(data, tow);
+            put<uint16_t>(data, wnc);
+            return start;
+        }
+
+        //! Pads an SBF block to a multiple of 4 bytes and fills in length and CRC
+        void finishBlock(std::vector<uint8_t>& data, std::size_t start)
+        {
+            while ((data.size() - start) % 4 != 0)
+                data.push_back(0);
+            uint16_t length = static_cast<uint16_t>(data.size() - start);
+            std::memcpy(&data[start + 6], &length, 2);
+            uint16_t crc = compute16CCITT(&data[start + 4], length - 4);
+            std::memcpy(&data[start + 2], &crc, 2);
+        }
+
+        //! Writes text to the connection
+        void write(const std::string& text)
+        {
+            write(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+        }
+
+        /**
+         * @brief Writes data to the connection, no faster than the emulated baud
+         * rate allows
+         * @param[in] data Pointer to the data
+         * @param[in] size Size of the data
+         */
+        void write(const uint8_t* data, std::size_t size)
+        {
+            std::lock_guard<std::mutex> lock(write_mutex_);
+            // 10 bits per byte with start and stop bit
+            const std::size_t chunk = options_.baudrate > 0 ? 64 : size;
+            while (size > 0)
+            {
+                std::size_t n = std::min(chunk, size);
+                if (options_.baudrate > 0)
+                {
+                    std::this_thread::sleep_until(next_write_);
+                    next_write_ =
+                        std::max(next_write_, Clock::now()) +
+                        std::chrono::microseconds(10000000ull * n /
+                                                  options_.baudrate);
+                }
+                ssize_t written = ::write(fd_, data, n);
+                if (written <= 0)
+                    return;
+                data += written;
+                size -= static_cast<std::size_t>(written);
+                bytes_sent_ += static_cast<uint64_t>(written);
+            }
+        }
+
+        //! Prints the statistics of the connection
+        void report()
+        {
+            std::cout << "Mock Rx: " << commands_ << " commands answered, "
+                      << epochs_sent_ << " outputs and " << bytes_sent_
+                      << " bytes sent" << std::endl;
+        }
+
+        //! Command line options
+        Options options_;
+        //! Epochs of the recorded log
+        const std::vector<std::string>& epochs_;
+        //! Next epoch of the recorded log to be sent
+        std::size_t epoch_index_ = 0;
+        //! Sequence numbers of INSNavGeod, ExtSensorMeas and MeasEpoch
+        uint32_t sequences_[3] = {0, 0, 0};
+        //! File descriptor of the connection
+        int fd_ = -1;
+        //! Whether the connection is open
+        std::atomic<bool> connected_{false};
+        //! Output streams by kind and stream name
+        std::map<std::string, Stream> streams_;
+        //! Protects streams_
+        std::mutex streams_mutex_;
+        //! Serializes the replies and the output
+        std::mutex write_mutex_;
+        //! Earliest time of the next write at the emulated baud rate
+        Clock::time_point next_write_;
+        //! Statistics of the connection
+        std::atomic<uint64_t> commands_{0};
+        std::atomic<uint64_t> epochs_sent_{0};
+        std::atomic<uint64_t> bytes_sent_{0};
+    };
+
+    /**
+     * @brief Splits a recorded log into epochs, SBF blocks of equal TOW and the
+     * NMEA sentences following them
+     * @param[in] file_name Path of the log
+     * @return The epochs, empty if the log could not be read
+     */
+    std::vector<std::string> loadEpochs(const std::string& file_name)
+    {
+        std::ifstream file(file_name, std::ios::binary);
+        std::string log((std::istreambuf_iterator<char>(file)),
+                        std::istreambuf_iterator<char>());
+        std::vector<std::string> epochs;
+        std::size_t epoch_start = 0;
+        bool has_tow = false;
+        uint32_t epoch_tow = 0;
+        std::size_t pos = 0;
+        while (pos + 14 <= log.size())
+        {
+            const uint8_t* block = reinterpret_cast<const uint8_t*>(&log[pos]);
+            uint16_t length;
+            std::memcpy(&length, block + 6, 2);
+            if ((block[0] != '$') || (block[1] != '@') || (length < 14) ||
+                (length % 4 != 0) || (pos + length > log.size()) ||
+                (compute16CCITT(block + 4, length - 4) !=
+                 static_cast<uint16_t>(block[2] | (block[3] << 8))))
+            {
+                ++pos;
+                continue;
+            }
+            uint32_t tow;
+            std::memcpy(&tow, block + 8, 4);
+            if (has_tow && (tow != epoch_tow) && (pos > epoch_start))
+            {
+                epochs.push_back(log.substr(epoch_start, pos - epoch_start));
+                epoch_start = pos;
+            }
+            has_tow = true;
+            epoch_tow = tow;
+            pos += length;
+        }
+        if (log.size() > epoch_start)
+            epochs.push_back(log.substr(epoch_start));
+        return epochs;
+    }
+
+    //! Opens a pty, whose slave is the serial port the driver connects to
+    int openPty()
+    {
+        int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+        if ((master < 0) || (::grantpt(master) != 0) || (::unlockpt(master) != 0))
+            return -1;
+        // The slave is kept open and raw, so that the master neither fails nor
+        // echoes while the driver is not connected
+        int slave = ::open(::ptsname(master), O_RDWR | O_NOCTTY);
+        if (slave >= 0)
+        {
+            struct termios tio;
+            ::tcgetattr(slave, &tio);
+            ::cfmakeraw(&tio);
+            ::tcsetattr(slave, TCSANOW, &tio);
+        }
+        std::cout << "Mock Rx: serial port is " << ::ptsname(master) << std::endl;
+        return master;
+    }
+
+    //! Opens a TCP socket listening on port
+    int listenTcp(uint16_t port)
+    {
+        int server = ::socket(AF_INET, SOCK_STREAM, 0);
+        int on = 1;
+        ::setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons(port);
+        if ((server < 0) ||
+            (::bind(server, reinterpret_cast<sockaddr*>(&address),
+                    sizeof(address)) != 0) ||
+            (::listen(server, 1) != 0))
+            return -1;
+        std::cout << "Mock Rx: listening on tcp://localhost:" << port << std::endl;
+        return server;
+    }
+
+    void usage()
+    {
+        std::cerr << "Usage: mock_rx [-t tcp_port | -p] [-f log.sbf] [-r rate_hz] "
+                     "[-b baudrate] [-c connection_descriptor] [-s factor] "
+                     "[-B period_s:hold_ms]"
+                  << std::endl;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    std::vector<std::string> args;
+    // Arguments added by roslaunch are skipped
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::string(argv[i]).compare(0, 2, "__") != 0)
+            args.push_back(argv[i]);
+    }
+    for (std::size_t i = 0; i < args.size(); ++i)
+    {
+        if (args[i] == "-p")
+            options.pty = true;
+        else if ((i + 1 < args.size()) && (args[i] == "-t"))
+            options.tcp_port = static_cast<uint16_t>(std::atoi(args[++i].c_str()));
+        else if ((i + 1 < args.size()) && (args[i] == "-f"))
+            options.log = args[++i];
+        else if ((i + 1 < args.size()) && (args[i] == "-r"))
+            options.rate = std::atof(args[++i].c_str());
+        else if ((i + 1 < args.size()) && (args[i] == "-b"))
+            options.baudrate = static_cast<uint32_t>(std::atoi(args[++i].c_str()));
+        else if ((i + 1 < args.size()) && (args[i] == "-c"))
+            options.cd = args[++i];
+        else if ((i + 1 < args.size()) && (args[i] == "-s"))
+            options.stress = std::atof(args[++i].c_str());
+        else if ((i + 1 < args.size()) && (args[i] == "-B") &&
+                 (args[i + 1].find(':') != std::string::npos))
+        {
+            const std::string& burst = args[++i];
+            options.burst_period = std::atof(burst.c_str());
+            options.burst_hold_ms = std::atoll(burst.c_str() + burst.find(':') + 1);
+        }
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+    if (options.cd.empty())
+        options.cd = options.pty ? "COM1" : "IP10";
+    ::signal(SIGPIPE, SIG_IGN);
+
+    std::vector<std::string> epochs;
+    if (!options.log.empty())
+    {
+        epochs = loadEpochs(options.log);
+        if (epochs.empty())
+        {
+            std::cerr << "Could not read " << options.log << std::endl;
+            return 1;
+        }
+        std::cout << "Mock Rx: replaying " << epochs.size() << " epochs of "
+                  << options.log << std::endl;
+    }
+
+    MockRx rx(options, epochs);
+    if (options.pty)
+    {
+        int master = openPty();
+        if (master < 0)
+        {
+            std::cerr << "Could not open a pty" << std::endl;
+            return 1;
+        }
+        // The master reads nothing while no driver is connected to the slave
+        while (true)
+            rx.serve(master);
+    }
+    int server = listenTcp(options.tcp_port);
+    if (server < 0)
+    {
+        std::cerr << "Could not listen on port " << options.tcp_port << std::endl;
+        return 1;
+    }
+    while (true)
+    {
+        int client = ::accept(server, nullptr, nullptr);
+        if (client < 0)
+            continue;
+        int on = 1;
+        ::setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        std::cout << "Mock Rx: driver connected" << std::endl;
+        rx.serve(client);
+        ::close(client);
+        std::cout << "Mock Rx: driver disconnected" << std::endl;
+    }
+}
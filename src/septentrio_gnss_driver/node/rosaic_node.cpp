@@ -38,7 +38,18 @@
  * @brief The heart of the ROSaic driver: The ROS node that represents it
  */
 
-rosaic_node::ROSaicNode::ROSaicNode() : IO_(this, &settings_)
+rosaic_node::ROSaicNode::ROSaicNode() : IO_(this, &settings_) { setup(); }
+
+rosaic_node::ROSaicNode::ROSaicNode(
+    const std::string& receiver,
+    boost::shared_ptr<io_comm_rx::SharedReactor> reactor) :
+    ROSaicNodeBase(receiver),
+    IO_(this, &settings_, reactor)
+{
+    setup();
+}
+
+void rosaic_node::ROSaicNode::setup()
 {
     param("activate_debug_log", settings_.activate_debug_log, false);
     if (settings_.activate_debug_log)
@@ -52,7 +63,7 @@ rosaic_node::ROSaicNode::ROSaicNode() : IO_(this, &settings_)
 
     this->log(LogLevel::DEBUG, "Called ROSaicNode() constructor..");
 
-    tfListener_.reset(new tf2_ros::TransformListener(tfBuffer_));
+    setupTf();
 
     // Parameters must be set before initializing IO
     if (!getROSParams())
@@ -86,6 +97,7 @@ bool rosaic_node::ROSaicNode::getROSParams()
     param("vehicle_frame_id", settings_.vehicle_frame_id, settings_.poi_frame_id);
     param("local_frame_id", settings_.local_frame_id, (std::string) "odom");
     param("insert_local_frame", settings_.insert_local_frame, false);
+    param("local_frame_tolerance", settings_.local_frame_tolerance, 1.0);
     param("lock_utm_zone", settings_.lock_utm_zone, true);
     param("leap_seconds", settings_.leap_seconds, -128);
 
@@ -146,11 +158,14 @@ bool rosaic_node::ROSaicNode::getROSParams()
     param("publish/gpsfix", settings_.publish_gpsfix, false);
     param("publish/pose", settings_.publish_pose, false);
     param("publish/diagnostics", settings_.publish_diagnostics, false);
+    param("publish/streamstatus", settings_.publish_streamstatus, false);
     param("publish/gpgga", settings_.publish_gpgga, false);
     param("publish/gprmc", settings_.publish_gprmc, false);
     param("publish/gpgsa", settings_.publish_gpgsa, false);
     param("publish/gpgsv", settings_.publish_gpgsv, false);
+    param("publish/satellites", settings_.publish_satellites, false);
     param("publish/measepoch", settings_.publish_measepoch, false);
+    param("publish/rawobservables", settings_.publish_rawobservables, false);
     param("publish/pvtcartesian", settings_.publish_pvtcartesian, false);
     param("publish/pvtgeodetic", settings_.publish_pvtgeodetic,
           (settings_.septentrio_receiver_type == "gnss"));
@@ -176,6 +191,15 @@ bool rosaic_node::ROSaicNode::getROSParams()
     param("publish/exteventinsnavcart", settings_.publish_exteventinsnavcart, false);
     param("publish/extsensormeas", settings_.publish_extsensormeas, false);
     param("publish/imu", settings_.publish_imu, false);
+    param("publish/imubatch", settings_.publish_imubatch, false);
+    if (settings_.publish_imubatch)
+    {
+        getUint32Param("imu_batch/size", settings_.imu_batch_size,
+                       static_cast<uint32_t>(10));
+        param("imu_batch/max_delay", settings_.imu_batch_max_delay, 0.05);
+        if (settings_.imu_batch_size == 0)
+            settings_.imu_batch_size = 1;
+    }
     param("publish/localization", settings_.publish_localization, false);
     param("publish/twist", settings_.publish_twist, false);
     param("publish/tf", settings_.publish_tf, false);
@@ -463,6 +487,13 @@ bool rosaic_node::ROSaicNode::getROSParams()
         settings_.rtk_settings.serial.push_back(serialSettings);
     }
 
+    // Corrections from ROS
+    param("rtk_settings/ros/enabled", settings_.rtk_settings.ros.enabled, false);
+    param("rtk_settings/ros/rtk_standard", settings_.rtk_settings.ros.rtk_standard,
+          std::string("auto"));
+    if (settings_.rtk_settings.ros.enabled)
+        registerCorrectionsSubscriber();
+
     {
         // deprecation warnings
         std::string tempString;
@@ -610,6 +641,7 @@ bool rosaic_node::ROSaicNode::getROSParams()
         }
         if (ins_use_vsm)
         {
+            param("ins_vsm/ros/max_rate", settings_.ins_vsm_ros_max_rate, 0.0);
             this->log(LogLevel::INFO, "ins_vsm/ros/source " +
                                           settings_.ins_vsm_ros_source +
                                           " will be used.");
@@ -617,11 +649,74 @@ bool rosaic_node::ROSaicNode::getROSParams()
         }
     }
 
+    // SBF file replay
+    param("replay_start", settings_.replay_start, 0.0);
+    param("replay_end", settings_.replay_end, 0.0);
+
+    // Raw recording
+    param("raw_recording/directory", settings_.raw_recording_directory,
+          std::string(""));
+    getUint32Param("raw_recording/max_file_size",
+                   settings_.raw_recording_max_file_size,
+                   static_cast<uint32_t>(1000));
+    getUint32Param("raw_recording/max_file_duration",
+                   settings_.raw_recording_max_file_duration,
+                   static_cast<uint32_t>(3600));
+    getUint32Param("raw_recording/sync_period",
+                   settings_.raw_recording_sync_period,
+                   static_cast<uint32_t>(1000));
+
+    // Demand-driven output
+    param("demand_driven_output/enabled", settings_.demand_driven_output, false);
+    getUint32Param("demand_driven_output/hold_time",
+                   settings_.demand_driven_output_hold_time,
+                   static_cast<uint32_t>(5000));
+
+    // Threads
+    param("single_threaded", settings_.single_threaded, false);
+    getUint32Param("parse_handoff/spin", settings_.parse_handoff_spin,
+                   static_cast<uint32_t>(0));
+    getUint32Param("parse_handoff/yield", settings_.parse_handoff_yield,
+                   static_cast<uint32_t>(0));
+    getThreadParams(*pNh_, "io", settings_.thread_io);
+    getThreadParams(*pNh_, "parse", settings_.thread_parse);
+    getThreadParams(*pNh_, "wait", settings_.thread_wait);
+
     // To be implemented: RTCM, raw data settings, PPP, SBAS ...
     this->log(LogLevel::DEBUG, "Finished getROSParams() method");
     return true;
 }
 
+void rosaic_node::getThreadParams(const ros::NodeHandle& nh,
+                                  const std::string& thread,
+                                  ThreadSettings& settings)
+{
+    const std::string prefix = "threads/" + thread + "/";
+    nh.param(prefix + "cpus", settings.cpus, std::vector<int>());
+    nh.param(prefix + "policy", settings.policy, std::string("other"));
+    nh.param(prefix + "priority", settings.priority, 0);
+    nh.param(prefix + "nice", settings.nice, 0);
+    if (!((settings.policy == "other") || (settings.policy == "fifo") ||
+          (settings.policy == "rr")))
+    {
+        ROS_WARN_STREAM("Unknown " << prefix << "policy " << settings.policy
+                                   << ", use either other, fifo or rr.");
+        settings.policy = "other";
+    }
+    if ((settings.policy != "other") &&
+        ((settings.priority < 1) || (settings.priority > 99)))
+    {
+        ROS_WARN_STREAM(prefix << "priority has to be within 1 and 99 for policy "
+                               << settings.policy << ".");
+        settings.policy = "other";
+    }
+    if ((settings.nice < -20) || (settings.nice > 19))
+    {
+        ROS_WARN_STREAM(prefix << "nice has to be within -20 and 19.");
+        settings.nice = 0;
+    }
+}
+
 bool rosaic_node::ROSaicNode::validPeriod(uint32_t period, bool isIns)
 {
     return ((period == 0) || ((period == 5 && isIns)) || (period == 10) ||
@@ -643,8 +738,8 @@ void rosaic_node::ROSaicNode::getTransform(const std::string& targetFrame,
         try
         {
             // try to get tf from source frame to target frame
-            T_s_t = tfBuffer_.lookupTransform(targetFrame, sourceFrame, ros::Time(0),
-                                              ros::Duration(2.0));
+            T_s_t = tf_->buffer().lookupTransform(targetFrame, sourceFrame,
+                                                  ros::Time(0), ros::Duration(2.0));
             found = true;
         } catch (const tf2::TransformException& ex)
         {
@@ -667,7 +762,12 @@ void rosaic_node::ROSaicNode::getRPY(const QuaternionMsg& qm, double& roll,
     yaw = std::atan2(C(1, 0), C(0, 0));
 }
 
-void rosaic_node::ROSaicNode::sendVelocity(const std::string& velNmea)
+void rosaic_node::ROSaicNode::sendVelocity(const char* velNmea, std::size_t size)
+{
+    IO_.sendVelocity(velNmea, size);
+}
+
+void rosaic_node::ROSaicNode::sendCorrections(const RtcmMsg::ConstPtr& rtcm)
 {
-    IO_.sendVelocity(velNmea);
+    IO_.sendCorrections(rtcm);
 }
\ No newline at end of file
@@ -0,0 +1,143 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C++ library includes
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <vector>
+// ROS includes
+#include <ros/ros.h>
+// ROSaic includes
+#include <septentrio_gnss_driver/PVTGeodetic.h>
+
+/**
+ * @file rx_benchmark.cpp
+ * @date 16/10/26
+ * @brief Node measuring the end-to-end latency and the drop rate of the driver
+ * against the mock Rx
+ */
+
+namespace {
+
+    /**
+     * @class Benchmark
+     * @brief Measures the latency of PVTGeodetic messages and counts missing epochs
+     *
+     * The mock Rx stamps its blocks with the GPS time they are sent at, so with
+     * use_gnss_time the latency from the Rx's output to the subscriber is the
+     * difference between the reception time and the header stamp. Epochs are
+     * counted as dropped when the TOW advances by more than the output interval,
+     * which is the smallest TOW step seen.
+     */
+    class Benchmark
+    {
+    public:
+        /**
+         * @brief Constructor of the class Benchmark
+         * @param[in] nh Node handle subscribing to the driver
+         * @param[in] pnh Private node handle holding the parameters
+         */
+        Benchmark(ros::NodeHandle& nh, ros::NodeHandle& pnh)
+        {
+            double report_period;
+            pnh.param("report_period", report_period, 10.0);
+            sub_ = nh.subscribe("/pvtgeodetic", 1000, &Benchmark::callback, this,
+                                ros::TransportHints().tcpNoDelay());
+            timer_ = nh.createTimer(ros::Duration(report_period),
+                                    &Benchmark::report, this);
+        }
+
+    private:
+        void callback(const septentrio_gnss_driver::PVTGeodetic::ConstPtr& msg)
+        {
+            latencies_.push_back((ros::Time::now() - msg->header.stamp).toSec());
+            ++received_;
+            uint32_t tow = msg->block_header.tow;
+            if (has_tow_ && (tow > last_tow_))
+            {
+                uint32_t step = tow - last_tow_;
+                if ((step_ == 0) || (step < step_))
+                    step_ = step;
+                steps_.push_back(step);
+            }
+            has_tow_ = true;
+            last_tow_ = tow;
+        }
+
+        void report(const ros::TimerEvent&)
+        {
+            for (uint32_t step : steps_)
+                dropped_ += step / step_ - 1;
+            steps_.clear();
+            std::stringstream ss;
+            ss << received_ << " received, " << dropped_ << " dropped";
+            if (received_ + dropped_ > 0)
+                ss << " (" << 100.0 * dropped_ / (received_ + dropped_) << " %)";
+            if (!latencies_.empty())
+            {
+                std::sort(latencies_.begin(), latencies_.end());
+                double sum = 0.0;
+                for (double latency : latencies_)
+                    sum += latency;
+                ss << ", latency [ms] mean "
+                   << 1000.0 * sum / latencies_.size() << ", median "
+                   << 1000.0 * latencies_[latencies_.size() / 2] << ", p99 "
+                   << 1000.0 * latencies_[latencies_.size() * 99 / 100] << ", max "
+                   << 1000.0 * latencies_.back();
+                latencies_.clear();
+            }
+            ROS_INFO_STREAM(ss.str());
+        }
+
+        ros::Subscriber sub_;
+        ros::Timer timer_;
+        //! Latencies since the last report [s]
+        std::vector<double> latencies_;
+        //! TOW steps since the last report [ms]
+        std::vector<uint32_t> steps_;
+        //! Smallest TOW step, taken as output interval [ms]
+        uint32_t step_ = 0;
+        bool has_tow_ = false;
+        uint32_t last_tow_ = 0;
+        uint64_t received_ = 0;
+        uint64_t dropped_ = 0;
+    };
+} // namespace
+
+int main(int argc, char** argv)
+{
+    ros::init(argc, argv, "rx_benchmark");
+    ros::NodeHandle nh;
+    ros::NodeHandle pnh("~");
+    Benchmark benchmark(nh, pnh);
+    ros::spin();
+    return 0;
+}
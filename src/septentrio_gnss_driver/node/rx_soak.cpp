@@ -0,0 +1,516 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C library includes
+#include <unistd.h>
+// C++ library includes
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+// ROS includes
+#include <ros/callback_queue.h>
+#include <ros/network.h>
+#include <ros/ros.h>
+#include <rosgraph_msgs/Log.h>
+#include <sensor_msgs/Imu.h>
+#include <xmlrpcpp/XmlRpcClient.h>
+// ROSaic includes
+#include <septentrio_gnss_driver/ExtSensorMeas.h>
+#include <septentrio_gnss_driver/INSNavGeod.h>
+#include <septentrio_gnss_driver/ImuBatch.h>
+#include <septentrio_gnss_driver/MeasEpoch.h>
+#include <septentrio_gnss_driver/StreamStatus.h>
+
+/**
+ * @file rx_soak.cpp
+ * @date 16/10/26
+ * @brief Node checking loss, latency, memory growth and errors of the driver over
+ * long runs against the mock Rx in stress mode
+ */
+
+namespace {
+
+    //! Latency histogram with 0.1 ms bins up to 1 s and one bin beyond
+    class Histogram
+    {
+    public:
+        void add(double latency)
+        {
+            std::size_t bin = static_cast<std::size_t>(
+                std::max(0.0, latency) * 1e4);
+            ++bins_[std::min(bin, bins_.size() - 1)];
+            ++count_;
+            max_ = std::max(max_, latency);
+        }
+
+        //! Latency below which the fraction p of the samples lies [s]
+        double percentile(double p) const
+        {
+            uint64_t rank = static_cast<uint64_t>(p * count_);
+            uint64_t sum = 0;
+            for (std::size_t bin = 0; bin < bins_.size(); ++bin)
+            {
+                sum += bins_[bin];
+                if (sum > rank)
+                    return (bin + 1) * 1e-4;
+            }
+            return max_;
+        }
+
+        double max() const { return max_; }
+        uint64_t count() const { return count_; }
+
+        void clear()
+        {
+            bins_.fill(0);
+            count_ = 0;
+            max_ = 0.0;
+        }
+
+    private:
+        std::array<uint64_t, 10001> bins_ = {};
+        uint64_t count_ = 0;
+        double max_ = 0.0;
+    };
+
+    //! Reception statistics of one topic
+    struct TopicStats
+    {
+        std::string topic;
+        //! Modulus of the sequence number of the mock Rx
+        uint64_t modulus;
+        bool has_sequence = false;
+        uint64_t last_sequence = 0;
+        uint64_t received = 0;
+        uint64_t lost = 0;
+        //! Latencies since the last report
+        Histogram period;
+        //! Latencies since the end of the warm-up
+        Histogram run;
+    };
+
+    /**
+     * @class Soak
+     * @brief Subscribes to INSNavGeod, ExtSensorMeas and MeasEpoch of the driver
+     * fed by the mock Rx in stress mode and checks the run against limits
+     *
+     * Lost messages are found from the sequence numbers the mock Rx puts into
+     * every block, latencies from the GPS time stamps (with use_gnss_time). The
+     * memory of the driver is its resident set size, read via its PID, as are its
+     * number of threads and the CPU time it used since the last report. Errors are
+     * the messages the driver logs at level ERROR or above, e.g. about overwriting
+     * the circular buffer, and the CRC errors of /streamstatus. Everything before
+     * the end of the warm-up is ignored. Optionally, a slow consumer subscribes
+     * to one of the topics on its own thread and stalls in its callback, and /imu
+     * or /imubatch are subscribed to, so that the driver publishes them and their
+     * cost shows in its CPU load.
+     */
+    class Soak
+    {
+    public:
+        /**
+         * @brief Constructor of the class Soak
+         * @param[in] nh Node handle subscribing to the driver
+         * @param[in] pnh Private node handle holding the parameters
+         */
+        Soak(ros::NodeHandle& nh, ros::NodeHandle& pnh) :
+            slow_spinner_(1, &slow_queue_),
+            stats_{{{"/insnavgeod", 65536},
+                    {"/extsensormeas", 1ull << 53},
+                    {"/measepoch", 1ull << 32}}}
+        {
+            double report_period;
+            pnh.param("report_period", report_period, 10.0);
+            pnh.param("duration", duration_, 3600.0);
+            pnh.param("warmup", warmup_, 30.0);
+            pnh.param("driver_node", driver_node_, std::string("/septentrio_gnss"));
+            std::string topic_namespace;
+            pnh.param("topic_namespace", topic_namespace, std::string(""));
+            pnh.param("max_loss", max_loss_, 0.0);
+            pnh.param("max_latency_p99", max_latency_p99_, 50.0);
+            pnh.param("max_memory_growth", max_memory_growth_, 20.0);
+            pnh.param("max_errors", max_errors_, 0);
+            pnh.param("result_file", result_file_, std::string(""));
+            double slow_delay;
+            std::string slow_topic;
+            pnh.param("slow_consumer/delay", slow_delay, 0.0);
+            pnh.param("slow_consumer/topic", slow_topic, std::string("/measepoch"));
+            bool imu, imubatch;
+            pnh.param("subscribe/imu", imu, false);
+            pnh.param("subscribe/imubatch", imubatch, false);
+
+            // With several Rxs per driver node, one of them is checked
+            for (auto& stats : stats_)
+                stats.topic = topic_namespace + stats.topic;
+            slow_topic = topic_namespace + slow_topic;
+
+            ros::TransportHints hints = ros::TransportHints().tcpNoDelay();
+            subs_.push_back(nh.subscribe(stats_[0].topic, 10000,
+                                         &Soak::insNavGeod, this, hints));
+            subs_.push_back(nh.subscribe(stats_[1].topic, 10000,
+                                         &Soak::extSensorMeas, this, hints));
+            subs_.push_back(nh.subscribe(stats_[2].topic, 1000, &Soak::measEpoch,
+                                         this, hints));
+            subs_.push_back(nh.subscribe(topic_namespace + "/streamstatus", 10,
+                                         &Soak::streamStatus, this));
+            subs_.push_back(nh.subscribe("/rosout_agg", 1000, &Soak::log, this));
+            // The driver only publishes topics that are subscribed to
+            if (imu)
+                subs_.push_back(nh.subscribe(topic_namespace + "/imu", 10000,
+                                             &Soak::imu, this, hints));
+            if (imubatch)
+                subs_.push_back(nh.subscribe(topic_namespace + "/imubatch", 1000,
+                                             &Soak::imuBatch, this, hints));
+            if (slow_delay > 0.0)
+                subscribeSlow(nh, slow_topic, slow_delay);
+
+            start_ = ros::WallTime::now();
+            report_timer_ = nh.createWallTimer(ros::WallDuration(report_period),
+                                               &Soak::report, this);
+        }
+
+        //! Whether the run exceeded a limit
+        bool failed() const { return failed_; }
+
+    private:
+        //! Subscribes a consumer with a queue of 1 that stalls for delay [ms]
+        void subscribeSlow(ros::NodeHandle& nh, const std::string& topic,
+                           double delay)
+        {
+            ros::NodeHandle slow_nh(nh);
+            slow_nh.setCallbackQueue(&slow_queue_);
+            if (topic == stats_[0].topic)
+                slow_sub_ =
+                    stall<septentrio_gnss_driver::INSNavGeod>(slow_nh, topic, delay);
+            else if (topic == stats_[1].topic)
+                slow_sub_ = stall<septentrio_gnss_driver::ExtSensorMeas>(
+                    slow_nh, topic, delay);
+            else
+                slow_sub_ =
+                    stall<septentrio_gnss_driver::MeasEpoch>(slow_nh, topic, delay);
+            slow_spinner_.start();
+            ROS_INFO_STREAM("Slow consumer stalls " << delay << " ms per message of "
+                                                   << topic);
+        }
+
+        //! Subscribes to topic with a callback sleeping for delay [ms]
+        template <typename M>
+        ros::Subscriber stall(ros::NodeHandle& nh, const std::string& topic,
+                              double delay)
+        {
+            ros::WallDuration duration(delay / 1000.0);
+            return nh.subscribe<M>(
+                topic, 1,
+                [duration](const typename M::ConstPtr&) { duration.sleep(); });
+        }
+
+        void insNavGeod(const septentrio_gnss_driver::INSNavGeod::ConstPtr& msg)
+        {
+            receive(stats_[0], msg->header.stamp, msg->gnss_age);
+        }
+
+        void
+        extSensorMeas(const septentrio_gnss_driver::ExtSensorMeas::ConstPtr& msg)
+        {
+            receive(stats_[1], msg->header.stamp,
+                    static_cast<uint64_t>(msg->acceleration_x));
+        }
+
+        void measEpoch(const septentrio_gnss_driver::MeasEpoch::ConstPtr& msg)
+        {
+            if (!msg->type1.empty())
+                receive(stats_[2], msg->header.stamp, msg->type1[0].code_lsb);
+        }
+
+        void imu(const sensor_msgs::Imu::ConstPtr&)
+        {
+            ++imu_messages_;
+            ++imu_samples_;
+        }
+
+        void imuBatch(const septentrio_gnss_driver::ImuBatch::ConstPtr& msg)
+        {
+            ++imu_messages_;
+            imu_samples_ += msg->samples.size();
+        }
+
+        void streamStatus(const septentrio_gnss_driver::StreamStatus::ConstPtr& msg)
+        {
+            crc_errors_ = msg->crc_errors;
+        }
+
+        void log(const rosgraph_msgs::Log::ConstPtr& msg)
+        {
+            if ((msg->name == driver_node_) &&
+                (msg->level >= rosgraph_msgs::Log::ERROR))
+            {
+                if (warmedUp())
+                    ++errors_;
+                ROS_WARN_STREAM_THROTTLE(10.0, "Driver: " << msg->msg);
+            }
+        }
+
+        void receive(TopicStats& stats, const ros::Time& stamp, uint64_t sequence)
+        {
+            if (stats.has_sequence && warmedUp())
+            {
+                uint64_t step =
+                    (sequence + stats.modulus - stats.last_sequence) % stats.modulus;
+                // A step back, e.g. when the mock Rx restarts, is no loss
+                if ((step > 1) && (step < stats.modulus / 2))
+                    stats.lost += step - 1;
+                ++stats.received;
+                double latency = (ros::Time::now() - stamp).toSec();
+                stats.period.add(latency);
+                stats.run.add(latency);
+            }
+            stats.has_sequence = true;
+            stats.last_sequence = sequence;
+        }
+
+        bool warmedUp() const
+        {
+            return (ros::WallTime::now() - start_).toSec() >= warmup_;
+        }
+
+        //! PID of the driver, 0 if unknown
+        int driverPid()
+        {
+            XmlRpc::XmlRpcValue args, result, payload;
+            args[0] = ros::this_node::getName();
+            args[1] = driver_node_;
+            if (!ros::master::execute("lookupNode", args, result, payload, false))
+                return 0;
+            std::string host, uri(payload);
+            uint32_t port;
+            if (!ros::network::splitURI(uri, host, port))
+                return 0;
+            XmlRpc::XmlRpcClient client(host.c_str(), port, "/");
+            XmlRpc::XmlRpcValue pid_args, pid_result;
+            pid_args[0] = ros::this_node::getName();
+            if (!client.execute("getPid", pid_args, pid_result) ||
+                (pid_result.size() < 3) ||
+                (pid_result[2].getType() != XmlRpc::XmlRpcValue::TypeInt))
+                return 0;
+            return static_cast<int>(pid_result[2]);
+        }
+
+        //! Resident set size of the driver [MB], negative if unknown
+        double driverMemory()
+        {
+            if (driver_pid_ == 0)
+                driver_pid_ = driverPid();
+            std::ifstream status("/proc/" + std::to_string(driver_pid_) + "/status");
+            std::string line;
+            double memory = -1.0;
+            driver_threads_ = -1;
+            while (std::getline(status, line))
+            {
+                if (line.compare(0, 6, "VmRSS:") == 0)
+                    memory = std::atof(line.c_str() + 6) / 1024.0;
+                else if (line.compare(0, 8, "Threads:") == 0)
+                    driver_threads_ = std::atoi(line.c_str() + 8);
+            }
+            if (memory < 0.0)
+                driver_pid_ = 0;
+            return memory;
+        }
+
+        //! CPU load of the driver since the last call [% of one core], negative
+        //! if unknown
+        double driverCpu()
+        {
+            std::ifstream stat("/proc/" + std::to_string(driver_pid_) + "/stat");
+            std::string line;
+            std::getline(stat, line);
+            // The name in parentheses may contain spaces, utime and stime are the
+            // 12th and 13th fields after it
+            std::size_t pos = line.rfind(')');
+            if (pos == std::string::npos)
+                return -1.0;
+            std::istringstream fields(line.substr(pos + 1));
+            std::string field;
+            for (int i = 0; i < 11; ++i)
+                fields >> field;
+            uint64_t utime = 0, stime = 0;
+            if (!(fields >> utime >> stime))
+                return -1.0;
+            double cpu_time =
+                static_cast<double>(utime + stime) / sysconf(_SC_CLK_TCK);
+            ros::WallTime now = ros::WallTime::now();
+            double load = -1.0;
+            if ((cpu_time_ >= 0.0) && (cpu_time >= cpu_time_))
+                load = 100.0 * (cpu_time - cpu_time_) / (now - cpu_stamp_).toSec();
+            cpu_time_ = cpu_time;
+            cpu_stamp_ = now;
+            return load;
+        }
+
+        void report(const ros::WallTimerEvent&)
+        {
+            double elapsed = (ros::WallTime::now() - start_).toSec();
+            double memory = driverMemory();
+            double cpu = driverCpu();
+            if (warmedUp() && (memory_at_warmup_ < 0.0))
+            {
+                memory_at_warmup_ = memory;
+                crc_errors_at_warmup_ = crc_errors_;
+                cpu_time_at_warmup_ = cpu_time_;
+                cpu_stamp_at_warmup_ = cpu_stamp_;
+            }
+            std::stringstream ss;
+            ss << "Soak " << static_cast<int>(elapsed) << " s:";
+            for (auto& stats : stats_)
+            {
+                ss << " " << stats.topic << " " << stats.received << " received, "
+                   << stats.lost << " lost";
+                if (stats.period.count() > 0)
+                    ss << ", latency [ms] p50 "
+                       << 1000.0 * stats.period.percentile(0.5) << " p99 "
+                       << 1000.0 * stats.period.percentile(0.99) << " max "
+                       << 1000.0 * stats.period.max();
+                ss << ";";
+                stats.period.clear();
+            }
+            if (imu_messages_ > 0)
+                ss << " IMU " << imu_samples_ << " samples in " << imu_messages_
+                   << " messages;";
+            ss << " driver RSS " << memory << " MB, " << driver_threads_
+               << " threads, CPU " << cpu << " %, " << errors_ << " errors, "
+               << crc_errors_ - crc_errors_at_warmup_ << " CRC errors";
+            ROS_INFO_STREAM(ss.str());
+
+            if ((duration_ > 0.0) && (elapsed >= duration_))
+                finish(memory);
+        }
+
+        //! Checks the run against the limits and shuts down
+        void finish(double memory)
+        {
+            std::stringstream failures;
+            for (const auto& stats : stats_)
+            {
+                uint64_t expected = stats.received + stats.lost;
+                double loss =
+                    expected > 0 ? 100.0 * stats.lost / expected : 100.0;
+                if (loss > max_loss_)
+                    failures << " " << stats.topic << " loss " << loss << " %;";
+                double p99 = 1000.0 * stats.run.percentile(0.99);
+                if (p99 > max_latency_p99_)
+                    failures << " " << stats.topic << " latency p99 " << p99
+                             << " ms;";
+            }
+            double growth = memory - memory_at_warmup_;
+            if ((memory < 0.0) || (memory_at_warmup_ < 0.0))
+                failures << " driver memory unknown;";
+            else if (growth > max_memory_growth_)
+                failures << " driver memory growth " << growth << " MB;";
+            uint32_t crc_errors = crc_errors_ - crc_errors_at_warmup_;
+            if (errors_ + crc_errors > static_cast<uint64_t>(max_errors_))
+                failures << " " << errors_ << " errors, " << crc_errors
+                         << " CRC errors;";
+
+            if ((cpu_time_at_warmup_ >= 0.0) && (cpu_time_ > cpu_time_at_warmup_))
+                ROS_INFO_STREAM("Driver CPU load after the warm-up "
+                                << 100.0 * (cpu_time_ - cpu_time_at_warmup_) /
+                                       (cpu_stamp_ - cpu_stamp_at_warmup_).toSec()
+                                << " %");
+
+            failed_ = !failures.str().empty();
+            if (failed_)
+                ROS_ERROR_STREAM("Soak FAILED:" << failures.str());
+            else
+                ROS_INFO_STREAM("Soak PASSED");
+
+            if (!result_file_.empty())
+            {
+                // One line per topic, to be appended to by nightly runs
+                std::ofstream file(result_file_, std::ios::app);
+                for (const auto& stats : stats_)
+                {
+                    file << static_cast<int64_t>(ros::WallTime::now().toSec()) << ","
+                         << duration_ << "," << stats.topic << "," << stats.received
+                         << "," << stats.lost << ","
+                         << 1000.0 * stats.run.percentile(0.5) << ","
+                         << 1000.0 * stats.run.percentile(0.99) << ","
+                         << 1000.0 * stats.run.max() << "," << growth << ","
+                         << errors_ << "," << crc_errors << ","
+                         << (failed_ ? "FAILED" : "PASSED") << "\n";
+                }
+            }
+            ros::shutdown();
+        }
+
+        std::vector<ros::Subscriber> subs_;
+        ros::WallTimer report_timer_;
+        ros::CallbackQueue slow_queue_;
+        ros::AsyncSpinner slow_spinner_;
+        ros::Subscriber slow_sub_;
+        std::array<TopicStats, 3> stats_;
+        ros::WallTime start_;
+        //! Parameters, see README
+        double duration_;
+        double warmup_;
+        std::string driver_node_;
+        double max_loss_;
+        double max_latency_p99_;
+        double max_memory_growth_;
+        int max_errors_;
+        std::string result_file_;
+        int driver_pid_ = 0;
+        int driver_threads_ = -1;
+        //! CPU time of the driver at the last report [s]
+        double cpu_time_ = -1.0;
+        ros::WallTime cpu_stamp_;
+        double cpu_time_at_warmup_ = -1.0;
+        ros::WallTime cpu_stamp_at_warmup_;
+        uint64_t imu_messages_ = 0;
+        uint64_t imu_samples_ = 0;
+        double memory_at_warmup_ = -1.0;
+        uint64_t errors_ = 0;
+        uint32_t crc_errors_ = 0;
+        uint32_t crc_errors_at_warmup_ = 0;
+        bool failed_ = false;
+    };
+} // namespace
+
+int main(int argc, char** argv)
+{
+    ros::init(argc, argv, "rx_soak");
+    ros::NodeHandle nh;
+    ros::NodeHandle pnh("~");
+    Soak soak(nh, pnh);
+    ros::spin();
+    return soak.failed() ? 1 : 0;
+}
@@ -0,0 +1,310 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C library includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+// C++ library includes
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+// ROS includes
+#include <rosbag/view.h>
+// ROSaic includes
+#include <septentrio_gnss_driver/communication/communication_core.hpp>
+#include <septentrio_gnss_driver/communication/sbf_index.hpp>
+
+/**
+ * @file sbf_to_bag.cpp
+ * @date 16/10/26
+ * @brief Offline converter of SBF logs to rosbags, which needs no ROS master
+ */
+
+namespace {
+
+    /**
+     * @class BagNode
+     * @brief Node writing the messages decoded from one part of an SBF log to a bag
+     */
+    class BagNode : public ROSaicNodeBase
+    {
+    public:
+        /**
+         * @brief Constructor of the class BagNode
+         * @param[in] settings Settings of the conversion
+         */
+        explicit BagNode(const Settings& settings) : IO_(this, &settings_)
+        {
+            settings_ = settings;
+            IO_.defineMessages();
+        }
+
+        /**
+         * @brief Decodes SBF/NMEA data and writes the messages to a bag
+         * @param[in] bag_name Path of the bag to be written
+         * @param[in] data Pointer to the data
+         * @param[in] size Size of the data
+         */
+        void convert(const std::string& bag_name, const uint8_t* data,
+                     std::size_t size)
+        {
+            bag_.open(bag_name, rosbag::bagmode::Write);
+            setBag(&bag_);
+            IO_.parseBuffer(data, size);
+            setBag(nullptr);
+            bag_.close();
+        }
+
+    private:
+        //! VSM input is not available offline
+        void sendVelocity(const char* velNmea, std::size_t size) {}
+
+        void sendCorrections(const RtcmMsg::ConstPtr& rtcm) {}
+
+        //! Bag written to
+        rosbag::Bag bag_;
+        //! Parses the data
+        io_comm_rx::Comm_IO IO_;
+    };
+
+    //! Returns the settings publishing everything found in the log
+    Settings conversionSettings(std::string receiver_type, int32_t leap_seconds)
+    {
+        Settings settings{};
+        settings.read_from_sbf_log = true;
+        settings.replay_in_realtime = false;
+        settings.use_gnss_time = true;
+        settings.leap_seconds = leap_seconds;
+        if (receiver_type == "ins_in_gnss_mode")
+        {
+            receiver_type = "gnss";
+            settings.ins_in_gnss_mode = true;
+        }
+        settings.septentrio_receiver_type = receiver_type;
+        settings.frame_id = "gnss";
+        settings.imu_frame_id = "imu";
+        settings.poi_frame_id = "base_link";
+        settings.vsm_frame_id = "vsm";
+        settings.aux1_frame_id = "aux1";
+        settings.vehicle_frame_id = "base_link";
+        settings.local_frame_id = "odom";
+        settings.lock_utm_zone = true;
+        settings.use_ros_axis_orientation = true;
+        settings.polling_period_pvt = 0;
+        settings.polling_period_rest = 0;
+
+        settings.publish_gpst = true;
+        settings.publish_navsatfix = true;
+        settings.publish_gpsfix = true;
+        settings.publish_pose = true;
+        settings.publish_diagnostics = true;
+        settings.publish_streamstatus = true;
+        settings.publish_gpgga = true;
+        settings.publish_gprmc = true;
+        settings.publish_gpgsa = true;
+        settings.publish_gpgsv = true;
+        settings.publish_satellites = true;
+        settings.publish_measepoch = true;
+        settings.publish_rawobservables = true;
+        settings.publish_pvtcartesian = true;
+        settings.publish_pvtgeodetic = true;
+        settings.publish_basevectorcart = true;
+        settings.publish_basevectorgeod = true;
+        settings.publish_poscovcartesian = true;
+        settings.publish_poscovgeodetic = true;
+        settings.publish_velcovgeodetic = true;
+        settings.publish_atteuler = true;
+        settings.publish_attcoveuler = true;
+        settings.publish_insnavcart = true;
+        settings.publish_insnavgeod = true;
+        settings.publish_imusetup = true;
+        settings.publish_velsensorsetup = true;
+        settings.publish_exteventinsnavgeod = true;
+        settings.publish_exteventinsnavcart = true;
+        settings.publish_extsensormeas = true;
+        settings.publish_imu = true;
+        settings.publish_imubatch = true;
+        settings.publish_localization = true;
+        settings.publish_twist = true;
+        settings.publish_tf = true;
+        return settings;
+    }
+
+    /**
+     * @brief Splits the log into parts starting at epoch boundaries, so that the
+     * blocks of one epoch are decoded by the same thread
+     * @param[in] entries Index of the log
+     * @param[in] size Size of the log
+     * @param[in] parts Number of parts wanted
+     * @return Start offsets of the parts followed by the size of the log
+     */
+    std::vector<uint64_t>
+    splitAtEpochs(const std::vector<io_comm_rx::SbfIndex::Entry>& entries,
+                  uint64_t size, std::size_t parts)
+    {
+        std::vector<uint64_t> bounds(1, 0);
+        auto it = entries.begin();
+        for (std::size_t i = 1; i < parts; ++i)
+        {
+            uint64_t target = size * i / parts;
+            it = std::find_if(it, entries.end(),
+                              [target](const io_comm_rx::SbfIndex::Entry& entry) {
+                                  return entry.offset >= target;
+                              });
+            if ((it == entries.end()) || (it == entries.begin()))
+                continue;
+            auto prev = it - 1;
+            it = std::find_if(it, entries.end(),
+                              [prev](const io_comm_rx::SbfIndex::Entry& entry) {
+                                  return (entry.tow != prev->tow) ||
+                                         (entry.wnc != prev->wnc);
+                              });
+            if ((it != entries.end()) && (it->offset > bounds.back()))
+                bounds.push_back(it->offset);
+        }
+        bounds.push_back(size);
+        return bounds;
+    }
+
+    void usage()
+    {
+        std::cerr
+            << "Usage: sbf_to_bag <input.sbf> <output.bag> [-j threads] "
+               "[-r gnss|ins|ins_in_gnss_mode] [-l leap_seconds]"
+            << std::endl;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    // Only the clock and logging of ROS are used, no master is contacted
+    ros::init(argc, argv, "sbf_to_bag",
+              ros::init_options::NoSigintHandler | ros::init_options::NoRosout);
+
+    if (argc < 3)
+    {
+        usage();
+        return 1;
+    }
+    std::string input(argv[1]);
+    std::string output(argv[2]);
+    std::size_t threads = std::max(1u, boost::thread::hardware_concurrency());
+    std::string receiver_type("gnss");
+    int32_t leap_seconds = 18;
+    for (int i = 3; i + 1 < argc; i += 2)
+    {
+        std::string option(argv[i]);
+        if (option == "-j")
+            threads = std::max(1, std::atoi(argv[i + 1]));
+        else if (option == "-r")
+            receiver_type = argv[i + 1];
+        else if (option == "-l")
+            leap_seconds = std::atoi(argv[i + 1]);
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+    Settings settings = conversionSettings(receiver_type, leap_seconds);
+
+    auto start = std::chrono::steady_clock::now();
+    // The index gives the block boundaries, which the parts are split at
+    BagNode main_node(settings);
+    io_comm_rx::SbfIndex index(&main_node);
+    if (!index.load(input))
+        return 1;
+
+    int fd = ::open(input.c_str(), O_RDONLY);
+    struct stat file_stat;
+    if ((fd < 0) || (::fstat(fd, &file_stat) != 0) || (file_stat.st_size == 0))
+    {
+        std::cerr << "Could not open " << input << std::endl;
+        return 1;
+    }
+    uint64_t size = static_cast<uint64_t>(file_stat.st_size);
+    const uint8_t* data = static_cast<const uint8_t*>(
+        ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0));
+    ::close(fd);
+    if (data == MAP_FAILED)
+    {
+        std::cerr << "Could not map " << input << std::endl;
+        return 1;
+    }
+
+    // Each part is decoded into a bag of its own by one thread
+    std::vector<uint64_t> bounds = splitAtEpochs(index.entries(), size, threads);
+    std::size_t parts = bounds.size() - 1;
+    std::vector<std::string> part_names;
+    for (std::size_t i = 0; i < parts; ++i)
+        part_names.push_back(output + ".part" + std::to_string(i));
+    boost::thread_group converters;
+    for (std::size_t i = 0; i < parts; ++i)
+    {
+        converters.create_thread([&, i]() {
+            BagNode node(settings);
+            node.convert(part_names[i], data + bounds[i],
+                         bounds[i + 1] - bounds[i]);
+        });
+    }
+    converters.join_all();
+    ::munmap(const_cast<uint8_t*>(data), size);
+    auto decoded = std::chrono::steady_clock::now();
+
+    // rosbag::View iterates the parts in time order
+    {
+        std::vector<std::unique_ptr<rosbag::Bag>> part_bags;
+        rosbag::View view;
+        for (const auto& part_name : part_names)
+        {
+            part_bags.emplace_back(
+                new rosbag::Bag(part_name, rosbag::bagmode::Read));
+            view.addQuery(*part_bags.back());
+        }
+        rosbag::Bag bag(output, rosbag::bagmode::Write);
+        for (const rosbag::MessageInstance& msg : view)
+            bag.write(msg.getTopic(), msg.getTime(), msg, msg.getConnectionHeader());
+    }
+    for (const auto& part_name : part_names)
+        std::remove(part_name.c_str());
+    auto merged = std::chrono::steady_clock::now();
+
+    double mb = static_cast<double>(size) / 1e6;
+    double decode_s = std::chrono::duration<double>(decoded - start).count();
+    double total_s = std::chrono::duration<double>(merged - start).count();
+    std::cout << "Converted " << mb << " MB with " << parts << " threads: decoding "
+              << mb / decode_s << " MB/s, including merge " << mb / total_s
+              << " MB/s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,384 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// C library includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+// C++ library includes
+#include <chrono>
+#include <iostream>
+// ROSaic includes
+#include <septentrio_gnss_driver/communication/column_file.hpp>
+#include <septentrio_gnss_driver/communication/rx_message.hpp>
+#include <septentrio_gnss_driver/communication/sbf_index.hpp>
+
+/**
+ * @file sbf_to_columns.cpp
+ * @date 16/10/26
+ * @brief Offline exporter of SBF logs to column files for analytics, which needs
+ * no ROS master
+ */
+
+namespace {
+
+    /**
+     * @class LogNode
+     * @brief Node only logging the errors of the parsers
+     */
+    class LogNode : public ROSaicNodeBase
+    {
+    private:
+        void sendVelocity(const char* velNmea, std::size_t size) {}
+
+        void sendCorrections(const RtcmMsg::ConstPtr& rtcm) {}
+    };
+
+    /**
+     * @class ColumnExporter
+     * @brief Writes the fields of PVTGeodetic, MeasEpoch and ChannelStatus blocks
+     * to one column file each
+     *
+     * The signals of a MeasEpoch block and the satellites of a ChannelStatus block
+     * go to child tables referenced by offset columns.
+     */
+    class ColumnExporter
+    {
+    public:
+        /**
+         * @brief Constructor of the class ColumnExporter
+         * @param[in] dir Directory the tables are written to
+         */
+        explicit ColumnExporter(const std::string& dir) :
+            pvt_tow_(dir, "pvt", "tow", "ms"), pvt_wnc_(dir, "pvt", "wnc", "week"),
+            pvt_mode_(dir, "pvt", "mode"), pvt_error_(dir, "pvt", "error"),
+            pvt_latitude_(dir, "pvt", "latitude", "rad"),
+            pvt_longitude_(dir, "pvt", "longitude", "rad"),
+            pvt_height_(dir, "pvt", "height", "m"), pvt_nr_sv_(dir, "pvt", "nr_sv"),
+            pvt_h_accuracy_(dir, "pvt", "h_accuracy", "cm"),
+            pvt_v_accuracy_(dir, "pvt", "v_accuracy", "cm"),
+            meas_tow_(dir, "measepoch", "tow", "ms"),
+            meas_wnc_(dir, "measepoch", "wnc", "week"),
+            meas_common_flags_(dir, "measepoch", "common_flags"),
+            meas_signal_offset_(dir, "measepoch", "signal_offset", "",
+                                "measepoch_signals"),
+            signal_sv_id_(dir, "measepoch_signals", "sv_id"),
+            signal_type_(dir, "measepoch_signals", "signal_type"),
+            signal_antenna_(dir, "measepoch_signals", "antenna"),
+            signal_pseudorange_(dir, "measepoch_signals", "pseudorange", "m"),
+            signal_carrier_phase_(dir, "measepoch_signals", "carrier_phase",
+                                  "cycles"),
+            signal_doppler_(dir, "measepoch_signals", "doppler", "Hz"),
+            signal_cn0_(dir, "measepoch_signals", "cn0", "dB-Hz"),
+            signal_lock_time_(dir, "measepoch_signals", "lock_time", "s"),
+            signal_obs_info_(dir, "measepoch_signals", "obs_info"),
+            chan_tow_(dir, "channelstatus", "tow", "ms"),
+            chan_wnc_(dir, "channelstatus", "wnc", "week"),
+            chan_satellite_offset_(dir, "channelstatus", "satellite_offset", "",
+                                   "channelstatus_satellites"),
+            sat_sv_id_(dir, "channelstatus_satellites", "sv_id"),
+            sat_freq_nr_(dir, "channelstatus_satellites", "freq_nr"),
+            sat_azimuth_(dir, "channelstatus_satellites", "azimuth", "deg"),
+            sat_rise_set_(dir, "channelstatus_satellites", "rise_set"),
+            sat_elevation_(dir, "channelstatus_satellites", "elevation", "deg"),
+            sat_health_status_(dir, "channelstatus_satellites", "health_status"),
+            sat_rx_channel_(dir, "channelstatus_satellites", "rx_channel"),
+            files_{&pvt_tow_,
+                   &pvt_wnc_,
+                   &pvt_mode_,
+                   &pvt_error_,
+                   &pvt_latitude_,
+                   &pvt_longitude_,
+                   &pvt_height_,
+                   &pvt_nr_sv_,
+                   &pvt_h_accuracy_,
+                   &pvt_v_accuracy_,
+                   &meas_tow_,
+                   &meas_wnc_,
+                   &meas_common_flags_,
+                   &meas_signal_offset_,
+                   &signal_sv_id_,
+                   &signal_type_,
+                   &signal_antenna_,
+                   &signal_pseudorange_,
+                   &signal_carrier_phase_,
+                   &signal_doppler_,
+                   &signal_cn0_,
+                   &signal_lock_time_,
+                   &signal_obs_info_,
+                   &chan_tow_,
+                   &chan_wnc_,
+                   &chan_satellite_offset_,
+                   &sat_sv_id_,
+                   &sat_freq_nr_,
+                   &sat_azimuth_,
+                   &sat_rise_set_,
+                   &sat_elevation_,
+                   &sat_health_status_,
+                   &sat_rx_channel_}
+        {
+            // Offset columns hold one entry more than their table has rows
+            meas_signal_offset_.append(0);
+            chan_satellite_offset_.append(0);
+        }
+
+        //! Returns false if any file could not be created
+        bool good() const
+        {
+            for (const auto file : files_)
+            {
+                if (!file->good())
+                {
+                    std::cerr << "Could not write " << file->path() << std::endl;
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        //! Appends a PVTGeodetic block
+        void add(const PVTGeodeticMsg& msg)
+        {
+            pvt_tow_.append(msg.block_header.tow);
+            pvt_wnc_.append(msg.block_header.wnc);
+            pvt_mode_.append(msg.mode);
+            pvt_error_.append(msg.error);
+            pvt_latitude_.append(msg.latitude);
+            pvt_longitude_.append(msg.longitude);
+            pvt_height_.append(msg.height);
+            pvt_nr_sv_.append(msg.nr_sv);
+            pvt_h_accuracy_.append(msg.h_accuracy);
+            pvt_v_accuracy_.append(msg.v_accuracy);
+        }
+
+        //! Appends the observables decoded from a MeasEpoch block
+        void add(const RawObservablesMsg& msg)
+        {
+            meas_tow_.append(msg.block_header.tow);
+            meas_wnc_.append(msg.block_header.wnc);
+            meas_common_flags_.append(msg.common_flags);
+            for (std::size_t i = 0; i < msg.sv_id.size(); ++i)
+            {
+                signal_sv_id_.append(msg.sv_id[i]);
+                signal_type_.append(msg.signal_type[i]);
+                signal_antenna_.append(msg.antenna[i]);
+                signal_pseudorange_.append(msg.pseudorange[i]);
+                signal_carrier_phase_.append(msg.carrier_phase[i]);
+                signal_doppler_.append(msg.doppler[i]);
+                signal_cn0_.append(msg.cn0[i]);
+                signal_lock_time_.append(msg.lock_time[i]);
+                signal_obs_info_.append(msg.obs_info[i]);
+            }
+            meas_signal_offset_.append(signal_sv_id_.count());
+        }
+
+        //! Appends a ChannelStatus block
+        void add(const ChannelStatus& msg)
+        {
+            chan_tow_.append(msg.block_header.tow);
+            chan_wnc_.append(msg.block_header.wnc);
+            for (const auto& sat : msg.satInfo)
+            {
+                sat_sv_id_.append(sat.sv_id);
+                sat_freq_nr_.append(sat.freq_nr);
+                sat_azimuth_.append(sat.az_rise_set & 0x01FF);
+                sat_rise_set_.append(sat.az_rise_set >> 14);
+                sat_elevation_.append(sat.elev);
+                sat_health_status_.append(sat.health_status);
+                sat_rx_channel_.append(sat.rx_channel);
+            }
+            chan_satellite_offset_.append(sat_sv_id_.count());
+        }
+
+        /**
+         * @brief Closes all files, writing their headers
+         * @return False if any file could not be written
+         */
+        bool close()
+        {
+            bool good = true;
+            for (auto file : files_)
+            {
+                if (!file->close())
+                {
+                    std::cerr << "Could not write " << file->path() << std::endl;
+                    good = false;
+                }
+            }
+            return good;
+        }
+
+        //! Prints the number of rows of the tables
+        void printRows() const
+        {
+            std::cout << "pvt: " << pvt_tow_.count()
+                      << " rows, measepoch: " << meas_tow_.count()
+                      << " rows, measepoch_signals: " << signal_sv_id_.count()
+                      << " rows, channelstatus: " << chan_tow_.count()
+                      << " rows, channelstatus_satellites: " << sat_sv_id_.count()
+                      << " rows" << std::endl;
+        }
+
+    private:
+        io_comm_rx::ColumnWriter<uint32_t> pvt_tow_;
+        io_comm_rx::ColumnWriter<uint16_t> pvt_wnc_;
+        io_comm_rx::ColumnWriter<uint8_t> pvt_mode_;
+        io_comm_rx::ColumnWriter<uint8_t> pvt_error_;
+        io_comm_rx::ColumnWriter<double> pvt_latitude_;
+        io_comm_rx::ColumnWriter<double> pvt_longitude_;
+        io_comm_rx::ColumnWriter<double> pvt_height_;
+        io_comm_rx::ColumnWriter<uint8_t> pvt_nr_sv_;
+        io_comm_rx::ColumnWriter<uint16_t> pvt_h_accuracy_;
+        io_comm_rx::ColumnWriter<uint16_t> pvt_v_accuracy_;
+
+        io_comm_rx::ColumnWriter<uint32_t> meas_tow_;
+        io_comm_rx::ColumnWriter<uint16_t> meas_wnc_;
+        io_comm_rx::ColumnWriter<uint8_t> meas_common_flags_;
+        io_comm_rx::ColumnWriter<uint64_t> meas_signal_offset_;
+
+        io_comm_rx::ColumnWriter<uint8_t> signal_sv_id_;
+        io_comm_rx::ColumnWriter<uint8_t> signal_type_;
+        io_comm_rx::ColumnWriter<uint8_t> signal_antenna_;
+        io_comm_rx::ColumnWriter<double> signal_pseudorange_;
+        io_comm_rx::ColumnWriter<double> signal_carrier_phase_;
+        io_comm_rx::ColumnWriter<double> signal_doppler_;
+        io_comm_rx::ColumnWriter<float> signal_cn0_;
+        io_comm_rx::ColumnWriter<uint16_t> signal_lock_time_;
+        io_comm_rx::ColumnWriter<uint8_t> signal_obs_info_;
+
+        io_comm_rx::ColumnWriter<uint32_t> chan_tow_;
+        io_comm_rx::ColumnWriter<uint16_t> chan_wnc_;
+        io_comm_rx::ColumnWriter<uint64_t> chan_satellite_offset_;
+
+        io_comm_rx::ColumnWriter<uint8_t> sat_sv_id_;
+        io_comm_rx::ColumnWriter<uint8_t> sat_freq_nr_;
+        io_comm_rx::ColumnWriter<uint16_t> sat_azimuth_;
+        io_comm_rx::ColumnWriter<uint8_t> sat_rise_set_;
+        io_comm_rx::ColumnWriter<int8_t> sat_elevation_;
+        io_comm_rx::ColumnWriter<uint16_t> sat_health_status_;
+        io_comm_rx::ColumnWriter<uint8_t> sat_rx_channel_;
+
+        //! All of the above
+        std::vector<io_comm_rx::ColumnFileWriter*> files_;
+    };
+} // namespace
+
+int main(int argc, char** argv)
+{
+    // Only the logging of ROS is used, no master is contacted
+    ros::init(argc, argv, "sbf_to_columns",
+              ros::init_options::NoSigintHandler | ros::init_options::NoRosout);
+
+    if (argc != 3)
+    {
+        std::cerr << "Usage: sbf_to_columns <input.sbf> <output_dir>" << std::endl;
+        return 1;
+    }
+    std::string input(argv[1]);
+    std::string output(argv[2]);
+
+    auto start = std::chrono::steady_clock::now();
+    LogNode node;
+    io_comm_rx::SbfIndex index(&node);
+    if (!index.load(input))
+        return 1;
+
+    int fd = ::open(input.c_str(), O_RDONLY);
+    struct stat file_stat;
+    if ((fd < 0) || (::fstat(fd, &file_stat) != 0) || (file_stat.st_size == 0))
+    {
+        std::cerr << "Could not open " << input << std::endl;
+        return 1;
+    }
+    uint64_t size = static_cast<uint64_t>(file_stat.st_size);
+    const uint8_t* data = static_cast<const uint8_t*>(
+        ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0));
+    ::close(fd);
+    if (data == MAP_FAILED)
+    {
+        std::cerr << "Could not map " << input << std::endl;
+        return 1;
+    }
+    ::madvise(const_cast<uint8_t*>(data), size, MADV_SEQUENTIAL);
+
+    ColumnExporter exporter(output);
+    if (!exporter.good())
+        return 1;
+    // The messages are reused, so that their arrays keep their capacity
+    PVTGeodeticMsg pvt;
+    MeasEpochMsg meas_epoch;
+    RawObservablesMsg observables;
+    ChannelStatus channel_status;
+    parsing_utilities::MeasEpochDecoder decoder;
+    // The index only holds blocks of valid length and CRC
+    for (const auto& entry : index.entries())
+    {
+        const uint8_t* block = data + entry.offset;
+        const uint8_t* block_end = block + parsing_utilities::getLength(block);
+        switch (entry.block_id)
+        {
+        case 4007:
+        {
+            if (PVTGeodeticParser(&node, block, block_end, pvt))
+                exporter.add(pvt);
+            break;
+        }
+        case 4027:
+        {
+            if (MeasEpochParser(&node, block, block_end, meas_epoch))
+            {
+                decoder.decode(meas_epoch, observables);
+                exporter.add(observables);
+            }
+            break;
+        }
+        case 4013:
+        {
+            if (ChannelStatusParser(&node, block, block_end, channel_status))
+                exporter.add(channel_status);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    ::munmap(const_cast<uint8_t*>(data), size);
+    if (!exporter.close())
+        return 1;
+    auto done = std::chrono::steady_clock::now();
+
+    double mb = static_cast<double>(size) / 1e6;
+    double total_s = std::chrono::duration<double>(done - start).count();
+    std::cout << "Exported " << mb << " MB at " << mb / total_s << " MB/s"
+              << std::endl;
+    exporter.printRows();
+    return 0;
+}
@@ -0,0 +1,160 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROSaic includes
+#include <septentrio_gnss_driver/parsers/gsv_assembler.hpp>
+
+/**
+ * @file gsv_assembler.cpp
+ * @brief Defines an assembler of the multi-part GSV sentences of all
+ * constellations into one message per epoch
+ * @date 16/10/26
+ */
+
+namespace parsing_utilities {
+
+    GsvAssembler::GsvAssembler() : seen_(0), ended_(0), expected_(0), rejected_(0)
+    {
+    }
+
+    bool GsvAssembler::constellation(const std::string& id, uint8_t& constellation)
+    {
+        std::string talker = id.substr(1, 2);
+        if (talker == "GP")
+            constellation = SatellitesInViewMsg::GPS;
+        else if (talker == "GL")
+            constellation = SatellitesInViewMsg::GLONASS;
+        else if (talker == "GA")
+            constellation = SatellitesInViewMsg::GALILEO;
+        else if ((talker == "GB") || (talker == "BD"))
+            constellation = SatellitesInViewMsg::BEIDOU;
+        else
+            return false;
+        return true;
+    }
+
+    bool GsvAssembler::add(uint8_t constellation, const GpgsvMsg& part,
+                           SatellitesInViewMsg& out)
+    {
+        if (constellation >= CONSTELLATIONS)
+            return false;
+        uint8_t bit = 1 << constellation;
+        bool published = false;
+        // A constellation starting over begins the next epoch
+        if ((part.msg_number == 1) && (seen_ & bit))
+            published = endEpoch(out);
+        if (seen_ == 0)
+            header_ = part.header;
+        seen_ |= bit;
+
+        Sequence& sequence = sequences_[constellation];
+        if (part.msg_number == 1)
+        {
+            sequence.state = State::ASSEMBLING;
+            sequence.n_msgs = part.n_msgs;
+            sequence.n_satellites = part.n_satellites;
+            sequence.next = 1;
+            sequence.satellites.clear();
+        }
+        // A sequence whose start was missed, or with a missing sentence
+        if ((sequence.state == State::IDLE) ||
+            ((sequence.state == State::ASSEMBLING) &&
+             ((part.msg_number != sequence.next) ||
+              (part.n_msgs != sequence.n_msgs) ||
+              (part.n_satellites != sequence.n_satellites))))
+        {
+            reject(sequence);
+            ended_ |= bit;
+        }
+        if (sequence.state == State::ASSEMBLING)
+        {
+            sequence.satellites.insert(sequence.satellites.end(),
+                                       part.satellites.begin(),
+                                       part.satellites.end());
+            ++sequence.next;
+            if (part.msg_number == sequence.n_msgs)
+            {
+                if (sequence.satellites.size() == sequence.n_satellites)
+                    sequence.state = State::COMPLETE;
+                else
+                    reject(sequence);
+                ended_ |= bit;
+            }
+        }
+
+        // All constellations of the previous epoch are in, no need to wait for
+        // the next epoch
+        if (!published && (expected_ != 0) && ((ended_ & expected_) == expected_) &&
+            (ended_ == seen_))
+            published = endEpoch(out);
+        return published;
+    }
+
+    bool GsvAssembler::endEpoch(SatellitesInViewMsg& out)
+    {
+        out.header = header_;
+        out.constellation.clear();
+        out.prn.clear();
+        out.elevation.clear();
+        out.azimuth.clear();
+        out.snr.clear();
+        bool complete = false;
+        for (std::size_t i = 0; i < CONSTELLATIONS; ++i)
+        {
+            Sequence& sequence = sequences_[i];
+            if (sequence.state == State::ASSEMBLING)
+                reject(sequence);
+            if (sequence.state == State::COMPLETE)
+            {
+                complete = true;
+                for (const auto& satellite : sequence.satellites)
+                {
+                    out.constellation.push_back(static_cast<uint8_t>(i));
+                    out.prn.push_back(satellite.prn);
+                    out.elevation.push_back(satellite.elevation);
+                    out.azimuth.push_back(satellite.azimuth);
+                    out.snr.push_back(satellite.snr);
+                }
+            }
+            sequence.state = State::IDLE;
+        }
+        expected_ = seen_;
+        seen_ = 0;
+        ended_ = 0;
+        return complete;
+    }
+
+    void GsvAssembler::reject(Sequence& sequence)
+    {
+        ++rejected_;
+        sequence.state = State::REJECTED;
+        sequence.satellites.clear();
+    }
+} // namespace parsing_utilities
@@ -0,0 +1,224 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROSaic includes
+#include <septentrio_gnss_driver/parsers/meas_epoch_decoder.hpp>
+// C++ library includes
+#include <limits>
+
+/**
+ * @file meas_epoch_decoder.cpp
+ * @brief Defines a decoder of MeasEpoch blocks into observables in SI units
+ * @date 16/10/26
+ */
+
+namespace parsing_utilities {
+
+    namespace {
+        constexpr double SPEED_OF_LIGHT = 299792458.0;
+        constexpr double NAN_D = std::numeric_limits<double>::quiet_NaN();
+        constexpr float NAN_F = std::numeric_limits<float>::quiet_NaN();
+
+        //! Carrier frequencies of the SBF signal numbers [MHz], 0 if unknown or
+        //! GLONASS FDMA
+        constexpr double FREQUENCIES[] = {
+            1575.42,  1575.42, 1227.60, 1227.60, 1176.45, 1575.42, 1575.42,
+            1227.60,  0.0,     0.0,     0.0,     0.0,     1202.025, 1575.42,
+            1176.45,  1176.45, 0.0,     1575.42, 0.0,     1278.75, 1176.45,
+            1207.14,  1191.795, 0.0,    1575.42, 1176.45, 1176.45, 1278.75,
+            1561.098, 1207.14, 1268.52, 0.0,     1575.42, 1575.42, 1207.14};
+
+        //! Signal number, extended by the ObsInfo field for numbers above 31
+        uint8_t signalNumber(uint8_t type, uint8_t obs_info)
+        {
+            uint8_t sig_idx_lo = type & 0x1F;
+            if (sig_idx_lo == 31)
+                return 32 + ((obs_info >> 3) & 0x1F);
+            return sig_idx_lo;
+        }
+
+        //! GLONASS frequency number, carried by the ObsInfo field
+        int8_t glonassFrequencyNumber(uint8_t obs_info)
+        {
+            return static_cast<int8_t>(((obs_info >> 3) & 0x1F) - 8);
+        }
+
+        //! Offset of the C/N0 of a signal [dB-Hz], GPS P(Y) has none
+        float cn0Offset(uint8_t signal)
+        {
+            return ((signal == 1) || (signal == 2)) ? 0.0f : 10.0f;
+        }
+
+        //! Sign-extends the lowest bits of a value
+        int32_t signExtend(uint32_t value, unsigned bits)
+        {
+            uint32_t sign = 1u << (bits - 1);
+            value &= (1u << bits) - 1;
+            return static_cast<int32_t>(value ^ sign) - static_cast<int32_t>(sign);
+        }
+    } // namespace
+
+    double MeasEpochDecoder::frequency(uint8_t signal, int8_t glonass_fn)
+    {
+        switch (signal)
+        {
+        case 8: // GLONASS L1CA
+        case 9: // GLONASS L1P
+            return 1602.0e6 + glonass_fn * 562.5e3;
+        case 10: // GLONASS L2P
+        case 11: // GLONASS L2CA
+            return 1246.0e6 + glonass_fn * 437.5e3;
+        default:
+            if (signal < sizeof(FREQUENCIES) / sizeof(FREQUENCIES[0]))
+                return FREQUENCIES[signal] * 1.0e6;
+            return 0.0;
+        }
+    }
+
+    void MeasEpochDecoder::resize(std::size_t size)
+    {
+        for (auto* v : {&code_ref_, &code_offset_, &code_valid_, &carrier_,
+                        &carrier_valid_, &wavelength_, &doppler_ref_,
+                        &doppler_ratio_, &doppler_offset_, &doppler_valid_})
+            v->resize(size);
+        cn0_raw_.resize(size);
+        cn0_offset_.resize(size);
+    }
+
+    void MeasEpochDecoder::decode(const MeasEpochMsg& in, RawObservablesMsg& out)
+    {
+        out.header = in.header;
+        out.block_header = in.block_header;
+        out.common_flags = in.common_flags;
+        out.cum_clk_jumps = in.cum_clk_jumps;
+
+        std::size_t size = in.type1.size();
+        for (const auto& t1 : in.type1)
+            size += t1.type2.size();
+        resize(size);
+        out.sv_id.resize(size);
+        out.signal_type.resize(size);
+        out.antenna.resize(size);
+        out.pseudorange.resize(size);
+        out.carrier_phase.resize(size);
+        out.doppler.resize(size);
+        out.cn0.resize(size);
+        out.lock_time.resize(size);
+        out.obs_info.resize(size);
+
+        // Gather the raw fields of all signals
+        std::size_t i = 0;
+        for (const auto& t1 : in.type1)
+        {
+            uint8_t signal1 = signalNumber(t1.type, t1.obs_info);
+            double f1 = frequency(signal1, glonassFrequencyNumber(t1.obs_info));
+            uint8_t code_msb = t1.misc & 0x0F;
+            bool code1_valid = (code_msb != 0) || (t1.code_lsb != 0);
+            double code1 = code_msb * 4294967296.0 + t1.code_lsb;
+            bool doppler1_valid = t1.doppler != std::numeric_limits<int32_t>::min();
+
+            out.sv_id[i] = t1.sv_id;
+            out.signal_type[i] = signal1;
+            out.antenna[i] = t1.type >> 5;
+            out.lock_time[i] = t1.lock_time;
+            out.obs_info[i] = t1.obs_info;
+            code_ref_[i] = code1;
+            code_offset_[i] = 0.0;
+            code_valid_[i] = code1_valid ? 1.0 : NAN_D;
+            carrier_[i] = t1.carrier_msb * 65536.0 + t1.carrier_lsb;
+            carrier_valid_[i] =
+                ((t1.carrier_msb == -128) && (t1.carrier_lsb == 0)) ? NAN_D : 1.0;
+            wavelength_[i] = f1 > 0.0 ? SPEED_OF_LIGHT / f1 : NAN_D;
+            doppler_ref_[i] = t1.doppler;
+            doppler_ratio_[i] = 1.0;
+            doppler_offset_[i] = 0.0;
+            doppler_valid_[i] = doppler1_valid ? 1.0 : NAN_D;
+            cn0_raw_[i] = t1.cn0;
+            cn0_offset_[i] = t1.cn0 == 255 ? NAN_F : cn0Offset(signal1);
+            ++i;
+
+            for (const auto& t2 : t1.type2)
+            {
+                uint8_t signal2 = signalNumber(t2.type, t2.obs_info);
+                double f2 =
+                    frequency(signal2, glonassFrequencyNumber(t2.obs_info));
+                int32_t code_offset_msb = signExtend(t2.offsets_msb, 3);
+                int32_t doppler_offset_msb = signExtend(t2.offsets_msb >> 3, 5);
+                bool code2_valid =
+                    code1_valid &&
+                    !((code_offset_msb == -4) && (t2.code_offset_lsb == 0));
+                bool doppler2_valid =
+                    doppler1_valid &&
+                    !((doppler_offset_msb == -16) && (t2.doppler_offset_lsb == 0));
+
+                out.sv_id[i] = t1.sv_id;
+                out.signal_type[i] = signal2;
+                out.antenna[i] = t2.type >> 5;
+                out.lock_time[i] = t2.lock_time == 255 ? 65535 : t2.lock_time;
+                out.obs_info[i] = t2.obs_info;
+                code_ref_[i] = code1;
+                code_offset_[i] = code_offset_msb * 65536.0 + t2.code_offset_lsb;
+                code_valid_[i] = code2_valid ? 1.0 : NAN_D;
+                carrier_[i] = t2.carrier_msb * 65536.0 + t2.carrier_lsb;
+                carrier_valid_[i] =
+                    ((t2.carrier_msb == -128) && (t2.carrier_lsb == 0)) ? NAN_D
+                                                                        : 1.0;
+                wavelength_[i] = f2 > 0.0 ? SPEED_OF_LIGHT / f2 : NAN_D;
+                doppler_ref_[i] = t1.doppler;
+                doppler_ratio_[i] = (f1 > 0.0) && (f2 > 0.0) ? f2 / f1 : NAN_D;
+                doppler_offset_[i] =
+                    doppler_offset_msb * 65536.0 + t2.doppler_offset_lsb;
+                doppler_valid_[i] = doppler2_valid ? 1.0 : NAN_D;
+                cn0_raw_[i] = t2.cn0;
+                cn0_offset_[i] = t2.cn0 == 255 ? NAN_F : cn0Offset(signal2);
+                ++i;
+            }
+        }
+
+        // Convert all signals at once, NaN marking what is not available
+        double* pseudorange = out.pseudorange.data();
+        double* carrier_phase = out.carrier_phase.data();
+        double* doppler = out.doppler.data();
+        float* cn0 = out.cn0.data();
+        for (std::size_t j = 0; j < size; ++j)
+            pseudorange[j] =
+                (code_ref_[j] + code_offset_[j]) * 0.001 * code_valid_[j];
+        for (std::size_t j = 0; j < size; ++j)
+            carrier_phase[j] =
+                (pseudorange[j] / wavelength_[j] + carrier_[j] * 0.001) *
+                carrier_valid_[j];
+        for (std::size_t j = 0; j < size; ++j)
+            doppler[j] =
+                (doppler_ref_[j] * doppler_ratio_[j] + doppler_offset_[j]) *
+                1.0e-4 * doppler_valid_[j];
+        for (std::size_t j = 0; j < size; ++j)
+            cn0[j] = cn0_raw_[j] * 0.25f + cn0_offset_[j];
+    }
+} // namespace parsing_utilities
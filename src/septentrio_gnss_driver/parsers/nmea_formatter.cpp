@@ -0,0 +1,149 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROSaic includes
+#include <septentrio_gnss_driver/parsers/nmea_formatter.hpp>
+// C++ library includes
+#include <cmath>
+
+/**
+ * @file nmea_formatter.cpp
+ * @brief Defines a formatter of NMEA sentences working on a fixed buffer
+ * @date 16/10/26
+ */
+
+namespace string_utilities {
+
+    namespace {
+        //! Largest magnitude appendFixed3() formats, keeps the product in int64
+        constexpr double MAX_FIXED3 = 1.0e12;
+
+        //! Writes the n lowest decimal digits of value, zero-padded, returns end
+        char* writeDigits(char* out, uint64_t value, std::size_t n)
+        {
+            for (std::size_t i = n; i > 0; --i)
+            {
+                out[i - 1] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            }
+            return out + n;
+        }
+
+        //! Writes value without padding, returns end
+        char* writeUnsigned(char* out, uint64_t value)
+        {
+            std::size_t n = 1;
+            for (uint64_t v = value / 10; v != 0; v /= 10)
+                ++n;
+            return writeDigits(out, value, n);
+        }
+    } // namespace
+
+    NmeaFormatter::NmeaFormatter() : size_(0), failed_(false) {}
+
+    void NmeaFormatter::begin(const char* address)
+    {
+        size_ = 0;
+        failed_ = false;
+        while ((*address != '\0') && (size_ < CAPACITY))
+            buffer_[size_++] = *address++;
+        if (*address != '\0')
+            failed_ = true;
+    }
+
+    char* NmeaFormatter::field(std::size_t max_length)
+    {
+        if (failed_ || (size_ + 1 + max_length > CAPACITY))
+        {
+            failed_ = true;
+            return nullptr;
+        }
+        buffer_[size_++] = ',';
+        return buffer_ + size_;
+    }
+
+    void NmeaFormatter::appendTime(uint64_t stamp)
+    {
+        char* out = field(10);
+        if (!out)
+            return;
+        uint64_t secondOfDay = (stamp / 1000000000) % 86400;
+        out = writeDigits(out, secondOfDay / 3600, 2);
+        out = writeDigits(out, (secondOfDay / 60) % 60, 2);
+        out = writeDigits(out, secondOfDay % 60, 2);
+        *out++ = '.';
+        out = writeDigits(out, (stamp % 1000000000) / 1000000, 3);
+        size_ = out - buffer_;
+    }
+
+    void NmeaFormatter::appendFixed3(double value)
+    {
+        // sign, 13 integer digits, '.' and 3 decimals
+        char* out = field(18);
+        if (!out)
+            return;
+        if (!std::isfinite(value) || (std::abs(value) >= MAX_FIXED3))
+        {
+            failed_ = true;
+            return;
+        }
+        // Same rounding as trimDecimalPlaces(): half away from zero
+        int64_t thousandths = std::llround(value * 1000.0);
+        uint64_t magnitude = thousandths < 0 ? -thousandths : thousandths;
+        if (thousandths < 0)
+            *out++ = '-';
+        out = writeUnsigned(out, magnitude / 1000);
+        *out++ = '.';
+        out = writeDigits(out, magnitude % 1000, 3);
+        size_ = out - buffer_;
+    }
+
+    void NmeaFormatter::appendEmpty() { field(0); }
+
+    bool NmeaFormatter::finish()
+    {
+        if (failed_ || (size_ < 1) || (size_ + 5 > CAPACITY))
+        {
+            failed_ = true;
+            return false;
+        }
+        // Checksum is the XOR of all characters between '$' and '*'
+        uint8_t checksum = 0;
+        for (std::size_t i = 1; i < size_; ++i)
+            checksum ^= static_cast<uint8_t>(buffer_[i]);
+        static const char hex[] = "0123456789ABCDEF";
+        buffer_[size_++] = '*';
+        buffer_[size_++] = hex[checksum >> 4];
+        buffer_[size_++] = hex[checksum & 0x0F];
+        buffer_[size_++] = '\r';
+        buffer_[size_++] = '\n';
+        return true;
+    }
+} // namespace string_utilities
@@ -32,6 +32,8 @@
 #include <septentrio_gnss_driver/parsers/parsing_utilities.hpp>
 #include <septentrio_gnss_driver/parsers/string_utilities.h>
 // C++ library includes
+#include <algorithm>
+#include <iterator>
 #include <limits>
 // Boost
 #include <boost/spirit/include/qi_binary.hpp>
@@ -356,4 +358,25 @@ namespace parsing_utilities {
     uint32_t getTow(const uint8_t* buffer) { return parseUInt32(buffer + 8); }
 
     uint16_t getWnc(const uint8_t* buffer) { return parseUInt16(buffer + 12); }
+
+    bool isSbfBlockNumber(uint16_t id)
+    {
+        // Measurement, navigation page, decoded message, PVT, INS, attitude,
+        // time, correction, L-band and status blocks, sorted
+        static const uint16_t numbers[] = {
+            4000, 4001, 4002, 4003, 4004, 4005, 4006, 4007, 4008, 4009, 4011, 4012,
+            4013, 4014, 4015, 4017, 4018, 4019, 4020, 4021, 4022, 4023, 4024, 4026,
+            4027, 4028, 4030, 4031, 4032, 4034, 4036, 4037, 4038, 4040, 4042, 4043,
+            4044, 4046, 4047, 4049, 4050, 4052, 4053, 4054, 4056, 4057, 4058, 4059,
+            4066, 4067, 4068, 4069, 4075, 4076, 4079, 4081, 4082, 4083, 4084, 4085,
+            4086, 4087, 4089, 4090, 4091, 4092, 4093, 4094, 4095, 4096, 4097, 4101,
+            4102, 4103, 4105, 4106, 4107, 4109, 4110, 4111, 4112, 4113, 4116, 4119,
+            4120, 4121, 4122, 4201, 4204, 4212, 4214, 4217, 4218, 4219, 4221, 4222,
+            4223, 4224, 4225, 4226, 4227, 4228, 4229, 4230, 4231, 4237, 4238, 4242,
+            4243, 4244, 4246, 4251, 4252, 4253, 4270, 4271, 5891, 5892, 5893, 5894,
+            5896, 5897, 5902, 5905, 5906, 5907, 5908, 5911, 5914, 5917, 5918, 5919,
+            5921, 5922, 5924, 5925, 5926, 5927, 5928, 5929, 5930, 5931, 5932, 5933,
+            5934, 5935, 5936, 5938, 5939, 5942, 5943, 5949};
+        return std::binary_search(std::begin(numbers), std::end(numbers), id);
+    }
 } // namespace parsing_utilities
@@ -0,0 +1,175 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROSaic includes
+#include <septentrio_gnss_driver/parsers/utm_projection.hpp>
+// C++ library includes
+#include <cmath>
+// GeographicLib includes
+#include <GeographicLib/Constants.hpp>
+#include <GeographicLib/UTMUPS.hpp>
+
+/**
+ * @file utm_projection.cpp
+ * @brief Defines a UTM projection caching the state of the current zone
+ * @date 16/10/26
+ */
+
+namespace parsing_utilities {
+
+    namespace {
+        constexpr double DEG = M_PI / 180.0;
+        constexpr double FALSE_EASTING = 500000.0;
+        constexpr double FALSE_NORTHING_SOUTH = 10000000.0;
+    } // namespace
+
+    UtmProjection::UtmProjection() :
+        zone_(-1), northp_(true), locked_(false), lon0_(0.0),
+        false_northing_(0.0)
+    {
+        double a = GeographicLib::Constants::WGS84_a();
+        double f = GeographicLib::Constants::WGS84_f();
+        e_ = std::sqrt(f * (2.0 - f));
+        double n = f / (2.0 - f);
+        double n2 = n * n;
+        double n3 = n2 * n;
+        double n4 = n3 * n;
+        double n5 = n4 * n;
+        double n6 = n5 * n;
+        k0A_ = GeographicLib::Constants::UTM_k0() * a / (1.0 + n) *
+               (1.0 + n2 / 4.0 + n4 / 64.0 + n6 / 256.0);
+        // Karney (2011), Transverse Mercator with an accuracy of a few nanometers
+        alpha_[0] = 0.0;
+        alpha_[1] = n / 2.0 - 2.0 * n2 / 3.0 + 5.0 * n3 / 16.0 + 41.0 * n4 / 180.0 -
+                    127.0 * n5 / 288.0 + 7891.0 * n6 / 37800.0;
+        alpha_[2] = 13.0 * n2 / 48.0 - 3.0 * n3 / 5.0 + 557.0 * n4 / 1440.0 +
+                    281.0 * n5 / 630.0 - 1983433.0 * n6 / 1935360.0;
+        alpha_[3] = 61.0 * n3 / 240.0 - 103.0 * n4 / 140.0 +
+                    15061.0 * n5 / 26880.0 + 167603.0 * n6 / 181440.0;
+        alpha_[4] = 49561.0 * n4 / 161280.0 - 179.0 * n5 / 168.0 +
+                    6601661.0 * n6 / 7257600.0;
+        alpha_[5] = 34729.0 * n5 / 80640.0 - 3418889.0 * n6 / 1995840.0;
+        alpha_[6] = 212378941.0 * n6 / 319334400.0;
+    }
+
+    void UtmProjection::forward(double lat, double lon, double& easting,
+                                double& northing, double& gamma)
+    {
+        if (!locked_)
+        {
+            bool northp = (lat >= 0.0);
+            if ((zone_ < 0) || (northp != northp_) || !inZone(lat, lon))
+            {
+                int zone = GeographicLib::UTMUPS::StandardZone(lat, lon);
+                if ((zone != zone_) || (northp != northp_))
+                    setZone(zone, northp);
+            }
+        }
+        if (zone_ == GeographicLib::UTMUPS::UPS)
+        {
+            int zone;
+            bool northp;
+            double k;
+            GeographicLib::UTMUPS::Forward(lat, lon, zone, northp, easting,
+                                           northing, gamma, k, zone_);
+            return;
+        }
+
+        double phi = lat * DEG;
+        double lam = std::remainder(lon - lon0_, 360.0) * DEG;
+        // Conformal latitude
+        double tau = std::tan(phi);
+        double sig = std::sinh(e_ * std::atanh(e_ * tau / std::hypot(1.0, tau)));
+        double taup = tau * std::hypot(1.0, sig) - sig * std::hypot(1.0, tau);
+        // Spherical transverse Mercator
+        double coslam = std::cos(lam);
+        double sinlam = std::sin(lam);
+        double xip = std::atan2(taup, coslam);
+        double etap = std::asinh(sinlam / std::hypot(taup, coslam));
+        // Krüger series in zeta' = xi' + i eta', with sin(2j zeta') and
+        // cos(2j zeta') by angle addition
+        double sin2xip = std::sin(2.0 * xip);
+        double cos2xip = std::cos(2.0 * xip);
+        double exp2etap = std::exp(2.0 * etap);
+        double sinh2etap = (exp2etap - 1.0 / exp2etap) / 2.0;
+        double cosh2etap = (exp2etap + 1.0 / exp2etap) / 2.0;
+        double s1r = sin2xip * cosh2etap;
+        double s1i = cos2xip * sinh2etap;
+        double c1r = cos2xip * cosh2etap;
+        double c1i = -sin2xip * sinh2etap;
+        double sr = s1r, si = s1i, cr = c1r, ci = c1i;
+        double xi = xip, eta = etap;
+        // Derivative of zeta with respect to zeta'
+        double dzr = 1.0, dzi = 0.0;
+        for (int j = 1; j <= ORDER; ++j)
+        {
+            xi += alpha_[j] * sr;
+            eta += alpha_[j] * si;
+            dzr += 2.0 * j * alpha_[j] * cr;
+            dzi += 2.0 * j * alpha_[j] * ci;
+            double sr_next = sr * c1r - si * c1i + cr * s1r - ci * s1i;
+            double si_next = sr * c1i + si * c1r + cr * s1i + ci * s1r;
+            double cr_next = cr * c1r - ci * c1i - sr * s1r + si * s1i;
+            double ci_next = cr * c1i + ci * c1r - sr * s1i - si * s1r;
+            sr = sr_next;
+            si = si_next;
+            cr = cr_next;
+            ci = ci_next;
+        }
+        easting = FALSE_EASTING + k0A_ * eta;
+        northing = false_northing_ + k0A_ * xi;
+        // Convergence of the spherical projection plus that of the series
+        gamma = (std::atan2(taup * sinlam, std::hypot(1.0, taup) * coslam) +
+                 std::atan2(-dzi, dzr)) /
+                DEG;
+    }
+
+    bool UtmProjection::inZone(double lat, double lon) const
+    {
+        if ((zone_ <= 0) || (lat < -80.0) || (lat >= 84.0))
+            return false;
+        double lam = std::remainder(lon - lon0_, 360.0);
+        if ((lam < -3.0) || (lam >= 3.0))
+            return false;
+        // Zones 31 to 37 are irregular in the Norway and Svalbard bands
+        return (zone_ < 31) || (zone_ > 37) || (lat < 56.0) ||
+               ((lat >= 64.0) && (lat < 72.0));
+    }
+
+    void UtmProjection::setZone(int zone, bool northp)
+    {
+        zone_ = zone;
+        northp_ = northp;
+        lon0_ = 6.0 * zone - 183.0;
+        false_northing_ = northp ? 0.0 : FALSE_NORTHING_SOUTH;
+        zone_string_ = GeographicLib::UTMUPS::EncodeZone(zone, northp);
+        frame_id_ = "utm_" + zone_string_;
+    }
+} // namespace parsing_utilities
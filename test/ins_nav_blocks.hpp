@@ -0,0 +1,94 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#ifndef INS_NAV_BLOCKS_HPP
+#define INS_NAV_BLOCKS_HPP
+
+// ROSaic includes
+#include <septentrio_gnss_driver/packed_structs/sbf_structs.hpp>
+// C++ library includes
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/**
+ * @file ins_nav_blocks.hpp
+ * @date 16/10/26
+ * @brief Synthetic INSNavGeod and INSNavCart blocks for the tests and benchmarks
+ * of their parsers
+ */
+
+//! Iterator over the bytes of a block that makes the parsers use Qi on any host
+typedef std::vector<uint8_t>::const_iterator QiIterator;
+
+template <>
+struct ParsedWithQi<QiIterator>
+{
+    static constexpr bool value = true;
+};
+
+namespace ins_nav_blocks {
+    //! Bytes of INSNavGeod up to and including SBList
+    const std::size_t GEOD_FIXED_LENGTH = 56;
+    //! Bytes of INSNavCart up to and including SBList
+    const std::size_t CART_FIXED_LENGTH = 52;
+
+    /**
+     * @brief Makes a block of random content but for its header and SBList
+     * @param[in] id Block number, 4226 for INSNavGeod or 4225 for INSNavCart
+     * @param[in] sb_list Sub-blocks present, each of three floats
+     * @param[in,out] rng Source of the content
+     */
+    inline std::vector<uint8_t> make(uint16_t id, uint16_t sb_list,
+                                     std::mt19937& rng)
+    {
+        std::size_t fixed = id == 4226 ? GEOD_FIXED_LENGTH : CART_FIXED_LENGTH;
+        std::size_t length = fixed;
+        for (uint16_t bit = 1; bit < 256; bit <<= 1)
+        {
+            if ((sb_list & bit) != 0)
+                length += 12;
+        }
+        std::vector<uint8_t> block(length);
+        for (auto& byte : block)
+            byte = static_cast<uint8_t>(rng());
+        block[0] = SBF_SYNC_BYTE_1;
+        block[1] = SBF_SYNC_BYTE_2;
+        block[4] = id & 0xFF;
+        block[5] = id >> 8;
+        block[6] = length & 0xFF;
+        block[7] = length >> 8;
+        block[fixed - 2] = sb_list & 0xFF;
+        block[fixed - 1] = sb_list >> 8;
+        return block;
+    }
+} // namespace ins_nav_blocks
+
+#endif // INS_NAV_BLOCKS_HPP
@@ -0,0 +1,105 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROSaic includes
+#include <septentrio_gnss_driver/parsers/meas_epoch_decoder.hpp>
+// C++ library includes
+#include <chrono>
+#include <cstdio>
+
+/**
+ * @file meas_epoch_decoder_benchmark.cpp
+ * @date 16/10/26
+ * @brief Measures the cost per epoch of the MeasEpoch decoder at 120 channels
+ * with 3 signals each
+ */
+
+namespace {
+    //! Number of epochs decoded
+    const std::size_t EPOCHS = 100000;
+    //! Type1 sub-blocks per epoch
+    const std::size_t CHANNELS = 120;
+    //! Type2 sub-blocks per type1 sub-block
+    const std::size_t TYPE2_PER_CHANNEL = 2;
+} // namespace
+
+int main()
+{
+    // GPS L1CA with L2C and L5, Galileo E1 with E5a and E5b
+    const uint8_t signals[2][3] = {{0, 3, 4}, {17, 20, 21}};
+    MeasEpochMsg in;
+    for (std::size_t c = 0; c < CHANNELS; ++c)
+    {
+        const uint8_t* signal = signals[c % 2];
+        MeasEpochChannelType1Msg t1;
+        t1.rx_channel = c;
+        t1.type = signal[0];
+        t1.sv_id = 1 + c % 36;
+        t1.misc = 4;
+        t1.code_lsb = 1000000000u + 7919u * c;
+        t1.doppler = -10000000 + 1000 * static_cast<int32_t>(c);
+        t1.carrier_msb = -3;
+        t1.carrier_lsb = 1000 + c;
+        t1.cn0 = 160;
+        t1.lock_time = 300;
+        for (std::size_t s = 1; s <= TYPE2_PER_CHANNEL; ++s)
+        {
+            MeasEpochChannelType2Msg t2;
+            t2.type = signal[s];
+            t2.lock_time = 12;
+            t2.cn0 = 100;
+            t2.offsets_msb = 7 | (2 << 3);
+            t2.carrier_lsb = 2 + c;
+            t2.code_offset_lsb = 5000 + c;
+            t2.doppler_offset_lsb = 300;
+            t1.type2.push_back(t2);
+        }
+        in.type1.push_back(t1);
+    }
+
+    parsing_utilities::MeasEpochDecoder decoder;
+    RawObservablesMsg out;
+    double sum = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t e = 0; e < EPOCHS; ++e)
+    {
+        in.type1[e % CHANNELS].code_lsb += 1;
+        decoder.decode(in, out);
+        sum += out.carrier_phase[e % out.carrier_phase.size()];
+    }
+    std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::size_t signals_per_epoch = CHANNELS * (1 + TYPE2_PER_CHANNEL);
+    std::printf("MeasEpochDecoder %zu signals: %8.1f ns/epoch, %5.2f ns/signal "
+                "(checksum %.0f)\n",
+                signals_per_epoch, elapsed.count() / EPOCHS,
+                elapsed.count() / EPOCHS / signals_per_epoch, sum);
+    return 0;
+}
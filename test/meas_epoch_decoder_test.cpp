@@ -0,0 +1,288 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROSaic includes
+#include <septentrio_gnss_driver/parsers/meas_epoch_decoder.hpp>
+// C++ library includes
+#include <cmath>
+#include <limits>
+// Google Test includes
+#include <gtest/gtest.h>
+
+/**
+ * @file meas_epoch_decoder_test.cpp
+ * @date 16/10/26
+ * @brief Checks the MeasEpoch decoder against observables computed by hand from
+ * the SBF reference guide
+ */
+
+using parsing_utilities::MeasEpochDecoder;
+
+namespace {
+    //! Tolerance of pseudoranges [m]
+    const double TOLERANCE_M = 1.0e-6;
+    //! Tolerance of carrier phases [cycles]
+    const double TOLERANCE_CYCLES = 1.0e-5;
+    //! Tolerance of Dopplers [Hz]
+    const double TOLERANCE_HZ = 1.0e-6;
+
+    //! Type1 sub-block of GPS L1CA with all fields available
+    MeasEpochChannelType1Msg type1()
+    {
+        MeasEpochChannelType1Msg t1;
+        t1.type = 0; // GPS L1CA, main antenna
+        t1.sv_id = 5;
+        t1.misc = 4; // CodeMSB
+        t1.code_lsb = 1234567890;
+        t1.doppler = -12345678;
+        t1.carrier_msb = -3;
+        t1.carrier_lsb = 1000;
+        t1.cn0 = 160;
+        t1.lock_time = 300;
+        return t1;
+    }
+
+    //! Type2 sub-block of GPS L2C with all fields available
+    MeasEpochChannelType2Msg type2()
+    {
+        MeasEpochChannelType2Msg t2;
+        t2.type = 3 | (1 << 5); // GPS L2C, antenna 1
+        t2.lock_time = 12;
+        t2.cn0 = 100;
+        t2.offsets_msb = 7 | (2 << 3); // CodeOffsetMSB -1, DopplerOffsetMSB 2
+        t2.carrier_msb = 0;
+        t2.carrier_lsb = 2;
+        t2.code_offset_lsb = 5000;
+        t2.doppler_offset_lsb = 300;
+        return t2;
+    }
+
+    //! Decodes an epoch of the given type1 sub-blocks
+    RawObservablesMsg decode(const std::vector<MeasEpochChannelType1Msg>& type1)
+    {
+        MeasEpochMsg in;
+        in.type1 = type1;
+        RawObservablesMsg out;
+        MeasEpochDecoder decoder;
+        decoder.decode(in, out);
+        return out;
+    }
+} // namespace
+
+TEST(MeasEpochDecoder, DecodesType1AndType2)
+{
+    MeasEpochChannelType1Msg t1 = type1();
+    MeasEpochChannelType2Msg t2 = type2();
+    t2.carrier_msb = 1;
+    t1.type2.push_back(t2);
+    RawObservablesMsg out = decode({t1});
+
+    ASSERT_EQ(2u, out.pseudorange.size());
+    // Type1: (4 * 2^32 + 1234567890) mm
+    EXPECT_EQ(5, out.sv_id[0]);
+    EXPECT_EQ(0, out.signal_type[0]);
+    EXPECT_EQ(0, out.antenna[0]);
+    EXPECT_NEAR(18414437.074, out.pseudorange[0], TOLERANCE_M);
+    // pseudorange / (c / 1575.42 MHz) + (-3 * 65536 + 1000) mcycles
+    EXPECT_NEAR(96768324.349634, out.carrier_phase[0], TOLERANCE_CYCLES);
+    EXPECT_NEAR(-1234.5678, out.doppler[0], TOLERANCE_HZ);
+    // 160 * 0.25 + 10 dB-Hz
+    EXPECT_FLOAT_EQ(50.0f, out.cn0[0]);
+    EXPECT_EQ(300, out.lock_time[0]);
+
+    // Type2: code offset (-1 * 65536 + 5000) mm
+    EXPECT_EQ(5, out.sv_id[1]);
+    EXPECT_EQ(3, out.signal_type[1]);
+    EXPECT_EQ(1, out.antenna[1]);
+    EXPECT_NEAR(18414376.538, out.pseudorange[1], TOLERANCE_M);
+    // pseudorange / (c / 1227.60 MHz) + (1 * 65536 + 2) mcycles
+    EXPECT_NEAR(75403859.178629, out.carrier_phase[1], TOLERANCE_CYCLES);
+    // -12345678 * 1227.60 / 1575.42 + 2 * 65536 + 300 [0.1 mHz]
+    EXPECT_NEAR(-948.863683117, out.doppler[1], TOLERANCE_HZ);
+    // 100 * 0.25 + 10 dB-Hz
+    EXPECT_FLOAT_EQ(35.0f, out.cn0[1]);
+    EXPECT_EQ(12, out.lock_time[1]);
+}
+
+TEST(MeasEpochDecoder, AppliesNoCn0OffsetToGpsPy)
+{
+    MeasEpochChannelType1Msg t1 = type1();
+    t1.type = 1; // GPS L1P
+    MeasEpochChannelType2Msg t2 = type2();
+    t2.type = 2; // GPS L2P
+    t1.type2.push_back(t2);
+    RawObservablesMsg out = decode({t1});
+
+    ASSERT_EQ(2u, out.cn0.size());
+    EXPECT_FLOAT_EQ(40.0f, out.cn0[0]);
+    EXPECT_FLOAT_EQ(25.0f, out.cn0[1]);
+}
+
+TEST(MeasEpochDecoder, UsesGlonassFrequencyNumber)
+{
+    EXPECT_DOUBLE_EQ(1598.0625e6, MeasEpochDecoder::frequency(8, -7));
+    EXPECT_DOUBLE_EQ(1248.625e6, MeasEpochDecoder::frequency(11, 6));
+
+    MeasEpochChannelType1Msg t1 = type1();
+    t1.type = 8;     // GLONASS L1CA
+    t1.obs_info = 8; // frequency number 1 - 8 = -7
+    t1.carrier_msb = 0;
+    t1.carrier_lsb = 0;
+    RawObservablesMsg out = decode({t1});
+
+    ASSERT_EQ(1u, out.carrier_phase.size());
+    // pseudorange / (c / 1598.0625 MHz)
+    EXPECT_NEAR(98159311.754831, out.carrier_phase[0], TOLERANCE_CYCLES);
+}
+
+TEST(MeasEpochDecoder, ExtendsSignalNumberByObsInfo)
+{
+    MeasEpochChannelType1Msg t1 = type1();
+    t1.type = 31;
+    t1.obs_info = 1 << 3; // signal 32 + 1, Galileo E1, 1575.42 MHz
+    RawObservablesMsg out = decode({t1});
+
+    ASSERT_EQ(1u, out.signal_type.size());
+    EXPECT_EQ(33, out.signal_type[0]);
+    EXPECT_NEAR(96768324.349634, out.carrier_phase[0], TOLERANCE_CYCLES);
+}
+
+TEST(MeasEpochDecoder, MarksDoNotUseValuesAsNotAvailable)
+{
+    // Type1 pseudorange: CodeMSB and CodeLSB 0, which the type2 inherits
+    MeasEpochChannelType1Msg no_code = type1();
+    no_code.misc = 0;
+    no_code.code_lsb = 0;
+    no_code.type2.push_back(type2());
+    // Type1 carrier: CarrierMSB -128 and CarrierLSB 0
+    MeasEpochChannelType1Msg no_carrier = type1();
+    no_carrier.carrier_msb = -128;
+    no_carrier.carrier_lsb = 0;
+    // Type1 Doppler: -2^31, which the type2 inherits
+    MeasEpochChannelType1Msg no_doppler = type1();
+    no_doppler.doppler = std::numeric_limits<int32_t>::min();
+    no_doppler.type2.push_back(type2());
+    // C/N0 255 and type2 lock time 255
+    MeasEpochChannelType1Msg no_cn0 = type1();
+    no_cn0.cn0 = 255;
+    no_cn0.lock_time = 65535;
+    MeasEpochChannelType2Msg t2_no_cn0 = type2();
+    t2_no_cn0.cn0 = 255;
+    t2_no_cn0.lock_time = 255;
+    no_cn0.type2.push_back(t2_no_cn0);
+    // Type2 offsets: CodeOffsetMSB -4 and CodeOffsetLSB 0, DopplerOffsetMSB -16
+    // and DopplerOffsetLSB 0, CarrierMSB -128 and CarrierLSB 0
+    MeasEpochChannelType1Msg t2_sentinels = type1();
+    MeasEpochChannelType2Msg no_code_offset = type2();
+    no_code_offset.offsets_msb = 4 | (2 << 3);
+    no_code_offset.code_offset_lsb = 0;
+    t2_sentinels.type2.push_back(no_code_offset);
+    MeasEpochChannelType2Msg no_doppler_offset = type2();
+    no_doppler_offset.offsets_msb = 7 | (16 << 3);
+    no_doppler_offset.doppler_offset_lsb = 0;
+    t2_sentinels.type2.push_back(no_doppler_offset);
+    MeasEpochChannelType2Msg no_carrier2 = type2();
+    no_carrier2.carrier_msb = -128;
+    no_carrier2.carrier_lsb = 0;
+    t2_sentinels.type2.push_back(no_carrier2);
+    // Signal without known frequency (23), for the carrier and the Doppler ratio
+    MeasEpochChannelType1Msg unknown = type1();
+    unknown.type = 23;
+    unknown.type2.push_back(type2());
+
+    RawObservablesMsg out = decode(
+        {no_code, no_carrier, no_doppler, no_cn0, t2_sentinels, unknown});
+    ASSERT_EQ(13u, out.pseudorange.size());
+
+    // no_code, type1 and type2: no pseudorange, hence no carrier phase
+    for (std::size_t i : {0, 1})
+    {
+        EXPECT_TRUE(std::isnan(out.pseudorange[i])) << i;
+        EXPECT_TRUE(std::isnan(out.carrier_phase[i])) << i;
+        EXPECT_FALSE(std::isnan(out.doppler[i])) << i;
+        EXPECT_FALSE(std::isnan(out.cn0[i])) << i;
+    }
+    // no_carrier
+    EXPECT_NEAR(18414437.074, out.pseudorange[2], TOLERANCE_M);
+    EXPECT_TRUE(std::isnan(out.carrier_phase[2]));
+    EXPECT_NEAR(-1234.5678, out.doppler[2], TOLERANCE_HZ);
+    // no_doppler, type1 and type2
+    for (std::size_t i : {3, 4})
+    {
+        EXPECT_FALSE(std::isnan(out.pseudorange[i])) << i;
+        EXPECT_FALSE(std::isnan(out.carrier_phase[i])) << i;
+        EXPECT_TRUE(std::isnan(out.doppler[i])) << i;
+    }
+    // no_cn0, type1 and type2
+    EXPECT_TRUE(std::isnan(out.cn0[5]));
+    EXPECT_TRUE(std::isnan(out.cn0[6]));
+    EXPECT_EQ(65535, out.lock_time[5]);
+    EXPECT_EQ(65535, out.lock_time[6]);
+    // t2_sentinels: the type1 and the other type2 fields stay available
+    EXPECT_NEAR(18414437.074, out.pseudorange[7], TOLERANCE_M);
+    EXPECT_TRUE(std::isnan(out.pseudorange[8]));
+    EXPECT_TRUE(std::isnan(out.carrier_phase[8]));
+    EXPECT_NEAR(-948.863683117, out.doppler[8], TOLERANCE_HZ);
+    EXPECT_NEAR(18414376.538, out.pseudorange[9], TOLERANCE_M);
+    EXPECT_TRUE(std::isnan(out.doppler[9]));
+    EXPECT_NEAR(18414376.538, out.pseudorange[10], TOLERANCE_M);
+    EXPECT_TRUE(std::isnan(out.carrier_phase[10]));
+    EXPECT_NEAR(-948.863683117, out.doppler[10], TOLERANCE_HZ);
+    // unknown: no wavelength and no frequency ratio to the type2
+    EXPECT_NEAR(18414437.074, out.pseudorange[11], TOLERANCE_M);
+    EXPECT_TRUE(std::isnan(out.carrier_phase[11]));
+    EXPECT_NEAR(-1234.5678, out.doppler[11], TOLERANCE_HZ);
+    EXPECT_FALSE(std::isnan(out.carrier_phase[12]));
+    EXPECT_TRUE(std::isnan(out.doppler[12]));
+}
+
+TEST(MeasEpochDecoder, ReusesDecoderAcrossEpochs)
+{
+    MeasEpochDecoder decoder;
+    MeasEpochMsg in;
+    MeasEpochChannelType1Msg t1 = type1();
+    t1.type2.push_back(type2());
+    in.type1 = {t1, t1, t1};
+    RawObservablesMsg out;
+    decoder.decode(in, out);
+    EXPECT_EQ(6u, out.pseudorange.size());
+
+    in.type1 = {type1()};
+    decoder.decode(in, out);
+    ASSERT_EQ(1u, out.pseudorange.size());
+    EXPECT_NEAR(18414437.074, out.pseudorange[0], TOLERANCE_M);
+    EXPECT_NEAR(-1234.5678, out.doppler[0], TOLERANCE_HZ);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,121 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROSaic includes
+#include <septentrio_gnss_driver/parsers/nmea_formatter.hpp>
+#include <septentrio_gnss_driver/parsers/string_utilities.h>
+// C++ library includes
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <string>
+
+/**
+ * @file nmea_formatter_benchmark.cpp
+ * @date 16/10/26
+ * @brief Measures the cost per $PSSN,VSM sentence of the NMEA formatter against
+ * the string formatting it replaced
+ */
+
+namespace {
+    //! Number of sentences formatted per run
+    const std::size_t SENTENCES = 1000000;
+
+    //! Formats a VSM sentence with streams as before NmeaFormatter
+    std::string formatStrings(uint64_t stamp, double v_x, double v_y)
+    {
+        time_t epochSeconds = stamp / 1000000000;
+        struct tm* tm_temp = std::gmtime(&epochSeconds);
+        std::stringstream timeUtc;
+        timeUtc << std::setfill('0') << std::setw(2)
+                << std::to_string(tm_temp->tm_hour) << std::setw(2)
+                << std::to_string(tm_temp->tm_min) << std::setw(2)
+                << std::to_string(tm_temp->tm_sec) << "." << std::setw(3)
+                << std::to_string((stamp - (stamp / 1000000000) * 1000000000) /
+                                  1000000);
+        std::string velNmea =
+            "$PSSN,VSM," + timeUtc.str() + "," +
+            string_utilities::trimDecimalPlaces(v_x) + "," +
+            string_utilities::trimDecimalPlaces(v_y) + "," +
+            string_utilities::trimDecimalPlaces(0.1) + "," +
+            string_utilities::trimDecimalPlaces(0.1) + ",," +
+            string_utilities::trimDecimalPlaces(1000000.0);
+        char crc = std::accumulate(velNmea.begin() + 1, velNmea.end(), 0,
+                                   [](char sum, char ch) { return sum ^ ch; });
+        std::stringstream crcss;
+        crcss << std::hex << static_cast<int32_t>(crc);
+        velNmea += "*" + crcss.str() + "\r\n";
+        return velNmea;
+    }
+
+    /**
+     * @brief Times the formatting of a sequence of sentences at 100 Hz
+     * @param[in] name Name printed with the result
+     * @param[in] format Formatting of one sentence, returning its size so that
+     * the call cannot be optimized away
+     */
+    template <typename F>
+    void run(const char* name, F format)
+    {
+        std::size_t sum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < SENTENCES; ++i)
+            sum += format(1700000000000000000ull + 10000000ull * i, 1.0e-4 * i,
+                          -2.0e-5 * i);
+        std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::steady_clock::now() - start;
+        std::printf("%-24s %8.1f ns/sentence (checksum %zu)\n", name,
+                    elapsed.count() / SENTENCES, sum);
+    }
+} // namespace
+
+int main()
+{
+    string_utilities::NmeaFormatter formatter;
+    run("NmeaFormatter", [&formatter](uint64_t stamp, double v_x, double v_y) {
+        formatter.begin("$PSSN,VSM");
+        formatter.appendTime(stamp);
+        formatter.appendFixed3(v_x);
+        formatter.appendFixed3(v_y);
+        formatter.appendFixed3(0.1);
+        formatter.appendFixed3(0.1);
+        formatter.appendEmpty();
+        formatter.appendFixed3(1000000.0);
+        formatter.finish();
+        return formatter.size();
+    });
+    run("stringstream", [](uint64_t stamp, double v_x, double v_y) {
+        return formatStrings(stamp, v_x, v_y).size();
+    });
+    return 0;
+}
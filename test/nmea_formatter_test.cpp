@@ -0,0 +1,212 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROSaic includes
+#include <septentrio_gnss_driver/parsers/nmea_formatter.hpp>
+#include <septentrio_gnss_driver/parsers/string_utilities.h>
+// C++ library includes
+#include <cmath>
+#include <limits>
+#include <string>
+// Google Test includes
+#include <gtest/gtest.h>
+
+/**
+ * @file nmea_formatter_test.cpp
+ * @date 16/10/26
+ * @brief Checks the NMEA formatter against golden sentences and the formatting
+ * it replaced
+ */
+
+using string_utilities::NmeaFormatter;
+
+namespace {
+    //! 2023-11-14 22:13:20.123456789 UTC in nanoseconds since the Unix epoch
+    const uint64_t STAMP = 1700000000123456789ull;
+
+    //! The sentence of the formatter, empty if it could not be finished
+    std::string finish(NmeaFormatter& formatter)
+    {
+        if (!formatter.finish())
+            return "";
+        return std::string(formatter.data(), formatter.size());
+    }
+
+    /**
+     * @brief Formats a $PSSN,VSM sentence as ROSaicNodeBase::processTwist() does
+     * @param[in] stamp Time in nanoseconds since the Unix epoch
+     * @param[in] values v_x, v_y, std_x, std_y, v_z, std_z
+     * @param[in] sign Factor of v_y and v_z, -1 for ROS axis orientation
+     */
+    std::string vsm(uint64_t stamp, const double (&values)[6], double sign = 1.0)
+    {
+        NmeaFormatter formatter;
+        formatter.begin("$PSSN,VSM");
+        formatter.appendTime(stamp);
+        formatter.appendFixed3(values[0]);
+        formatter.appendFixed3(sign * values[1]);
+        formatter.appendFixed3(values[2]);
+        formatter.appendFixed3(values[3]);
+        formatter.appendFixed3(sign * values[4]);
+        formatter.appendFixed3(values[5]);
+        return finish(formatter);
+    }
+} // namespace
+
+// The sentences of the formatting before NmeaFormatter are given as comments
+// where they differ on purpose.
+
+TEST(NmeaFormatter, FormatsVsmSentence)
+{
+    EXPECT_EQ("$PSSN,VSM,221320.123,1.235,-0.500,0.100,0.100,0.000,0.200*67\r\n",
+              vsm(STAMP, {1.2345, -0.5, 0.1, 0.1, 0.0, 0.2}));
+    EXPECT_EQ("$PSSN,VSM,000000.000,0.000,0.000,0.000,0.000,0.000,0.000*48\r\n",
+              vsm(0, {0.0, 0.0, 0.0, 0.0, 0.0, 0.0}));
+}
+
+TEST(NmeaFormatter, FormatsEmptyFields)
+{
+    NmeaFormatter formatter;
+    formatter.begin("$PSSN,VSM");
+    formatter.appendTime(STAMP);
+    formatter.appendEmpty();
+    formatter.appendFixed3(2.0);
+    formatter.appendFixed3(1000000.0);
+    formatter.appendFixed3(0.1);
+    formatter.appendEmpty();
+    formatter.appendFixed3(1000000.0);
+    EXPECT_EQ("$PSSN,VSM,221320.123,,2.000,1000000.000,0.100,,1000000.000*4B\r\n",
+              finish(formatter));
+}
+
+TEST(NmeaFormatter, WritesChecksumAsTwoUpperCaseHexDigits)
+{
+    // Was "*5c"
+    EXPECT_EQ(
+        "$PSSN,VSM,235959.999,10.000,2.000,0.050,0.050,-3.000,1000000.000*5C\r\n",
+        vsm(86399999000000ull, {10.0, 2.0, 0.05, 0.05, -3.0, 1000000.0}));
+
+    // Was "*3"
+    NmeaFormatter formatter;
+    formatter.begin("$IIXD");
+    formatter.appendEmpty();
+    formatter.appendFixed3(10.0);
+    EXPECT_EQ("$IIXD,,10.000*03\r\n", finish(formatter));
+}
+
+TEST(NmeaFormatter, NegatesNegativeValuesForRosAxisOrientation)
+{
+    // Was "--0.500" for v_y
+    EXPECT_EQ("$PSSN,VSM,221320.123,1.235,0.500,0.100,0.100,-0.250,0.200*60\r\n",
+              vsm(STAMP, {1.2345, -0.5, 0.1, 0.1, 0.25, 0.2}, -1.0));
+}
+
+TEST(NmeaFormatter, RoundsSmallNegativeValuesToUnsignedZero)
+{
+    // Was "-0.000"
+    EXPECT_EQ("$PSSN,VSM,221320.000,0.000,0.000,1.000,1.000,0.000,1.000*49\r\n",
+              vsm(1700000000000000000ull, {-0.0004, 0.0, 1.0, 1.0, 0.0, 1.0}));
+}
+
+TEST(NmeaFormatter, RoundsLikeTrimDecimalPlaces)
+{
+    NmeaFormatter formatter;
+    for (double value = -2000.0; value < 2000.0; value += 0.0173)
+    {
+        for (double v : {value, value + 0.0005, 1.0e6 * value})
+        {
+            // Values rounding to zero from below lose their sign on purpose
+            if ((v < 0.0) && (v > -0.0005))
+                continue;
+            formatter.begin("$");
+            formatter.appendFixed3(v);
+            ASSERT_TRUE(formatter.finish());
+            std::string sentence(formatter.data(), formatter.size());
+            EXPECT_EQ("$," + string_utilities::trimDecimalPlaces(v),
+                      sentence.substr(0, sentence.size() - 5))
+                << "value " << v;
+        }
+    }
+}
+
+TEST(NmeaFormatter, WrapsTimeOfDay)
+{
+    NmeaFormatter formatter;
+    formatter.begin("$");
+    // One day and 1 ms minus 1 ns after 01:02:03
+    formatter.appendTime((86400ull + 3723ull) * 1000000000ull + 1999999ull);
+    std::string sentence = finish(formatter);
+    EXPECT_EQ("$,010203.001", sentence.substr(0, sentence.size() - 5));
+}
+
+TEST(NmeaFormatter, RejectsValuesThatCannotBeFormatted)
+{
+    NmeaFormatter formatter;
+    for (double value : {std::numeric_limits<double>::quiet_NaN(),
+                         std::numeric_limits<double>::infinity(),
+                         -std::numeric_limits<double>::infinity(), 1.0e12,
+                         -1.0e12})
+    {
+        formatter.begin("$PSSN,VSM");
+        formatter.appendFixed3(1.0);
+        formatter.appendFixed3(value);
+        formatter.appendFixed3(1.0);
+        EXPECT_FALSE(formatter.finish()) << "value " << value;
+    }
+    // The formatter is usable again after a failure
+    EXPECT_EQ("$PSSN,VSM,221320.123,1.235,-0.500,0.100,0.100,0.000,0.200*67\r\n",
+              vsm(STAMP, {1.2345, -0.5, 0.1, 0.1, 0.0, 0.2}));
+}
+
+TEST(NmeaFormatter, RejectsSentencesBeyondCapacity)
+{
+    NmeaFormatter formatter;
+    formatter.begin("$PSSN,VSM");
+    for (int i = 0; i < 20; ++i)
+        formatter.appendFixed3(-123456.789);
+    EXPECT_FALSE(formatter.finish());
+
+    std::string address(NmeaFormatter::CAPACITY + 1, 'A');
+    address[0] = '$';
+    formatter.begin(address.c_str());
+    EXPECT_FALSE(formatter.finish());
+
+    // Largest sentence that fits, including the checksum and line ending
+    address.resize(NmeaFormatter::CAPACITY - 5);
+    formatter.begin(address.c_str());
+    EXPECT_TRUE(formatter.finish());
+    EXPECT_EQ(address.size() + 5, formatter.size());
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,108 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROSaic includes
+#include "ins_nav_blocks.hpp"
+// C++ library includes
+#include <chrono>
+#include <cstdio>
+
+/**
+ * @file sbf_parser_benchmark.cpp
+ * @date 16/10/26
+ * @brief Measures the cost per block of the INSNavGeod and INSNavCart parsers,
+ * copying the fields against parsing them with Qi
+ */
+
+namespace {
+    //! Number of blocks parsed per run
+    const std::size_t BLOCKS = 2000000;
+    //! Number of distinct blocks cycled through
+    const std::size_t DISTINCT = 1024;
+
+    /**
+     * @brief Times a parser over blocks of one SBList
+     * @param[in] name Name printed with the result
+     * @param[in] blocks The blocks
+     * @param[in] parse Parser of one block, returning a field of the message so
+     * that the call cannot be optimized away
+     */
+    template <typename F>
+    void run(const char* name, const std::vector<std::vector<uint8_t>>& blocks,
+             F parse)
+    {
+        double sum = 0.0;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < BLOCKS; ++i)
+            sum += parse(blocks[i % DISTINCT]);
+        std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::steady_clock::now() - start;
+        std::printf("%-32s %8.1f ns/block (checksum %g)\n", name,
+                    elapsed.count() / BLOCKS, sum);
+    }
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(42);
+    for (uint16_t sb_list : {0x1B, 0xFF})
+    {
+        std::vector<std::vector<uint8_t>> geod;
+        std::vector<std::vector<uint8_t>> cart;
+        for (std::size_t i = 0; i < DISTINCT; ++i)
+        {
+            geod.push_back(ins_nav_blocks::make(4226, sb_list, rng));
+            cart.push_back(ins_nav_blocks::make(4225, sb_list, rng));
+        }
+        std::printf("SBList 0x%02X\n", sb_list);
+
+        INSNavGeodMsg geod_msg;
+        run("INSNavGeod copied", geod, [&geod_msg](const std::vector<uint8_t>& b) {
+            INSNavGeodParser(nullptr, b.data(), b.data() + b.size(), geod_msg,
+                             true);
+            return geod_msg.gnss_age;
+        });
+        run("INSNavGeod Qi", geod, [&geod_msg](const std::vector<uint8_t>& b) {
+            INSNavGeodParser(nullptr, b.cbegin(), b.cend(), geod_msg, true);
+            return geod_msg.gnss_age;
+        });
+        INSNavCartMsg cart_msg;
+        run("INSNavCart copied", cart, [&cart_msg](const std::vector<uint8_t>& b) {
+            INSNavCartParser(nullptr, b.data(), b.data() + b.size(), cart_msg,
+                             true);
+            return cart_msg.gnss_age;
+        });
+        run("INSNavCart Qi", cart, [&cart_msg](const std::vector<uint8_t>& b) {
+            INSNavCartParser(nullptr, b.cbegin(), b.cend(), cart_msg, true);
+            return cart_msg.gnss_age;
+        });
+    }
+    return 0;
+}
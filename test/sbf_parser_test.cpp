@@ -0,0 +1,143 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROSaic includes
+#include "ins_nav_blocks.hpp"
+// C++ library includes
+#include <cstring>
+// ROS includes
+#include <ros/serialization.h>
+// Google Test includes
+#include <gtest/gtest.h>
+
+/**
+ * @file sbf_parser_test.cpp
+ * @date 16/10/26
+ * @brief Checks that copying SBF fields gives the same messages as parsing them
+ * with Qi
+ */
+
+namespace {
+    //! The serialized message, to compare all fields bit by bit
+    template <typename Msg>
+    std::vector<uint8_t> serialize(const Msg& msg)
+    {
+        std::vector<uint8_t> buffer(ros::serialization::serializationLength(msg));
+        ros::serialization::OStream stream(buffer.data(), buffer.size());
+        ros::serialization::serialize(stream, msg);
+        return buffer;
+    }
+
+    /**
+     * @brief Parses random blocks with every SBList by copying and with Qi and
+     * compares the messages
+     * @param[in] id Block number
+     * @param[in] parse Parser of the block, called with either iterator type and
+     * without node, which is only used to log parse errors
+     */
+    template <typename Msg, typename Parse>
+    void expectEqualParsing(uint16_t id, Parse parse)
+    {
+        std::mt19937 rng(id);
+        for (uint16_t sb_list = 0; sb_list < 256; ++sb_list)
+        {
+            for (bool use_ros_axis_orientation : {false, true})
+            {
+                std::vector<uint8_t> block = ins_nav_blocks::make(id, sb_list, rng);
+                Msg copied;
+                ASSERT_TRUE(parse(block.data(), block.data() + block.size(),
+                                  copied, use_ros_axis_orientation));
+                Msg qi_parsed;
+                ASSERT_TRUE(parse(block.cbegin(), block.cend(), qi_parsed,
+                                  use_ros_axis_orientation));
+                EXPECT_EQ(serialize(qi_parsed), serialize(copied))
+                    << "SBList " << sb_list;
+            }
+        }
+    }
+
+    //! Parses a field of type Val at every offset of random bytes both ways
+    template <typename Val>
+    void expectEqualField()
+    {
+        std::mt19937 rng(sizeof(Val));
+        std::vector<uint8_t> bytes(100000 + sizeof(Val));
+        for (auto& byte : bytes)
+            byte = static_cast<uint8_t>(rng());
+        for (std::size_t i = 0; i + sizeof(Val) <= bytes.size(); ++i)
+        {
+            const uint8_t* copy_it = bytes.data() + i;
+            QiIterator qi_it = bytes.cbegin() + i;
+            Val copied, qi_parsed;
+            ASSERT_TRUE(qiLittleEndianParser(copy_it, copied));
+            ASSERT_TRUE(qiLittleEndianParser(qi_it, qi_parsed));
+            ASSERT_EQ(0, std::memcmp(&copied, &qi_parsed, sizeof(Val)))
+                << "offset " << i;
+            ASSERT_EQ(bytes.data() + i + sizeof(Val), copy_it);
+            ASSERT_EQ(bytes.cbegin() + i + sizeof(Val), qi_it);
+        }
+    }
+} // namespace
+
+TEST(SbfParser, CopiesFieldsLikeQi)
+{
+    expectEqualField<int8_t>();
+    expectEqualField<uint8_t>();
+    expectEqualField<int16_t>();
+    expectEqualField<uint16_t>();
+    expectEqualField<int32_t>();
+    expectEqualField<uint32_t>();
+    expectEqualField<int64_t>();
+    expectEqualField<uint64_t>();
+    expectEqualField<float>();
+    expectEqualField<double>();
+}
+
+TEST(SbfParser, CopiesINSNavGeodLikeQi)
+{
+    expectEqualParsing<INSNavGeodMsg>(
+        4226, [](auto it, auto end, INSNavGeodMsg& msg, bool ros_axes) {
+            return INSNavGeodParser(nullptr, it, end, msg, ros_axes);
+        });
+}
+
+TEST(SbfParser, CopiesINSNavCartLikeQi)
+{
+    expectEqualParsing<INSNavCartMsg>(
+        4225, [](auto it, auto end, INSNavCartMsg& msg, bool ros_axes) {
+            return INSNavCartParser(nullptr, it, end, msg, ros_axes);
+        });
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
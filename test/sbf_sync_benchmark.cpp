@@ -0,0 +1,225 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROSaic includes
+#include <septentrio_gnss_driver/crc/crc.h>
+#include <septentrio_gnss_driver/parsers/parsing_utilities.hpp>
+// C++ library includes
+#include <bitset>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+/**
+ * @file sbf_sync_benchmark.cpp
+ * @date 16/10/26
+ * @brief Measures how the SBF resynchronization of RxMessage::search() copes with
+ * bit errors, on a synthetic stream fed in reads of 4 KiB
+ */
+
+namespace {
+    //! Size of the synthetic stream [bytes]
+    const std::size_t STREAM_SIZE = 64 << 20;
+    //! Bytes handed over per read, as by async_read_some
+    const std::size_t READ_SIZE = 4096;
+
+    //! Block numbers and lengths of the stream, the last two not decoded
+    const uint16_t BLOCKS[][2] = {
+        {4226, 96}, {4050, 64}, {4007, 96}, {4027, 1088}, {4000, 160}, {5891, 140}};
+    //! Number of the BLOCKS the driver decodes
+    const std::size_t DECODED = 4;
+
+    //! Counts of a run, mirroring /streamstatus
+    struct Result
+    {
+        uint64_t blocks = 0;
+        uint64_t skipped = 0;
+        uint64_t crc_errors = 0;
+        uint64_t false_syncs = 0;
+        uint64_t discarded_bytes = 0;
+        uint64_t waited_bytes = 0;
+    };
+
+    //! Writes an SBF block with valid CRC and a TOW as payload
+    void appendBlock(std::vector<uint8_t>& stream, uint16_t id, uint16_t length,
+                     uint32_t tow)
+    {
+        std::size_t pos = stream.size();
+        stream.resize(pos + length, 0);
+        uint8_t* block = stream.data() + pos;
+        block[0] = '$';
+        block[1] = '@';
+        block[4] = id & 0xFF;
+        block[5] = id >> 8;
+        block[6] = length & 0xFF;
+        block[7] = length >> 8;
+        std::memcpy(block + 8, &tow, sizeof(tow));
+        for (std::size_t i = 14; i < length; ++i)
+            block[i] = static_cast<uint8_t>(i * 31 + tow);
+        uint16_t crc = compute16CCITT(block + 4, length - 4);
+        block[2] = crc & 0xFF;
+        block[3] = crc >> 8;
+    }
+
+    /**
+     * @brief Mirrors RxMessage::search() and plausibleSBF() on one read, handing
+     * back the position the next read continues from
+     * @param[in] decoded Block numbers the driver decodes
+     * @param[in] catalogue Whether blocks the driver does not decode are judged by
+     * the SBF catalogue and their CRC, as now, or rejected as false syncs, as
+     * before
+     */
+    std::size_t parse(const uint8_t* data, std::size_t count,
+                      const std::bitset<8192>& decoded, bool catalogue,
+                      Result& result)
+    {
+        std::size_t pos = 0;
+        while (pos < count)
+        {
+            auto sync = static_cast<const uint8_t*>(
+                std::memchr(data + pos, '$', count - pos));
+            std::size_t next = sync ? sync - data : count;
+            result.discarded_bytes += next - pos;
+            pos = next;
+            if ((pos == count) || (count - pos < 8))
+                return pos;
+            const uint8_t* block = data + pos;
+            if (block[1] != '@')
+            {
+                ++pos;
+                ++result.discarded_bytes;
+                continue;
+            }
+            uint16_t length = parsing_utilities::getLength(block);
+            uint16_t id = parsing_utilities::getId(block);
+            bool known = decoded.test(id);
+            bool plausible =
+                (length % 4 == 0) && (length >= 16) && (length <= 16384) &&
+                (parsing_utilities::parseUInt16(block + 4) >> 13 <= 5) &&
+                (known || (catalogue && parsing_utilities::isSbfBlockNumber(id)));
+            if (!plausible)
+            {
+                ++result.false_syncs;
+                ++pos;
+                ++result.discarded_bytes;
+                continue;
+            }
+            if (count - pos < length)
+            {
+                // Waits for the rest of the block
+                result.waited_bytes += length - (count - pos);
+                return pos;
+            }
+            bool valid = isValid(block);
+            if (valid && known)
+            {
+                ++result.blocks;
+                pos += length;
+            } else if (valid)
+            {
+                ++result.skipped;
+                pos += length;
+            } else
+            {
+                if (known)
+                    ++result.crc_errors;
+                else
+                    ++result.false_syncs;
+                ++pos;
+                ++result.discarded_bytes;
+            }
+        }
+        return pos;
+    }
+
+    //! Feeds the stream in reads, carrying over what a read left unparsed
+    void run(const std::vector<uint8_t>& stream, double ber, bool catalogue,
+             const std::bitset<8192>& decoded)
+    {
+        Result result;
+        std::vector<uint8_t> buffer;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t offset = 0; offset < stream.size(); offset += READ_SIZE)
+        {
+            std::size_t size = std::min(READ_SIZE, stream.size() - offset);
+            buffer.insert(buffer.end(), stream.begin() + offset,
+                          stream.begin() + offset + size);
+            std::size_t used =
+                parse(buffer.data(), buffer.size(), decoded, catalogue, result);
+            buffer.erase(buffer.begin(), buffer.begin() + used);
+        }
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        std::printf("BER %-6g %-9s %7.1f MB/s %8llu blocks %6llu skipped "
+                    "%6llu CRC errors %8llu false syncs %10llu discarded "
+                    "%10llu waited on\n",
+                    ber, catalogue ? "catalogue" : "decoded",
+                    stream.size() / elapsed.count() / 1.0e6,
+                    static_cast<unsigned long long>(result.blocks),
+                    static_cast<unsigned long long>(result.skipped),
+                    static_cast<unsigned long long>(result.crc_errors),
+                    static_cast<unsigned long long>(result.false_syncs),
+                    static_cast<unsigned long long>(result.discarded_bytes),
+                    static_cast<unsigned long long>(result.waited_bytes));
+    }
+} // namespace
+
+int main()
+{
+    std::bitset<8192> decoded;
+    for (std::size_t i = 0; i < DECODED; ++i)
+        decoded.set(BLOCKS[i][0]);
+
+    std::vector<uint8_t> clean;
+    clean.reserve(STREAM_SIZE + 16384);
+    std::mt19937 rng(42);
+    for (uint32_t tow = 0; clean.size() < STREAM_SIZE; ++tow)
+    {
+        const uint16_t* block = BLOCKS[rng() % (sizeof(BLOCKS) / sizeof(BLOCKS[0]))];
+        appendBlock(clean, block[0], block[1], tow);
+    }
+
+    for (double ber : {0.0, 1.0e-5, 1.0e-4, 1.0e-3})
+    {
+        std::vector<uint8_t> stream = clean;
+        if (ber > 0.0)
+        {
+            std::geometric_distribution<std::size_t> gap(ber);
+            for (std::size_t bit = gap(rng); bit < 8 * stream.size();
+                 bit += 1 + gap(rng))
+                stream[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+        }
+        run(stream, ber, false, decoded);
+        run(stream, ber, true, decoded);
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROSaic includes
+#include <septentrio_gnss_driver/communication/thread_config.hpp>
+// C++ library includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file thread_jitter_benchmark.cpp
+ * @date 16/10/26
+ * @brief Measures how late a 500 us sleep loop wakes up under CPU load, with the
+ * default scheduling and with the real-time policy configureThread() applies
+ */
+
+namespace {
+    //! Period of the sleep loop
+    const std::chrono::microseconds PERIOD(500);
+    //! Number of periods per run, i.e. 10 s
+    const int PERIODS = 20000;
+
+    //! Sleeps PERIODS times until the next period and prints how late it woke up
+    void run(const char* label, const ThreadSettings& settings)
+    {
+        std::string errors = io_comm_rx::configureThread("rx_io", settings);
+        if (!errors.empty())
+        {
+            std::printf("%-10s not applied (%s)\n", label, errors.c_str());
+            return;
+        }
+        std::vector<double> late;
+        late.reserve(PERIODS);
+        auto next = std::chrono::steady_clock::now();
+        for (int i = 0; i < PERIODS; ++i)
+        {
+            next += PERIOD;
+            std::this_thread::sleep_until(next);
+            std::chrono::duration<double, std::micro> delay =
+                std::chrono::steady_clock::now() - next;
+            late.push_back(delay.count());
+            // Catches up after an overrun instead of sleeping for missed periods
+            next = std::max(next, std::chrono::steady_clock::now() - PERIOD);
+        }
+        std::sort(late.begin(), late.end());
+        std::printf("%-10s wake-up delay p50 %8.1f us, p99 %8.1f us, "
+                    "max %8.1f us\n",
+                    label, late[late.size() / 2], late[late.size() * 99 / 100],
+                    late.back());
+    }
+} // namespace
+
+/**
+ * Usage: thread_jitter_benchmark [load_threads] [priority]
+ *
+ * load_threads defaults to twice the number of CPUs, priority of the real-time run
+ * to 50. The real-time run needs CAP_SYS_NICE or a suitable rtprio limit.
+ */
+int main(int argc, char** argv)
+{
+    unsigned int cpus = std::max(1u, std::thread::hardware_concurrency());
+    unsigned int load = (argc > 1) ? std::stoul(argv[1]) : 2 * cpus;
+    int priority = (argc > 2) ? std::stoi(argv[2]) : 50;
+
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> busy;
+    for (unsigned int i = 0; i < load; ++i)
+    {
+        busy.emplace_back([&stop] {
+            volatile uint64_t spin = 0;
+            while (!stop.load(std::memory_order_relaxed))
+                ++spin;
+        });
+    }
+    std::printf("%u CPUs, %u busy threads\n", cpus, load);
+
+    ThreadSettings other;
+    run("other", other);
+    ThreadSettings fifo;
+    fifo.policy = "fifo";
+    fifo.priority = priority;
+    run("fifo", fifo);
+
+    stop = true;
+    for (auto& thread : busy)
+        thread.join();
+    return 0;
+}
@@ -0,0 +1,99 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROSaic includes
+#include <septentrio_gnss_driver/parsers/utm_projection.hpp>
+// C++ library includes
+#include <chrono>
+#include <cstdio>
+#include <vector>
+// GeographicLib includes
+#include <GeographicLib/UTMUPS.hpp>
+
+/**
+ * @file utm_projection_benchmark.cpp
+ * @date 16/10/26
+ * @brief Measures the cost per call of the UTM projection against GeographicLib
+ */
+
+namespace {
+    //! Number of positions projected per run
+    const std::size_t POSITIONS = 1000000;
+
+    /**
+     * @brief Times a projection over a track of positions
+     * @param[in] name Name printed with the result
+     * @param[in] lat Latitudes of the track in degrees
+     * @param[in] lon Longitudes of the track in degrees
+     * @param[in] project Projection of one position, returning easting plus
+     * northing so that the call cannot be optimized away
+     */
+    template <typename F>
+    void run(const char* name, const std::vector<double>& lat,
+             const std::vector<double>& lon, F project)
+    {
+        double sum = 0.0;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < lat.size(); ++i)
+            sum += project(lat[i], lon[i]);
+        std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::steady_clock::now() - start;
+        std::printf("%-24s %8.1f ns/call (checksum %.0f)\n", name,
+                    elapsed.count() / lat.size(), sum);
+    }
+} // namespace
+
+int main()
+{
+    // A vehicle track at 100 Hz, within one zone as on the INS hot path
+    std::vector<double> lat(POSITIONS);
+    std::vector<double> lon(POSITIONS);
+    for (std::size_t i = 0; i < POSITIONS; ++i)
+    {
+        lat[i] = 48.1 + 1.0e-7 * i;
+        lon[i] = 11.5 + 1.5e-7 * i;
+    }
+
+    parsing_utilities::UtmProjection projection;
+    run("UtmProjection::forward", lat, lon, [&projection](double la, double lo) {
+        double easting, northing, gamma;
+        projection.forward(la, lo, easting, northing, gamma);
+        return easting + northing;
+    });
+    run("UTMUPS::Forward", lat, lon, [](double la, double lo) {
+        int zone;
+        bool northp;
+        double easting, northing, gamma, k;
+        GeographicLib::UTMUPS::Forward(la, lo, zone, northp, easting, northing,
+                                       gamma, k);
+        return easting + northing;
+    });
+    return 0;
+}
@@ -0,0 +1,160 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROSaic includes
+#include <septentrio_gnss_driver/parsers/utm_projection.hpp>
+// C++ library includes
+#include <cmath>
+// GeographicLib includes
+#include <GeographicLib/UTMUPS.hpp>
+// Google Test includes
+#include <gtest/gtest.h>
+
+/**
+ * @file utm_projection_test.cpp
+ * @date 16/10/26
+ * @brief Compares the UTM projection with GeographicLib
+ */
+
+using parsing_utilities::UtmProjection;
+
+namespace {
+    //! Tolerance of easting and northing [m]
+    const double TOLERANCE_M = 1.0e-4;
+    //! Tolerance of the meridian convergence [deg]
+    const double TOLERANCE_DEG = 1.0e-9;
+
+    /**
+     * @brief Projects a position and compares the result and the zone with
+     * GeographicLib
+     * @param[in,out] projection The projection under test
+     * @param[in] lat Latitude in degrees
+     * @param[in] lon Longitude in degrees
+     * @param[in] setzone Zone GeographicLib projects to, the standard zone by
+     * default
+     */
+    void expectMatch(UtmProjection& projection, double lat, double lon,
+                     int setzone = GeographicLib::UTMUPS::STANDARD)
+    {
+        double easting, northing, gamma;
+        projection.forward(lat, lon, easting, northing, gamma);
+
+        int zone;
+        bool northp;
+        double x, y, gamma_ref, k;
+        GeographicLib::UTMUPS::Forward(lat, lon, zone, northp, x, y, gamma_ref, k,
+                                       setzone);
+        SCOPED_TRACE("lat " + std::to_string(lat) + ", lon " + std::to_string(lon));
+        EXPECT_EQ(GeographicLib::UTMUPS::EncodeZone(zone, northp),
+                  projection.zone());
+        EXPECT_NEAR(x, easting, TOLERANCE_M);
+        EXPECT_NEAR(y, northing, TOLERANCE_M);
+        EXPECT_NEAR(gamma_ref, gamma, TOLERANCE_DEG);
+    }
+} // namespace
+
+TEST(UtmProjection, MatchesGeographicLibAcrossZones)
+{
+    // A single projection following the position from zone to zone, as on a
+    // vehicle
+    UtmProjection projection;
+    for (double lat = -79.75; lat < 84.0; lat += 1.7)
+    {
+        for (double lon = -179.9; lon < 180.0; lon += 0.73)
+            expectMatch(projection, lat, lon);
+    }
+}
+
+TEST(UtmProjection, MatchesGeographicLibAtZoneEdges)
+{
+    const double offsets[] = {-1.0e-9, 0.0, 1.0e-9};
+    for (double lat : {-79.9, -45.0, -1.0e-9, 0.0, 33.3, 55.9, 64.0, 71.9, 83.9})
+    {
+        for (int zone = 1; zone <= 60; ++zone)
+        {
+            for (double offset : offsets)
+            {
+                // Entering the edge from both neighbouring zones
+                UtmProjection from_west;
+                expectMatch(from_west, lat, 6.0 * zone - 184.0);
+                expectMatch(from_west, lat, 6.0 * zone - 180.0 + offset);
+                UtmProjection from_east;
+                expectMatch(from_east, lat, 6.0 * zone - 176.0);
+                expectMatch(from_east, lat, 6.0 * zone - 180.0 + offset);
+            }
+        }
+    }
+}
+
+TEST(UtmProjection, MatchesGeographicLibInLockedZoneBeyondEdges)
+{
+    for (double lat : {-79.0, -30.0, 0.0, 30.0, 50.0, 83.0})
+    {
+        for (int zone = 1; zone <= 60; zone += 7)
+        {
+            // The zone may differ from the one of the central meridian in the
+            // Svalbard band
+            double lon0 = 6.0 * zone - 183.0;
+            UtmProjection projection;
+            expectMatch(projection, lat, lon0);
+            projection.lockZone();
+            int locked = GeographicLib::UTMUPS::StandardZone(lat, lon0);
+            for (double dlon = -4.0; dlon <= 4.0; dlon += 0.5)
+                expectMatch(projection, lat, lon0 + dlon, locked);
+        }
+    }
+}
+
+TEST(UtmProjection, MatchesGeographicLibAtHighLatitudes)
+{
+    UtmProjection projection;
+    for (double lat : {-90.0, -89.99, -85.0, -80.0001, -80.0, -79.9999, 79.9, 83.9999,
+                       84.0, 84.0001, 88.0, 90.0})
+    {
+        for (double lon = -180.0; lon < 180.0; lon += 11.3)
+            expectMatch(projection, lat, lon);
+    }
+}
+
+TEST(UtmProjection, MatchesGeographicLibInNorwayAndSvalbard)
+{
+    UtmProjection projection;
+    for (double lat = 55.5; lat < 84.0; lat += 0.5)
+    {
+        for (double lon = 0.0; lon < 42.0; lon += 0.25)
+            expectMatch(projection, lat, lon);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}